@@ -141,3 +141,8 @@
  * SAMD21J18
  */
 #define BOARD_MINITRONICS_V2  2706    // Minitronics v2.0
+
+/**
+ * Linux host process (HAL_LINUX)
+ */
+#define BOARD_LINUX_RAMPS     9999    // RAMPS 1.4 pinout simulated as a Linux process
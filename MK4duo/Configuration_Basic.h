@@ -85,6 +85,8 @@
  * THE BLOCK BUFFER SIZE NEEDS TO BE A POWER OF 2 (i.g. 8, 16, 32) because shifts
  * and ors are used to do the ring-buffering.
  * For Arduino DUE setting to 32.
+ * Mixer colors and laser raster lines are kept out of the blocks (see
+ * MIXING_COLOR_SLOTS and LASER_RASTER_LINES), so they don't limit this size.
  */
 #define BLOCK_BUFFER_SIZE 16
 
@@ -160,6 +162,14 @@
 // Uncomment to include more info in ok command
 //#define ADVANCED_OK
 
+/**
+ * Binary G-code protocol
+ * Hosts can stream G0-G3 moves as compact frames with fixed-point axis words,
+ * a sequence number and a CRC, mixed with ordinary ASCII lines on the same port.
+ * Reported in M115 as Cap:BINARY_GCODE, see commands.h for the frame layout.
+ */
+//#define BINARY_GCODE_PROTOCOL
+
 /**
  * Enable an emergency-command parser to intercept certain commands as they
  * enter the serial receive buffer, so they cannot be blocked.
@@ -172,6 +182,13 @@
  */
 //#define FASTER_GCODE_PARSER
 
+/**
+ * Spend 108 more bytes of SRAM to convert the parameter values once,
+ * when the line is parsed, instead of on every value_float() call.
+ * Values have a fixed decimal format, no exponent. Requires FASTER_GCODE_PARSER.
+ */
+//#define FASTER_GCODE_VALUES
+
 /**
  * Spend more bytes of SRAM to optimize the GCode execute
  */
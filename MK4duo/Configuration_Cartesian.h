@@ -457,6 +457,9 @@
 
 // When the nozzle is off the mesh, this value is used as the Z-Height correction value.
 //#define UBL_Z_RAISE_WHEN_OFF_MESH 2.5
+
+// Mesh segments planned together while the planner buffer is at least half full
+#define UBL_SEGMENT_BATCH 4
 /** END UNIFIED BED LEVELING **/
 
 /** START MESH BED LEVELING or AUTO BED LEVELING LINEAR or AUTO BED LEVELING BILINEAR or UNIFIED BED LEVELING **/
@@ -483,6 +486,16 @@
 //#define ABL_BILINEAR_SUBDIVISION
 // Number of subdivisions between probe points
 #define BILINEAR_SUBDIVISIONS 3
+
+// Store the bilinear grid as 16 bit offsets from the plane of the bed,
+// in steps of ABL_MESH_UNIT mm. Uses less RAM so GRID_MAX_POINTS can be raised.
+//#define ABL_COMPACT_MESH
+#define ABL_MESH_UNIT 0.001
+// After the grid, probe the center of up to ABL_REFINE_POINTS cells where
+// the grid is curved enough to be off by more than ABL_REFINE_THRESHOLD mm
+// in the middle of the cell (0 to disable)
+#define ABL_REFINE_POINTS 8
+#define ABL_REFINE_THRESHOLD 0.02
 /** END AUTO_BED_LEVELING_LINEAR or AUTO_BED_LEVELING_BILINEAR **/
 
 /** START AUTO_BED_LEVELING_3POINT or UNIFIED BED LEVELING **/
@@ -80,6 +80,13 @@
 // Subsegment per line 10 - xxx
 #define DELTA_SEGMENTS_PER_LINE 20
 
+// Tower heights of the lines are computed exactly only at the start, middle and
+// end of each batch of DELTA_SEGMENT_BATCH lines and interpolated in between.
+// A batch whose interpolation error exceeds DELTA_SEGMENT_TOLERANCE (mm) is
+// computed exactly line by line. Set DELTA_SEGMENT_BATCH to 0 to disable.
+#define DELTA_SEGMENT_BATCH 8
+#define DELTA_SEGMENT_TOLERANCE 0.01
+
 // NOTE: All following values for DELTA_* MUST be floating point,
 // so always have a decimal point in them.
 //
@@ -445,6 +452,9 @@
 
 // When the nozzle is off the mesh, this value is used as the Z-Height correction value.
 //#define UBL_Z_RAISE_WHEN_OFF_MESH 2.5
+
+// Mesh segments planned together while the planner buffer is at least half full
+#define UBL_SEGMENT_BATCH 4
 /** END Unified Bed Leveling */
 
 // Set the number of grid points per dimension
@@ -461,6 +471,16 @@
 // Number of subdivisions between probe points
 #define BILINEAR_SUBDIVISIONS 3
 
+// Store the bilinear grid as 16 bit offsets from the plane of the bed,
+// in steps of ABL_MESH_UNIT mm. Uses less RAM so GRID_MAX_POINTS can be raised.
+//#define ABL_COMPACT_MESH
+#define ABL_MESH_UNIT 0.001
+// After the grid, probe the center of up to ABL_REFINE_POINTS cells where
+// the grid is curved enough to be off by more than ABL_REFINE_THRESHOLD mm
+// in the middle of the cell (0 to disable)
+#define ABL_REFINE_POINTS 8
+#define ABL_REFINE_THRESHOLD 0.02
+
 // Commands to execute at the end of G29 probing.
 // Useful to retract or move the Z probe out of the way.
 //#define Z_PROBE_END_SCRIPT "G1 Z10 F8000\nG1 X10 Y10\nG1 Z0.5"
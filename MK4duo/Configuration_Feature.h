@@ -356,6 +356,8 @@
 #define MIXING_STEPPERS 2
 // Use the Virtual Tool method with M163 and M164
 #define MIXING_VIRTUAL_TOOLS 16
+// Different colors the queued moves can use, moves of the same color share one
+#define MIXING_COLOR_SLOTS 4
 /***********************************************************************/
 
 
@@ -1419,11 +1421,37 @@
 #define SDSORT_CACHE_VFATS 2      // Maximum number of 13-byte VFAT entries to use for sorting.
                                   // Note: Only affects SCROLL_LONG_FILENAMES with SDSORT_CACHE_NAMES but not SDSORT_DYNAMIC_RAM.
 
+/**
+ * Index the entries of the current folder when it is entered.
+ * The SD menu and the sort then open the n-th file directly from
+ * its directory entry instead of rescanning the folder every time.
+ * Costs 2 bytes of SRAM per item, items after the limit are scanned.
+ */
+//#define SD_DIR_INDEX
+#define SD_DIR_INDEX_LIMIT 128    // Maximum number of indexed items
+
 // This function enable the firmware write restart file for restart print when power loss
 //#define SD_RESTART_FILE               // Uncomment to enable
 #define SD_RESTART_FILE_SAVE_TIME    1  // Seconds between update
 #define SD_RESTART_FILE_PURGE_LEN   20  // Purge when restart
 #define SD_RESTART_FILE_RETRACT_LEN  1  // Retract when restart
+#define SD_RESTART_FILE_JOURNAL     32  // Blocks of 512 bytes of the restart journal
+
+// Index the G-code files in the background, in a hidden file name.gcode.idx,
+// when they are uploaded or selected the first time. The index has the slicer
+// data and the position, Z and estimated time of every layer: the file info
+// is read at once, the progress follows the estimated time and M26 L<layer>
+// moves the SD print to the start of a layer.
+//#define SD_PRINT_INDEX
+
+// Collect the lines uploaded with M28 in a RAM buffer and write them to the SD
+// in whole blocks, multi-block when the buffer has more blocks. A new file is
+// allocated contiguous in a hidden file, M29 releases the unused space and
+// renames it, so a power loss never leaves a stale tail in the file.
+// Costs SD_FAST_UPLOAD_BLOCKS * 512 bytes of SRAM.
+//#define SD_FAST_UPLOAD
+#define SD_FAST_UPLOAD_BLOCKS       2   // Blocks of 512 bytes of the write buffer (1-16)
+#define SD_FAST_UPLOAD_PREALLOCATE  8   // MB allocated contiguous for a new file, 0 to disable
 /*****************************************************************************************/
 
 
@@ -1682,6 +1710,20 @@
 /****************************************************************************/
 
 
+/****************************************************************************
+ ************************ Fixed point planner math **************************
+ ****************************************************************************
+ *                                                                          *
+ * Compute the acceleration and deceleration steps of every trapezoid with  *
+ * 32 bit integer math instead of float divisions.                          *
+ * Recommended for 8 bit boards (Mega2560) without a floating point unit.   *
+ * Results match the float math within one step.                            *
+ *                                                                          *
+ ****************************************************************************/
+//#define PLANNER_FIXED_POINT
+/****************************************************************************/
+
+
 /***************************************************************************************
  ******************************** Minimum stepper pulse ********************************
  ***************************************************************************************
@@ -1751,6 +1793,29 @@
 /***********************************************************************/
 
 
+/***********************************************************************
+ ************************* Step event timeline *************************
+ ***********************************************************************
+ *                                                                     *
+ * The main loop converts the planner blocks into step events ahead of *
+ * time: the interval, the axes to step and the directions of each     *
+ * step. The Stepper ISR then just outputs them, so it takes only a    *
+ * small fraction of the usual time. A block too fast for the step     *
+ * events is stepped by the ISR as usual, with multistepping.          *
+ * If the main loop falls behind, the ISR converts a few step events   *
+ * itself and "Step timeline underruns: n" is reported once a second.  *
+ * Not compatible with LIN_ADVANCE, COLOR_MIXING_EXTRUDER, LASER and   *
+ * Z_LATE_ENABLE.                                                      *
+ *                                                                     *
+ * STEP_TIMELINE_SIZE is the number of step events made ahead, a power *
+ * of 2 from 16 to 256. Each one takes 8 bytes of RAM.                 *
+ *                                                                     *
+ ***********************************************************************/
+//#define STEP_TIMELINE
+#define STEP_TIMELINE_SIZE 128
+/***********************************************************************/
+
+
 /***********************************************************************
  *************************** Microstepping *****************************
  ***********************************************************************
@@ -1862,9 +1927,12 @@
 //
 // Disable this feature to save ~3226 bytes
 //#define ARC_SUPPORT
-#define MM_PER_ARC_SEGMENT  1   // Length of each arc segment
-#define MIN_ARC_SEGMENTS   24   // Minimum number of segments in a complete circle
-#define N_ARC_CORRECTION   25   // Number of intertpolated segments between corrections
+#define MM_PER_ARC_SEGMENT    1     // Maximum length of each arc segment
+#define MIN_ARC_SEGMENT_MM    0.1   // Minimum length of each arc segment
+#define ARC_CHORD_TOLERANCE   0.005 // (mm) Maximum distance of the segments from the arc
+#define ARC_SEGMENT_BATCH     4     // Segments planned together while the planner buffer is half full
+#define MIN_ARC_SEGMENTS     24     // Minimum number of segments in a complete circle
+#define N_ARC_CORRECTION     25     // Number of segments between radius corrections
 //#define ARC_P_CIRCLES         // Enable the 'P' parameter to specify complete circles
 //#define CNC_WORKSPACE_PLANES  // Allow G2/G3 to operate in XY, ZX, or YZ planes
 
@@ -163,6 +163,16 @@
 //#define REPORT_CURRENT_CHANGE
 //#define STOP_ON_ERROR
 
+// Sample the StallGuard load of the X, Y and Z drivers while moving (Requires MONITOR_DRIVER_STATUS)
+// When the load comes near to a stall the current is raised, then the feedrate is reduced.
+// M923 - Report or stream the lowest load of every driver and the speed of its block.
+//#define STALLGUARD_TELEMETRY
+#define STALLGUARD_SAMPLE_MS      10  // [ms] A driver is sampled in every period
+#define STALLGUARD_LOAD_THRS      50  // Load value (SG_RESULT) under this is near to a stall
+#define STALLGUARD_CURRENT_STEP   50  // [mA] Current raised at every sample near to a stall, 0 to disable
+#define STALLGUARD_CURRENT_MAX   130  // [%] Maximum raised current, percent of the set current
+#define STALLGUARD_SLOWDOWN       10  // [%] Feedrate reduced at every sample near to a stall at max current, 0 to disable
+
 // The driver will switch to spreadCycle when stepper speed is over HYBRID_THRESHOLD.
 // This mode allows for faster movements at the expense of higher noise levels.
 // STEALTHCHOP for axis needs to be enabled.
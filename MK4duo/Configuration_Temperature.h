@@ -116,6 +116,12 @@
 #define TEMP_SENSOR_AD595_OFFSET 0.0
 #define TEMP_SENSOR_AD595_GAIN   1.0
 
+// Convert the thermistor (1-9) and amplifier (20) readings with a table calculated
+// at start and by M305, instead of the Steinhart-Hart equation at every reading.
+// It takes about 230 bytes of RAM on AVR and 360 bytes on 32 bit for every heater.
+// The Linux host build reports the worst table error on exit.
+//#define SENSOR_LOOKUP_TABLE
+
 // Use it for Testing or Development purposes. NEVER for production machine.
 #define DUMMY_THERMISTOR_998_VALUE  25
 #define DUMMY_THERMISTOR_999_VALUE 100
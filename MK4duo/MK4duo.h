@@ -34,8 +34,12 @@
 
 #define __MK4DUO_FIRMWARE__
 
-#include "Arduino.h"
-#include "pins_arduino.h"
+#ifdef __PLAT_LINUX__
+  #include "src/platform/HAL_LINUX/arduino.h"
+#else
+  #include "Arduino.h"
+  #include "pins_arduino.h"
+#endif
 
 #include <math.h>
 #include <stdio.h>
@@ -51,7 +55,9 @@
   #include <avr/interrupt.h>
 #endif
 
-#include <SPI.h>
+#ifndef __PLAT_LINUX__
+  #include <SPI.h>
+#endif
 
 /**
  * Include file
@@ -182,3 +188,4 @@
 #include "src/feature/rgbled/led_events.h"
 #include "src/feature/caselight/caselight.h"
 #include "src/feature/restart/restart.h"
+#include "src/feature/printindex/printindex.h"
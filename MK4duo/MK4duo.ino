@@ -312,6 +312,7 @@
  * M914 - Set StallGuard sensitivity. (Requires SENSORLESS_HOMING)
  * M915 - TMC Z axis calibration routine. (Requires TMC)
  * M922 - Enable/disable TMC debug. (Requires TMC_DEBUG)
+ * M923 - Report or stream the StallGuard load telemetry. (Requires STALLGUARD_TELEMETRY)
  * M930 - TMC set blank_time.
  * M931 - TMC set off_time.
  * M932 - TMC set hysteresis_start.
@@ -41,6 +41,13 @@ long Commands::gcode_N = 0;
 
 int Commands::serial_count[NUM_SERIAL] = { 0 };
 
+#if ENABLED(BINARY_GCODE_PROTOCOL)
+  uint8_t Commands::binary_frame[NUM_SERIAL][BINARY_FRAME_MAX_SIZE],
+          Commands::binary_count[NUM_SERIAL]    = { 0 },
+          Commands::binary_last_seq[NUM_SERIAL] = { 0 };
+  millis_s Commands::binary_ms[NUM_SERIAL]      = { 0 };
+#endif
+
 PGM_P Commands::injected_commands_P = nullptr;
 
 millis_s Commands::last_command_ms = 0;
@@ -71,7 +78,17 @@ void Commands::advance_queue() {
   #if HAS_SD_SUPPORT
 
     if (card.isSaving()) {
-      gcode_t command = buffer_ring.peek();
+
+      #if ENABLED(SD_FAST_UPLOAD)
+        // Write all the received lines in one pass, the last one is handled below
+        while (buffer_ring.count() > 1 && !is_M29(buffer_ring.front().gcode)) {
+          card.write_command(buffer_ring.front().gcode);
+          ok_to_send();
+          buffer_ring.pop();
+        }
+      #endif
+
+      gcode_t &command = buffer_ring.front();
       if (is_M29(command.gcode)) {
         // M29 closes the file
         card.finishWrite();
@@ -102,7 +119,7 @@ void Commands::advance_queue() {
   #endif // !HAS_SD_SUPPORT
 
   // The buffer_ring may be reset by a command handler or by code invoked by idle() within a handler
-  buffer_ring.dequeue();
+  buffer_ring.pop();
 
 }
 
@@ -292,7 +309,7 @@ Heater* Commands::get_target_heater() {
 /** Private Function */
 void Commands::ok_to_send() {
 
-  gcode_t tmp = buffer_ring.peek();
+  const gcode_t &tmp = buffer_ring.front();
 
   if (tmp.s_port < 0 || !tmp.send_ok) return;
 
@@ -300,7 +317,7 @@ void Commands::ok_to_send() {
   SERIAL_STR(OK);
 
   #if ENABLED(ADVANCED_OK)
-    char* p = tmp.gcode;
+    const char* p = tmp.gcode;
     if (*p == 'N') {
       SERIAL_CHR(' ');
       SERIAL_CHR(*p++);
@@ -336,6 +353,18 @@ void Commands::get_serial() {
     }
   #endif
 
+  #if ENABLED(BINARY_GCODE_PROTOCOL)
+    for (uint8_t i = 0; i < NUM_SERIAL; ++i) {
+      if (!binary_count[i]) continue;
+      // A complete frame held back by a full ring is queued first
+      if (binary_frame_complete(i))
+        queue_binary(i);
+      // A frame cut short is dropped once its port stays silent, and the host is asked to resend it
+      else if (!Com::serialDataAvailable(i) && expired(&binary_ms[i], millis_s(BINARY_FRAME_TIMEOUT)))
+        binary_frame_error(PSTR(MSG_ERR_BINARY_TIMEOUT), i);
+    }
+  #endif
+
   /**
    * Loop while serial characters are incoming and the buffer_ring is not full
    */
@@ -348,8 +377,22 @@ void Commands::get_serial() {
       last_command_ms = millis();
       printer.max_inactivity_ms = millis();
 
+      #if ENABLED(BINARY_GCODE_PROTOCOL)
+        // The port waits until its held back frame is queued, the ok is deferred with it
+        if (binary_frame_complete(i)) continue;
+      #endif
+
       if ((c = Com::serialRead(i)) < 0) continue;
 
+      #if ENABLED(BINARY_GCODE_PROTOCOL)
+        // A frame starts only where a new line would start
+        if (binary_count[i] || (c == BINARY_FRAME_SYNC && !serial_count[i] && !serial_comment_mode[i])) {
+          binary_ms[i] = millis();
+          get_binary(i, c);
+          continue;
+        }
+      #endif
+
       char serial_char = c;
 
       /**
@@ -463,15 +506,132 @@ void Commands::get_serial() {
   }
 }
 
+#if ENABLED(BINARY_GCODE_PROTOCOL)
+
+  // Append " <letter><value / 1000>" without trailing zeros
+  static char* binary_word(char *p, const char letter, const int32_t value) {
+    *p++ = ' ';
+    *p++ = letter;
+    uint32_t v = value;
+    if (value < 0) { *p++ = '-'; v = -v; }
+
+    char digits[10];
+    uint8_t n = 0;
+    uint32_t ip = v / 1000;
+    do { digits[n++] = '0' + ip % 10; ip /= 10; } while (ip);
+    while (n) *p++ = digits[--n];
+
+    uint16_t fp = v % 1000;
+    if (fp) {
+      *p++ = '.';
+      for (uint16_t f = 100; fp; f /= 10) {
+        *p++ = '0' + fp / f;
+        fp %= f;
+      }
+    }
+    return p;
+  }
+
+  bool Commands::binary_frame_complete(const uint8_t port) {
+    const uint8_t count = binary_count[port];
+    if (count < BINARY_FRAME_HEADER) return false;
+    uint8_t length = BINARY_FRAME_HEADER + 2;
+    for (uint8_t mask = binary_frame[port][3]; mask; mask >>= 1)
+      if (mask & 1) length += 4;
+    return count == length;
+  }
+
+  void Commands::get_binary(const uint8_t port, const uint8_t c) {
+    binary_frame[port][binary_count[port]++] = c;
+    if (binary_frame_complete(port)) queue_binary(port);
+  }
+
+  void Commands::queue_binary(const uint8_t port) {
+
+    static const char word_letters[] PROGMEM = "XYZEFIJR";
+
+    // The frame is expanded into the free slot of the ring as a plain command.
+    // With the ring full it stays complete in binary_frame, and is queued
+    // by get_serial_commands() once a slot is free.
+    gcode_t * const slot = buffer_ring.reserve();
+    if (!slot) return;
+
+    uint8_t * const frame = binary_frame[port];
+    const uint8_t length = binary_count[port];
+    binary_count[port] = 0;
+
+    uint16_t crc = 0xFFFF;
+    crc16(&crc, &frame[1], length - 3);
+    if (crc != (frame[length - 2] | (uint16_t(frame[length - 1]) << 8))) {
+      binary_frame_error(PSTR(MSG_ERR_BINARY_CRC), port);
+      return;
+    }
+
+    const uint8_t seq = frame[1], code = frame[2];
+    if (!TEST(code, 7) && seq != uint8_t(binary_last_seq[port] + 1)) {
+      binary_frame_error(PSTR(MSG_ERR_BINARY_SEQUENCE), port);
+      return;
+    }
+
+    binary_last_seq[port] = seq;
+
+    char *p = slot->gcode;
+    *p++ = 'G';
+    *p++ = '0' + (code & 0x03);
+    const uint8_t *w = &frame[BINARY_FRAME_HEADER];
+    for (uint8_t b = 0; b < 8; b++) {
+      if (!TEST(frame[3], b)) continue;
+      const int32_t value = int32_t(uint32_t(w[0]) | (uint32_t(w[1]) << 8) | (uint32_t(w[2]) << 16) | (uint32_t(w[3]) << 24));
+      char word[14];                              // " X-2147483.648"
+      const uint8_t len = binary_word(word, pgm_read_byte(&word_letters[b]), value) - word;
+      // The same frame would not fit again, it is skipped instead of resent
+      if (p + len >= slot->gcode + MAX_CMD_SIZE) {
+        binary_frame_error(PSTR(MSG_ERR_BINARY_LENGTH), port, false);
+        return;
+      }
+      memcpy(p, word, len);
+      p += len;
+      w += 4;
+    }
+    *p = '\0';
+
+    // Movement commands alert when stopped
+    if (printer.isStopped()) {
+      SERIAL_LM(ER, MSG_ERR_STOPPED);
+      LCD_MESSAGEPGM(MSG_STOPPED);
+    }
+
+    slot->s_port = port;
+    slot->send_ok = true;
+    buffer_ring.commit();
+  }
+
+  void Commands::binary_frame_error(PGM_P err, const uint8_t port, const bool resend/*=true*/) {
+    SERIAL_PORT(port);
+    SERIAL_STR(ER);
+    SERIAL_STR(err);
+    SERIAL_EV(binary_last_seq[port]);
+    if (resend) {
+      while (Com::serialRead(port) != -1);
+      binary_count[port] = 0;
+      SERIAL_STR(RESEND);
+      SERIAL_EMV(" B", int(uint8_t(binary_last_seq[port] + 1)));
+    }
+    SERIAL_STR(OK);
+    SERIAL_EOL();
+    SERIAL_PORT(-1);
+  }
+
+#endif // ENABLED(BINARY_GCODE_PROTOCOL)
+
 #if HAS_SD_SUPPORT
 
   void Commands::get_sdcard() {
 
-    static char sd_line_buffer[MAX_CMD_SIZE];
     static bool stop_buffering = false,
                 sd_comment_mode = false;
 
-    if (!IS_SD_PRINTING()) return;
+    if (!IS_SD_PRINTING() || card.isAbortSDprinting()) return;
 
     #if HAS_DOOR_OPEN
       if (READ(DOOR_OPEN_PIN) != endstops.isLogic(DOOR_OPEN)) {
@@ -497,79 +657,107 @@ void Commands::get_serial() {
     if (buffer_ring.isEmpty()) stop_buffering = false;
 
     uint16_t sd_count = 0;
-    bool card_eof = card.eof();
-    while (!buffer_ring.isFull() && !card_eof && !stop_buffering) {
-      const int16_t n = card.get();
-      char sd_char = (char)n;
-      card_eof = card.eof();
+    // The end of file is handled with the block that reaches it: the
+    // synchronize() of printingHasFinished() comes back here through idle()
+    while (!buffer_ring.isFull() && !card.eof() && !stop_buffering) {
+
+      // The line is assembled straight into the free slot of the ring,
+      // the slot is only queued by commit() once the line is complete.
+      gcode_t * const slot = buffer_ring.reserve();
+
+      const uint8_t *data;
+      const uint16_t length = card.get_buffer(data);
+
       last_command_ms = millis();
       printer.max_inactivity_ms = millis();
-      if (card_eof || n == -1
-          || sd_char == '\n'  || sd_char == '\r'
-          || ((sd_char == '#' || sd_char == ':') && !sd_comment_mode)
-      ) {
-        if (card_eof) {
 
-          card.printingHasFinished();
+      if (!length) {
+        // The read failed, report it once and stop the print
+        SERIAL_LM(ER, MSG_SD_ERR_READ);
+        card.setAbortSDprinting(true);
+        break;
+      }
 
-          if (IS_SD_PRINTING())
-            sd_count = 0; // If a sub-file was printing, continue from call point
-          else {
-            SERIAL_EM(MSG_FILE_PRINTED);
-            #if ENABLED(PRINTER_EVENT_LEDS)
-              LCD_MESSAGEPGM(MSG_INFO_COMPLETED_PRINTS);
-              leds.set_green();
-              #if HAS_RESUME_CONTINUE
-                inject_P(PSTR("M0 S"
-                  #if HAS_LCD
-                    "1800"
-                  #else
-                    "60"
-                  #endif
-                ));
-              #else
-                HAL::delayMilliseconds(2000);
-                leds.set_off();
-              #endif
-            #endif // ENABLED(PRINTER_EVENT_LEDS)
-          }
-        }
-        else if (n == -1) {
-          SERIAL_LM(ER, MSG_SD_ERR_READ);
+      // Split the line directly on the buffer, the card is read once per block
+      uint16_t i = 0;
+      char sd_char = 0;
+      bool end_of_line = false;
+      while (i < length) {
+        sd_char = data[i++];
+        if (sd_char == '\n' || sd_char == '\r' || ((sd_char == '#' || sd_char == ':') && !sd_comment_mode)) {
+          end_of_line = true;
+          break;
         }
+        /**
+         * Keep fetching, but ignore normal characters beyond the max length
+         * The command will be injected when EOL is reached
+         */
+        if (sd_count >= MAX_CMD_SIZE - 1) continue;
+        if (sd_char == ';') sd_comment_mode = true;
+        if (!sd_comment_mode) slot->gcode[sd_count++] = sd_char;
+      }
+      card.consume_buffer(i);
+
+      // Line goes on in the next block, or ends with the file
+      if (end_of_line || card.eof()) {
+
         if (sd_char == '#') stop_buffering = true;
 
         sd_comment_mode = false; // for new command
 
         // Skip empty lines and comments
-        if (!sd_count) continue;
+        if (sd_count) {
+          slot->gcode[sd_count] = '\0'; // terminate string
+          slot->s_port = -2;             // Port -2 for SD non answer
+          slot->send_ok = false;         // and no send ok.
+          sd_count = 0;
 
-        sd_line_buffer[sd_count] = '\0'; // terminate string
-        sd_count = 0; // clear sd line buffer
+          buffer_ring.commit();
+        }
+      }
 
-        enqueue(sd_line_buffer, false, -2); // Port -2 for SD non answer and no send ok.
+      if (card.eof()) {
 
+        card.printingHasFinished();
+
+        if (IS_SD_PRINTING()) continue; // If a sub-file was printing, continue from call point
+
+        SERIAL_EM(MSG_FILE_PRINTED);
+        #if ENABLED(PRINTER_EVENT_LEDS)
+          LCD_MESSAGEPGM(MSG_INFO_COMPLETED_PRINTS);
+          leds.set_green();
+          #if HAS_RESUME_CONTINUE
+            inject_P(PSTR("M0 S"
+              #if HAS_LCD
+                "1800"
+              #else
+                "60"
+              #endif
+            ));
+          #else
+            HAL::delayMilliseconds(2000);
+            leds.set_off();
+          #endif
+        #endif // ENABLED(PRINTER_EVENT_LEDS)
+        break;
       }
-      else if (sd_count >= MAX_CMD_SIZE - 1) {
-        /**
-         * Keep fetching, but ignore normal characters beyond the max length
-         * The command will be injected when EOL is reached
-         */
-      }
-      else {
-        if (sd_char == ';') sd_comment_mode = true;
-        if (!sd_comment_mode) sd_line_buffer[sd_count++] = sd_char;
-      }
+
     }
 
-    printer.progress = card.percentDone();
+    #if HAS_SD_PRINT_INDEX
+      if (printindex.isLoaded() && printindex.header.print_time)
+        printer.progress = printindex.percent_done(card.getIndex());
+      else
+    #endif
+        printer.progress = card.percentDone();
   }
 
 #endif // HAS_SD_SUPPORT
 
 void Commands::process_next() {
 
-  gcode_t cmd = buffer_ring.peek();
+  // Parsed in place, the line stays in its slot until advance_queue() pops it
+  gcode_t &cmd = buffer_ring.front();
 
   if (printer.debugEcho()) {
     SERIAL_PORT(cmd.s_port);
@@ -578,16 +766,23 @@ void Commands::process_next() {
 
   printer.reset_move_ms(); // Keep steppers powered
 
+  #if HAS_SD_RESTART
+    if (restart.enabled) restart.set_executing(cmd.gcode);
+  #endif
+
   // Parse the next command in the buffer_ring
   parser.parse(cmd.gcode);
   process_parsed();
 
+  #if HAS_SD_RESTART
+    restart.clear_executing();
+  #endif
+
 }
 
 void Commands::unknown_error() {
   #if NUM_SERIAL > 1
-    gcode_t tmp = buffer_ring.peek();
-    SERIAL_PORT(tmp.s_port);
+    SERIAL_PORT(buffer_ring.front().s_port);
   #endif
   SERIAL_SMV(ECHO, MSG_UNKNOWN_COMMAND, parser.command_ptr);
   SERIAL_CHR('"');
@@ -622,13 +817,14 @@ bool Commands::enqueue_one(const char * cmd) {
 }
 
 bool Commands::enqueue(const char * cmd, bool say_ok/*=false*/, int8_t port/*=-2*/) {
-  if (*cmd == ';' || buffer_ring.isFull()) return false;
-  gcode_t temp_cmd;
-  strcpy(temp_cmd.gcode, cmd);
-  temp_cmd.s_port = port;
-  temp_cmd.send_ok = say_ok;
-  buffer_ring.enqueue(temp_cmd);
-  return true;
+  if (*cmd == ';') return false;
+  gcode_t * const slot = buffer_ring.reserve();
+  if (!slot) return false;
+  strncpy(slot->gcode, cmd, MAX_CMD_SIZE - 1);
+  slot->gcode[MAX_CMD_SIZE - 1] = '\0';
+  slot->s_port = port;
+  slot->send_ok = say_ok;
+  return buffer_ring.commit();
 }
 
 bool Commands::process_injected() {
@@ -677,48 +873,17 @@ void Commands::process_parsed(const bool say_ok/*=true*/) {
 
       case 'G': {
         const uint16_t code_num = parser.codenum;
-        G_CODE_TYPE start   = 0,
-                    middle  = 0,
-                    end     = COUNT(GCode_Table) - 1;
-
-        if (code_num <= 1) { // Execute directly the most common Gcodes
+        if (code_num <= 1) // Execute directly the most common Gcodes
           EXECUTE_G0_G1(code_num);
-        }
-        else if (WITHIN(code_num, GCode_Table[start].code, GCode_Table[end].code)) {
-          while (start <= end) {
-            middle = (start + end) >> 1;
-            if (GCode_Table[middle].code == code_num) {
-              GCode_Table[middle].command(); // Command found, execute it
-              break;
-            }
-            else if (GCode_Table[middle].code < code_num)
-              start = middle + 1;
-            else
-              end = middle - 1;
-          }
-        }
+        else if (!code_index::execute(GCode_Table, GCode_Index, code_num))
+          unknown_error();
       }
       break;
 
       case 'M': {
         const uint16_t code_num = parser.codenum;
-        M_CODE_TYPE start   = 0,
-                    middle  = 0,
-                    end     = COUNT(MCode_Table) - 1;
-
-        if (WITHIN(code_num, MCode_Table[start].code, MCode_Table[end].code)) {
-          while (start <= end) {
-            middle = (start + end) >> 1;
-            if (MCode_Table[middle].code == code_num) {
-              MCode_Table[middle].command(); // Command found, execute it
-              break;
-            }
-            else if (MCode_Table[middle].code < code_num)
-              start = middle + 1;
-            else
-              end = middle - 1;
-          }
-        }
+        if (!code_index::execute(MCode_Table, MCode_Index, code_num))
+          unknown_error();
 
         // With M105 "ok" already sended
         if (code_num == 105) return;
@@ -69,6 +69,30 @@ class Commands {
 
     static int serial_count[NUM_SERIAL];
 
+    #if ENABLED(BINARY_GCODE_PROTOCOL)
+      /**
+       * Binary G-code frames, mixed with ASCII lines on the same port.
+       * A frame may only start where a new line would start:
+       *
+       *   0xA5       Sync, never found in an ASCII command
+       *   seq        Sequence number, last frame + 1 (mod 256) on this port
+       *   code       Bits 0-1: G0..G3. Bit 7: accept seq as the new sequence start
+       *   mask       Words present, bit 0-7: X Y Z E F I J R
+       *   words      int32 little endian, value * 1000, in mask order
+       *   crc        CRC-16/CCITT (init 0xFFFF) of seq..words, little endian
+       *
+       * A bad CRC, a sequence gap or a frame cut short for BINARY_FRAME_TIMEOUT
+       * is answered with "Resend: B<seq>". A frame too long for MAX_CMD_SIZE
+       * once expanded is answered with an error and skipped. A frame complete
+       * while the ring is full waits in binary_frame, and its port is not read,
+       * until a slot is free: its ok comes late but nothing is resent.
+       */
+      static uint8_t  binary_frame[NUM_SERIAL][BINARY_FRAME_MAX_SIZE],
+                      binary_count[NUM_SERIAL],
+                      binary_last_seq[NUM_SERIAL];
+      static millis_s binary_ms[NUM_SERIAL];    // Last byte of the partial frame
+    #endif
+
     /**
      * Next Injected Command pointer. Nullptr if no commands are being injected.
      * Used by MK4duo internally to ensure that commands initiated from within
@@ -208,6 +232,18 @@ class Commands {
 
     static void gcode_line_error(PGM_P err, const int8_t tmp_port);
 
+    #if ENABLED(BINARY_GCODE_PROTOCOL)
+      /**
+       * Collect one byte of a binary frame and queue the frame,
+       * as a plain command line, once it is complete
+       */
+      static void get_binary(const uint8_t port, const uint8_t c);
+      static bool binary_frame_complete(const uint8_t port);
+      static void queue_binary(const uint8_t port);
+
+      static void binary_frame_error(PGM_P err, const uint8_t port, const bool resend=true);
+    #endif
+
     /**
      * Enqueue with Serial Echo
      * Return true on success
@@ -281,10 +281,8 @@ inline void gcode_G29(void) {
         }
         if (WITHIN(i, 0, GRID_MAX_POINTS_X - 1) && WITHIN(j, 0, GRID_MAX_POINTS_Y)) {
           bedlevel.set_bed_leveling_enabled(false);
-          abl.z_values[i][j] = rz;
-          #if ENABLED(ABL_BILINEAR_SUBDIVISION)
-            abl.virt_interpolate();
-          #endif
+          abl.set_z_value(i, j, rz);
+          abl.refresh_bed_level();
           bedlevel.restore_bed_leveling_state();
           mechanics.report_current_position();
         }
@@ -500,12 +498,12 @@ inline void gcode_G29(void) {
 
       #elif ENABLED(AUTO_BED_LEVELING_BILINEAR)
 
-        abl.z_values[xCount][yCount] = measured_z + zoffset;
+        abl.set_z_value(xCount, yCount, measured_z + zoffset);
 
         if (printer.debugFeature()) {
           DEBUG_MV("Save X", xCount);
           DEBUG_MV(" Y", yCount);
-          DEBUG_EMV(" Z", abl.z_values[xCount][yCount]);
+          DEBUG_EMV(" Z", abl.z_value(xCount, yCount));
         }
 
       #endif
@@ -671,7 +669,7 @@ inline void gcode_G29(void) {
 
           #elif ENABLED(AUTO_BED_LEVELING_BILINEAR)
 
-            abl.z_values[xCount][yCount] = measured_z + zoffset;
+            abl.set_z_value(xCount, yCount, measured_z + zoffset);
 
           #endif
 
@@ -681,6 +679,34 @@ inline void gcode_G29(void) {
         } // inner
       } // outer
 
+      #if ENABLED(ABL_REFINE)
+
+        // Probe the center of the cells where the grid is most curved
+        if (!isnan(measured_z)) {
+          const uint8_t refine_count = abl.select_refine_cells();
+          for (uint8_t i = 0; i < refine_count; i++) {
+
+            xProbe = abl.refine_x(i);
+            yProbe = abl.refine_y(i);
+
+            #if IS_KINEMATIC
+              if (!mechanics.position_is_reachable_by_probe(xProbe, yProbe)) continue;
+            #endif
+
+            measured_z = faux ? 0.001 * random(-100, 101) : probe.check_pt(xProbe, yProbe, raise_after, verbose_level);
+
+            if (isnan(measured_z)) {
+              bedlevel.restore_bed_leveling_state();
+              break;
+            }
+
+            abl.set_refine_z(i, measured_z + zoffset);
+            printer.idle();
+          }
+        }
+
+      #endif // ABL_REFINE
+
     #elif ENABLED(AUTO_BED_LEVELING_3POINT)
 
       // Probe at 3 arbitrary points
@@ -151,11 +151,15 @@ inline void gcode_M420(void) {
           if (!NEAR_ZERO(zmean)) {
             bedlevel.set_bed_leveling_enabled(false);
             // Subtract the mean from all values
-            for (uint8_t x = GRID_MAX_POINTS_X; x--;)
-              for (uint8_t y = GRID_MAX_POINTS_Y; y--;)
-                Z_VALUES(x, y) -= zmean;
-            #if ENABLED(ABL_BILINEAR_SUBDIVISION)
-              abl.virt_interpolate();
+            #if ENABLED(ABL_COMPACT_MESH)
+              abl.offset_mesh(-zmean);
+            #else
+              for (uint8_t x = GRID_MAX_POINTS_X; x--;)
+                for (uint8_t y = GRID_MAX_POINTS_Y; y--;)
+                  Z_VALUES(x, y) -= zmean;
+            #endif
+            #if ENABLED(AUTO_BED_LEVELING_BILINEAR)
+              abl.refresh_bed_level();
             #endif
           }
 
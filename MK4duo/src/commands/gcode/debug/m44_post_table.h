@@ -38,25 +38,25 @@ inline void gcode_M44(void) {
 
   if (parser.seen('I')) {
     SERIAL_EMV("Number of G-codes available: ", (int)(COUNT(GCode_Table) + 2));
-    SERIAL_MV("G-code table static memory consumption: ", (int)sizeof(GCode_Table));
+    SERIAL_MV("G-code table static memory consumption: ", (int)(sizeof(GCode_Table) + sizeof(GCode_Index)));
     SERIAL_EM(" bytes.");
 
     SERIAL_EM("Complete list of G-codes available for this machine:");
     SERIAL_EM("G0");
     SERIAL_EM("G1");
     for (G_CODE_TYPE index = 0; index < COUNT(GCode_Table); index++) {
-      SERIAL_EMV("G", GCode_Table[index].code);
+      SERIAL_EMV("G", (int)code_index::read_code(&GCode_Table[index].code));
     }
   }
 
   if (parser.seen('J')) {
     SERIAL_EMV("Number of M-codes available: ", (int)COUNT(MCode_Table));
-    SERIAL_MV("M-code table static memory consumption: ", (int)sizeof(MCode_Table));
+    SERIAL_MV("M-code table static memory consumption: ", (int)(sizeof(MCode_Table) + sizeof(MCode_Index)));
     SERIAL_EM(" bytes.");
 
     SERIAL_EM("Complete list of M-codes available for this machine:");
     for (M_CODE_TYPE index = 0; index < (COUNT(MCode_Table) - 1); index++) {
-      SERIAL_EMV("M", MCode_Table[index].code);
+      SERIAL_EMV("M", (int)code_index::read_code(&MCode_Table[index].code));
     }
   }
 
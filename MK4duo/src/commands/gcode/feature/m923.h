@@ -0,0 +1,48 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mcode
+ *
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(STALLGUARD_TELEMETRY)
+
+#define CODE_M923
+
+/**
+ * M923: StallGuard load telemetry
+ *
+ *  S<ms> Stream the report every S milliseconds, S0 to stop
+ *
+ *  Without S report once the lowest load of every driver since the last
+ *  report and the speed of its block, with the current raised near to a stall.
+ */
+inline void gcode_M923(void) {
+  if (parser.seen('S'))
+    tmc.load_report_interval = parser.value_ushort();
+  else
+    tmc.report_load();
+}
+
+#endif // STALLGUARD_TELEMETRY
@@ -127,6 +127,7 @@
 #include "feature/m930_m939.h"            // Set TRINAMIC driver
 #include "feature/m940_m942.h"            // Set TRINAMIC driver
 #include "feature/m922.h"                 // TMC DEBUG
+#include "feature/m923.h"                 // StallGuard telemetry
 
 // Geometry Commands
 #include "geometry/g17_g19.h"
@@ -264,6 +265,7 @@
   // Table for G and M code
   #include "table_gcode.h"
   #include "table_mcode.h"
+  #include "table_index.h"
 
   // Include m44 post define table for debugging
   #include "debug/m44_post_table.h"
@@ -116,6 +116,13 @@ inline void gcode_M115(void) {
     SERIAL_CAP("EMERGENCY_PARSER:0");
   #endif
 
+  // BINARY_GCODE (framed G0-G3 on the serial ports)
+  #if ENABLED(BINARY_GCODE_PROTOCOL)
+    SERIAL_CAP("BINARY_GCODE:1");
+  #else
+    SERIAL_CAP("BINARY_GCODE:0");
+  #endif
+
   // CHAMBER_TEMPERATURE (M141, M191)
   #if HAS_CHAMBERS
     SERIAL_CAP("CHAMBER_TEMPERATURE:1");
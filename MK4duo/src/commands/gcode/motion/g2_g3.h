@@ -37,10 +37,10 @@
  * Plan an arc in 2 dimensions
  *
  * The arc is approximated by generating many small linear segments.
- * The length of each segment is configured in MM_PER_ARC_SEGMENT (Default 1mm)
- * Arcs should only be made relatively large (over 5mm), as larger arcs with
- * larger segments will tend to be more efficient. Your slicer should have
- * options for G2/G3 arc generation. In future these options may be GCode tunable.
+ * The length of each segment keeps them within ARC_CHORD_TOLERANCE of the arc,
+ * but not shorter than the planner can handle at the current feedrate, and
+ * within MIN_ARC_SEGMENT_MM and MM_PER_ARC_SEGMENT.
+ * Small arcs get short segments, big arcs long ones.
  */
 void plan_arc(const float (&cart)[XYZE], const float (&offset)[2], const uint8_t clockwise) {
 
@@ -93,8 +93,19 @@ void plan_arc(const float (&cart)[XYZE], const float (&offset)[2], const uint8_t
               mm_of_travel = linear_travel ? HYPOT(flat_mm, linear_travel) : ABS(flat_mm);
   if (mm_of_travel < 0.001f) return;
 
-  uint16_t segments = FLOOR(mm_of_travel / (MM_PER_ARC_SEGMENT));
-  if (segments == 0) segments = 1;
+  const float fr_mm_s = MMS_SCALED(mechanics.feedrate_mm_s);
+
+  // Longest chord within the tolerance from the arc
+  float seg_length = radius > (ARC_CHORD_TOLERANCE)
+    ? 2.0f * SQRT((ARC_CHORD_TOLERANCE) * (2.0f * radius - (ARC_CHORD_TOLERANCE)))
+    : (MM_PER_ARC_SEGMENT);
+  // Half of the planner buffer should hold at least min_segment_time_us of moves
+  NOLESS(seg_length, fr_mm_s * mechanics.data.min_segment_time_us * (2.0f / (BLOCK_BUFFER_SIZE) / 1000000.0f));
+  seg_length = constrain(seg_length, MIN_ARC_SEGMENT_MM, MM_PER_ARC_SEGMENT);
+
+  uint16_t segments = FLOOR(mm_of_travel / seg_length);
+  NOLESS(segments, min_segments);
+  seg_length = mm_of_travel / segments;
 
   /**
    * Vector rotation by transformation matrix: r is the original vector, r_T is the rotated vector,
@@ -104,31 +115,20 @@ void plan_arc(const float (&cart)[XYZE], const float (&offset)[2], const uint8_t
    *
    * For arc generation, the center of the circle is the axis of rotation and the radius vector is
    * defined from the circle center to the initial position. Each line segment is formed by successive
-   * vector rotations. This requires only two cos() and sin() computations to form the rotation
-   * matrix for the duration of the entire arc. Error may accumulate from numerical round-off, since
-   * all double numbers are single precision on the Arduino. (True double precision will not have
-   * round off issues for CNC applications.) Single precision error can accumulate to be greater than
-   * tool precision in some cases. Therefore, arc path correction is implemented.
+   * vector rotations. This requires only one cos() and sin() computation to form the rotation
+   * matrix for the duration of the entire arc.
    *
-   * Small angle approximation may be used to reduce computation overhead further. This approximation
-   * holds for everything, but very small circles and large MM_PER_ARC_SEGMENT values. In other words,
-   * theta_per_segment would need to be greater than 0.1 rad and N_ARC_CORRECTION would need to be large
-   * to cause an appreciable drift error. N_ARC_CORRECTION~=25 is more than small enough to correct for
-   * numerical drift error. N_ARC_CORRECTION may be on the order a hundred(s) before error becomes an
-   * issue for CNC machines with the single precision Arduino calculations.
-   *
-   * This approximation also allows plan_arc to immediately insert a line segment into the planner
-   * without the initial overhead of computing cos() or sin(). By the time the arc needs to be applied
-   * a correction, the planner should have caught up to the lag caused by the initial plan_arc overhead.
-   * This is important when there are successive arc motions.
+   * Single precision round-off makes the length of the rotated vector drift slowly from the radius.
+   * Every N_ARC_CORRECTION segments the vector is scaled back to the radius, the small angle error
+   * left is removed by the last segment, that always ends on the target.
    */
   // Vector rotation matrix values
   float raw[XYZE];
   const float theta_per_segment = angular_travel / segments,
               linear_per_segment = linear_travel / segments,
               extruder_per_segment = extruder_travel / segments,
-              sin_T = theta_per_segment,
-              cos_T = 1 - 0.5f * sq(theta_per_segment); // Small angle approximation
+              sin_T = sin(theta_per_segment),
+              cos_T = cos(theta_per_segment);
 
   // Initialize the linear axis
   raw[l_axis] = mechanics.current_position[l_axis];
@@ -136,10 +136,8 @@ void plan_arc(const float (&cart)[XYZE], const float (&offset)[2], const uint8_t
   // Initialize the extruder axis
   raw[E_AXIS] = mechanics.current_position[E_AXIS];
 
-  const float fr_mm_s = MMS_SCALED(mechanics.feedrate_mm_s);
-
   #if ENABLED(SCARA_FEEDRATE_SCALING)
-    const float inv_duration = fr_mm_s / MM_PER_ARC_SEGMENT;
+    const float inv_duration = fr_mm_s / seg_length;
   #endif
 
   millis_s next_idle_ms = millis();
@@ -148,32 +146,30 @@ void plan_arc(const float (&cart)[XYZE], const float (&offset)[2], const uint8_t
     int8_t arc_recalc_count = N_ARC_CORRECTION;
   #endif
 
+  // Let the planner take the segments in batches
+  planner.begin_batch(ARC_SEGMENT_BATCH);
+
   for (uint16_t i = 1; i < segments; i++) { // Iterate (segments-1) times
 
     if (expired(&next_idle_ms, 200U)) printer.idle();
 
+    // Apply vector rotation matrix to previous r_P / 1
+    const float r_new_Y = r_P * sin_T + r_Q * cos_T;
+    r_P = r_P * cos_T - r_Q * sin_T;
+    r_Q = r_new_Y;
+
     #if N_ARC_CORRECTION > 1
-      if (--arc_recalc_count) {
-        // Apply vector rotation matrix to previous r_P / 1
-        const float r_new_Y = r_P * sin_T + r_Q * cos_T;
-        r_P = r_P * cos_T - r_Q * sin_T;
-        r_Q = r_new_Y;
-      }
-      else
+      if (!--arc_recalc_count)
     #endif
     {
       #if N_ARC_CORRECTION > 1
         arc_recalc_count = N_ARC_CORRECTION;
       #endif
 
-      // Arc correction to radius vector. Computed only every N_ARC_CORRECTION increments.
-      // Compute exact location by applying transformation matrix from initial radius vector(=-offset).
-      // To reduce stuttering, the sin and cos could be computed at different times.
-      // For now, compute both at the same time.
-      const float cos_Ti = cos(i * theta_per_segment),
-                  sin_Ti = sin(i * theta_per_segment);
-      r_P = -offset[0] * cos_Ti + offset[1] * sin_Ti;
-      r_Q = -offset[0] * sin_Ti - offset[1] * cos_Ti;
+      // Bring the radius vector back to the radius
+      const float scale = radius / HYPOT(r_P, r_Q);
+      r_P *= scale;
+      r_Q *= scale;
     }
 
     // Update raw location
@@ -193,7 +189,7 @@ void plan_arc(const float (&cart)[XYZE], const float (&offset)[2], const uint8_t
       bedlevel.apply_leveling(raw);
     #endif
 
-    if (!planner.buffer_line(raw, fr_mm_s, tools.extruder.active, MM_PER_ARC_SEGMENT
+    if (!planner.buffer_line(raw, fr_mm_s, tools.extruder.active, seg_length
       #if ENABLED(SCARA_FEEDRATE_SCALING)
         , inv_duration
       #endif
@@ -211,12 +207,14 @@ void plan_arc(const float (&cart)[XYZE], const float (&offset)[2], const uint8_t
     bedlevel.apply_leveling(raw);
   #endif
 
-  planner.buffer_line(raw, fr_mm_s, tools.extruder.active, MM_PER_ARC_SEGMENT
+  planner.buffer_line(raw, fr_mm_s, tools.extruder.active, seg_length
     #if ENABLED(SCARA_FEEDRATE_SCALING)
       , inv_duration
     #endif
   );
 
+  planner.end_batch();
+
   #if ENABLED(AUTO_BED_LEVELING_UBL)
     raw[l_axis] = start_L;
   #endif
@@ -32,9 +32,27 @@
 
 /**
  * M26: Set SD Card file index
+ *
+ *  S<pos>    File position
+ *  L<layer>  Start of a layer, from the print index of the file
  */
 inline void gcode_M26(void) {
-  if (card.isDetected() && parser.seenval('S'))
+  if (!card.isDetected()) return;
+
+  #if HAS_SD_PRINT_INDEX
+    if (parser.seenval('L')) {
+      print_index_layer_t layer;
+      if (printindex.layer_start(parser.value_ushort(), layer)) {
+        card.setIndex(layer.sdpos);
+        SERIAL_EMV("Layer Z:", layer.z, 3);
+      }
+      else
+        SERIAL_LM(ER, "No such layer in the print index");
+      return;
+    }
+  #endif
+
+  if (parser.seenval('S'))
     card.setIndex(parser.value_long());
 }
 
@@ -36,7 +36,7 @@ typedef struct {
 	const command_t command;
 } GCode_command_t;
 
-constexpr GCode_command_t GCode_Table[] = {
+constexpr GCode_command_t GCode_Table[] PROGMEM = {
 
   #if ENABLED(CODE_G2)
     { 2, gcode_G2 },
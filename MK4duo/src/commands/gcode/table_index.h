@@ -0,0 +1,106 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * table_index.h
+ *
+ * Direct index for the G and M code tables, generated by the compiler.
+ * For every code number up to CODE_INDEX_LIMIT the index holds the
+ * table position + 1 (0 = no handler), so a command is dispatched with
+ * one read of the index and one of the table.
+ * The few codes above the limit (M9999) are searched in the table tail.
+ *
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ */
+
+#define CODE_INDEX_LIMIT 1001
+
+namespace code_index {
+
+  // Compile-time sequence 0..N-1, built with log(N) template depth
+  template <uint16_t... I> struct sequence { typedef sequence type; };
+
+  template <typename A, typename B> struct join;
+  template <uint16_t... I, uint16_t... J>
+  struct join<sequence<I...>, sequence<J...>> : sequence<I..., (sizeof...(I) + J)...> {};
+
+  template <uint16_t N> struct make_sequence : join<typename make_sequence<N / 2>::type, typename make_sequence<N - N / 2>::type> {};
+  template <> struct make_sequence<0> : sequence<> {};
+  template <> struct make_sequence<1> : sequence<0> {};
+
+  // Table position + 1 of code, 0 if there is no handler
+  template <typename T, size_t N>
+  constexpr uint8_t position(const T (&table)[N], const uint16_t code, const int lo, const int hi) {
+    return lo > hi                                ? 0
+         : table[(lo + hi) / 2].code == code      ? (lo + hi) / 2 + 1
+         : table[(lo + hi) / 2].code < code       ? position(table, code, (lo + hi) / 2 + 1, hi)
+                                                  : position(table, code, lo, (lo + hi) / 2 - 1);
+  }
+
+  // Highest code below limit + 1
+  template <typename T, size_t N>
+  constexpr uint16_t dense_size(const T (&table)[N], const uint16_t limit, const size_t i=N) {
+    return !i ? 0 : table[i - 1].code < limit ? table[i - 1].code + 1 : dense_size(table, limit, i - 1);
+  }
+
+  template <uint16_t S>
+  struct index_t {
+    uint8_t pos[S];
+  };
+
+  template <typename T, size_t N, uint16_t... I>
+  constexpr index_t<sizeof...(I)> make_index(const T (&table)[N], sequence<I...>) {
+    return {{ position(table, I, 0, N - 1)... }};
+  }
+
+  template <typename T>
+  FORCE_INLINE uint16_t read_code(const T * const p) {
+    return sizeof(*p) == 1 ? (uint16_t)pgm_read_byte(p) : (uint16_t)pgm_read_word(p);
+  }
+
+  /**
+   * Run the handler of code, return false if there is none
+   */
+  template <typename T, size_t N, uint16_t S>
+  inline bool execute(const T (&table)[N], const index_t<S> &index, const uint16_t code) {
+    uint8_t pos = 0;
+    if (code < S)
+      pos = pgm_read_byte(&index.pos[code]);
+    else {
+      for (uint8_t i = N; i-- && read_code(&table[i].code) >= S;)
+        if (read_code(&table[i].code) == code) { pos = i + 1; break; }
+    }
+    if (!pos) return false;
+    ((command_t)pgm_read_ptr(&table[pos - 1].command))();
+    return true;
+  }
+
+}
+
+static_assert(COUNT(GCode_Table) < 255 && COUNT(MCode_Table) < 255, "Code tables are too big for an 8 bit index.");
+
+constexpr uint16_t G_CODE_INDEX_SIZE = code_index::dense_size(GCode_Table, CODE_INDEX_LIMIT),
+                   M_CODE_INDEX_SIZE = code_index::dense_size(MCode_Table, CODE_INDEX_LIMIT);
+
+constexpr code_index::index_t<G_CODE_INDEX_SIZE> GCode_Index PROGMEM = code_index::make_index(GCode_Table, code_index::make_sequence<G_CODE_INDEX_SIZE>::type());
+constexpr code_index::index_t<M_CODE_INDEX_SIZE> MCode_Index PROGMEM = code_index::make_index(MCode_Table, code_index::make_sequence<M_CODE_INDEX_SIZE>::type());
@@ -35,7 +35,7 @@ typedef struct {
 	const command_t command;
 } MCode_command_t;
 
-constexpr MCode_command_t MCode_Table [] = {
+constexpr MCode_command_t MCode_Table [] PROGMEM = {
 
 	#if ENABLED(CODE_M0)
 		{ 0, gcode_M0_M1 },
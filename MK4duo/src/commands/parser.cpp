@@ -54,6 +54,11 @@ uint16_t GCodeParser::codenum;
   // Optimized Parameters
   uint32_t  GCodeParser::codebits;  // found bits
   uint8_t   GCodeParser::param[26]; // parameter offsets from command_ptr
+  #if ENABLED(FASTER_GCODE_VALUES)
+    uint32_t      GCodeParser::intbits;   // values without a decimal point
+    gcode_value_t GCodeParser::value[26]; // values converted by parse()
+    uint8_t       GCodeParser::value_ind; // value index set by seen()
+  #endif
 #else
   char *GCodeParser::command_args; // start of parameters
 #endif
@@ -76,6 +81,9 @@ void GCodeParser::reset() {
   #endif
   #if ENABLED(FASTER_GCODE_PARSER)
     codebits = 0;                     // No codes yet
+    #if ENABLED(FASTER_GCODE_VALUES)
+      intbits = 0;                    // No integer values yet
+    #endif
     //ZERO(param);                    // No parameters (should be safe to comment out this line)
   #endif
 }
@@ -257,6 +265,60 @@ pin_t GCodeParser::analog_value_pin() {
   return WITHIN(pin, 0 , NUM_ANALOG_INPUTS) ? pin : NoPin;
 }
 
+#if ENABLED(FASTER_GCODE_VALUES)
+
+  /**
+   * Convert [-+]digits[.digits] like strtol or strtof would do.
+   * Up to 9 significant digits are collected in an integer,
+   * then the decimal point is applied with a single float
+   * divide or multiply. Integer values are kept exact.
+   */
+  void GCodeParser::set_value(const uint8_t ind, const char *p) {
+    const bool neg = (*p == '-');
+    if (neg || *p == '+') p++;
+
+    uint32_t mant = 0;
+    uint8_t digits = 0;
+    int8_t scale = 0;
+    bool point = false;
+
+    for (;; p++) {
+      const char c = *p;
+      if (NUMERIC(c)) {
+        if (digits < 9) {
+          mant = mant * 10 + (c - '0');
+          if (mant) digits++;           // Leading zeros are not significant
+          if (point && scale > -40) scale--;
+        }
+        else if (!point && scale < 30)
+          scale++;                      // Drop integer digits, keep the magnitude
+      }
+      else if (c == '.' && !point)
+        point = true;
+      else
+        break;
+    }
+
+    if (!point && !scale) {
+      SBI32(intbits, ind);
+      value[ind].l = neg ? -int32_t(mant) : int32_t(mant);
+      return;
+    }
+
+    CBI32(intbits, ind);
+    float v = mant;
+    if (scale < 0) {
+      float d = 10.0f;
+      for (int8_t s = -1; s > scale; s--) d *= 10.0f; // Exact up to 10^10
+      v /= d;
+    }
+    else
+      while (scale--) v *= 10.0f;
+    value[ind].f = neg ? -v : v;
+  }
+
+#endif // FASTER_GCODE_VALUES
+
 #if ENABLED(INCH_MODE_SUPPORT)
 
   float GCodeParser::axis_unit_factor(const AxisEnum axis) {
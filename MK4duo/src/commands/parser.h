@@ -29,6 +29,14 @@
 
 //#define DEBUG_GCODE_PARSER
 
+#if ENABLED(FASTER_GCODE_VALUES)
+  // A parameter value converted by the parser
+  typedef union {
+    float   f;  // Value with a decimal point
+    int32_t l;  // Value without a decimal point
+  } gcode_value_t;
+#endif
+
 /**
  * Parser Gcode
  *
@@ -36,6 +44,8 @@
  *  - FASTER_GCODE_PARSER:
  *    - Flags existing params (1 bit each)
  *    - Stores value offsets (1 byte each)
+ *  - FASTER_GCODE_VALUES:
+ *    - Converts the values once (4 bytes each)
  *  - Provide accessors for parameters:
  *    - Parameter exists
  *    - Parameter has value
@@ -73,6 +83,11 @@ class GCodeParser {
     #if ENABLED(FASTER_GCODE_PARSER)
       static uint32_t codebits;   // Parameters pre-scanned
       static uint8_t param[26];   // For A-Z, offsets into command args
+      #if ENABLED(FASTER_GCODE_VALUES)
+        static uint32_t intbits;          // Parameter values without a decimal point
+        static gcode_value_t value[26];   // For A-Z, values converted by parse()
+        static uint8_t value_ind;         // Set by seen, the value to fetch
+      #endif
     #else
       static char *command_args;  // Args start here, for slow scan
     #endif
@@ -108,6 +123,9 @@ class GCodeParser {
         if (ind >= COUNT(param)) return;           // Only A-Z
         SBI32(codebits, ind);                      // parameter exists
         param[ind] = ptr ? ptr - command_ptr : 0;  // parameter offset or 0
+        #if ENABLED(FASTER_GCODE_VALUES)
+          if (ptr) set_value(ind, ptr);            // Convert the value once
+        #endif
         #if ENABLED(DEBUG_GCODE_PARSER)
           if (codenum == 1000) {
             SERIAL_MV("Set bit ", (int)ind);
@@ -127,6 +145,9 @@ class GCodeParser {
         if (b) {
           char * const ptr = command_ptr + param[ind];
           value_ptr = param[ind] && valid_float(ptr) ? ptr : (char*)NULL;
+          #if ENABLED(FASTER_GCODE_VALUES)
+            value_ind = ind;
+          #endif
         }
         return b;
       }
@@ -202,6 +223,23 @@ class GCodeParser {
     // Seen a parameter with a value
     static inline bool seenval(const char c) { return seen(c) && has_value(); }
 
+    #if ENABLED(FASTER_GCODE_VALUES)
+
+      // Values were converted by parse(), just load them
+      static inline float value_float() {
+        if (!value_ptr) return 0;
+        return TEST32(intbits, value_ind) ? float(value[value_ind].l) : value[value_ind].f;
+      }
+
+      // Code value as a long or ulong
+      static inline int32_t value_long() {
+        if (!value_ptr) return 0L;
+        return TEST32(intbits, value_ind) ? value[value_ind].l : float_to_long(value[value_ind].f);
+      }
+      static inline uint32_t  value_ulong() { return uint32_t(value_long()); }
+
+    #else
+
     // Float removes 'E' to prevent scientific notation interpretation
     static inline float value_float() {
       if (value_ptr) {
@@ -226,6 +264,8 @@ class GCodeParser {
     static inline int32_t   value_long()  { return value_ptr ? strtol(value_ptr, NULL, 10) : 0L; }
     static inline uint32_t  value_ulong() { return value_ptr ? strtoul(value_ptr, NULL, 10) : 0UL; }
 
+    #endif // !FASTER_GCODE_VALUES
+
     // Code value for use as time
     static inline millis_l  value_millis()              { return value_ulong(); }
     static inline millis_l  value_millis_from_seconds() { return (millis_l)(value_float() * 1000); }
@@ -340,6 +380,18 @@ class GCodeParser {
 
   private: /** Private Function */
 
+    #if ENABLED(FASTER_GCODE_VALUES)
+
+      // Convert a parameter value, in the fixed decimal format of GCode
+      static void set_value(const uint8_t ind, const char *p);
+
+      // Truncate like strtol, saturating out of range values
+      static inline int32_t float_to_long(const float f) {
+        return f >= 2147483647.0f ? INT32_MAX : f <= -2147483648.0f ? INT32_MIN : int32_t(f);
+      }
+
+    #endif
+
 };
 
 extern GCodeParser parser;
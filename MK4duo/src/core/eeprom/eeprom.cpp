@@ -161,7 +161,14 @@ typedef struct EepromDataStruct {
                     grid_max_y;
     int             bilinear_grid_spacing[2],
                     bilinear_start[2];
-    float           z_values[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y];
+    abl_z_t         z_values[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y];
+    #if ENABLED(ABL_COMPACT_MESH)
+      float         mesh_plane[3];
+      #if ENABLED(ABL_REFINE)
+        uint8_t       refine_count;
+        abl_refine_t  refine[ABL_REFINE_POINTS];
+      #endif
+    #endif
   #endif
 
   //
@@ -419,6 +426,10 @@ void EEPROM::post_process() {
 
     int eeprom_index = EEPROM_OFFSET;
 
+    #if ENABLED(EEPROM_CHITCHAT)
+      const millis_l start_ms = millis();
+    #endif
+
     flag.error = false;
 
     #if HAS_EEPROM_FLASH
@@ -542,7 +553,14 @@ void EEPROM::post_process() {
       EEPROM_WRITE(grid_max_y);                 // 1 byte
       EEPROM_WRITE(abl.bilinear_grid_spacing);  // 2 ints
       EEPROM_WRITE(abl.bilinear_start);         // 2 ints
-      EEPROM_WRITE(abl.z_values);               // 9-256 floats
+      EEPROM_WRITE(abl.z_values);               // 9-256 floats or offsets
+      #if ENABLED(ABL_COMPACT_MESH)
+        EEPROM_WRITE(abl.mesh_plane);           // 3 floats
+        #if ENABLED(ABL_REFINE)
+          EEPROM_WRITE(abl.refine_count);       // 1 byte
+          EEPROM_WRITE(abl.refine);             // ABL_REFINE_POINTS centers
+        #endif
+      #endif
     #endif // AUTO_BED_LEVELING_BILINEAR
 
     //
@@ -745,6 +763,11 @@ void EEPROM::post_process() {
 
     flag.error |= memorystore.access_write();
 
+    #if ENABLED(EEPROM_CHITCHAT)
+      SERIAL_SMV(ECHO, "Settings store time: ", millis() - start_ms);
+      SERIAL_EM(" ms");
+    #endif
+
     sound.feedback(!flag.error);
 
     return !flag.error;
@@ -762,6 +785,10 @@ void EEPROM::post_process() {
 
     int eeprom_index = EEPROM_OFFSET;
 
+    #if ENABLED(EEPROM_CHITCHAT)
+      const millis_l start_ms = millis();
+    #endif
+
     EEPROM_READ_ALWAYS(stored_ver);
     EEPROM_READ_ALWAYS(stored_crc);
 
@@ -888,15 +915,32 @@ void EEPROM::post_process() {
           if (!flag.validating) bedlevel.set_bed_leveling_enabled(false);
           EEPROM_READ(abl.bilinear_grid_spacing); // 2 ints
           EEPROM_READ(abl.bilinear_start);        // 2 ints
-          EEPROM_READ(abl.z_values);              // 9 to 256 floats
+          EEPROM_READ(abl.z_values);              // 9 to 256 floats or offsets
+          #if ENABLED(ABL_COMPACT_MESH)
+            EEPROM_READ(abl.mesh_plane);          // 3 floats
+            #if ENABLED(ABL_REFINE)
+              EEPROM_READ(abl.refine_count);      // 1 byte
+              EEPROM_READ(abl.refine);            // ABL_REFINE_POINTS centers
+            #endif
+          #endif
         }
         else { // EEPROM data is stale
           // Skip past disabled (or stale) Bilinear Grid data
           int bgs[2], bs[2];
           EEPROM_READ(bgs);
           EEPROM_READ(bs);
-          float dummy = 0;
+          abl_z_t dummy = 0;
           for (uint16_t q = grid_max_x * grid_max_y; q--;) EEPROM_READ(dummy);
+          #if ENABLED(ABL_COMPACT_MESH)
+            float mp[3];
+            EEPROM_READ(mp);
+            #if ENABLED(ABL_REFINE)
+              uint8_t rc;
+              abl_refine_t rf[ABL_REFINE_POINTS];
+              EEPROM_READ(rc);
+              EEPROM_READ(rf);
+            #endif
+          #endif
         }
       #endif // AUTO_BED_LEVELING_BILINEAR
 
@@ -1113,7 +1157,8 @@ void EEPROM::post_process() {
           SERIAL_ST(ECHO, version);
           SERIAL_MV(" Stored settings retrieved (", eeprom_index - (EEPROM_OFFSET));
           SERIAL_MV(" bytes; crc ", (uint32_t)working_crc);
-          SERIAL_EM(")");
+          SERIAL_MV("; ", millis() - start_ms);
+          SERIAL_EM(" ms)");
         #endif
       }
 
@@ -1209,6 +1254,8 @@ void EEPROM::post_process() {
         SERIAL_VAL(s);
         SERIAL_EM(" mesh slots available.");
       }
+    #else
+      FORCE_INLINE void ubl_invalid_slot(const int) {}
     #endif
 
     const uint16_t EEPROM::meshes_end = memorystore.capacity() - 129;
@@ -1571,7 +1618,7 @@ void EEPROM::reset() {
             for (uint8_t px = 0; px < GRID_MAX_POINTS_X; px++) {
               SERIAL_SMV(CFG, "  G29 W I", (int)px);
               SERIAL_MV(" J", (int)py);
-              SERIAL_MV(" Z", LINEAR_UNIT(abl.z_values[px][py]), 5);
+              SERIAL_MV(" Z", LINEAR_UNIT(abl.z_value(px, py)), 5);
               SERIAL_EOL();
             }
           }
@@ -29,10 +29,11 @@
 
 #if HAS_HEATER
 
-Heater hotends[HOTENDS]   = Heater(IS_HOTEND, HOTEND_CHECK_INTERVAL, HOTEND_HYSTERESIS, WATCH_HOTEND_PERIOD, WATCH_HOTEND_INCREASE);
-Heater beds[BEDS]         = Heater(IS_BED, BED_CHECK_INTERVAL, BED_HYSTERESIS, WATCH_BED_PERIOD, WATCH_BED_INCREASE);
-Heater chambers[CHAMBERS] = Heater(IS_CHAMBER, CHAMBER_CHECK_INTERVAL, CHAMBER_HYSTERESIS, WATCH_CHAMBER_PERIOD, WATCH_CHAMBER_INCREASE);
-Heater coolers[COOLERS]   = Heater(IS_COOLER, COOLER_CHECK_INTERVAL, COOLER_HYSTERESIS, WATCH_COOLER_PERIOD, WATCH_COOLER_INCREASE);
+// One initializer for every heater, GCC 9 and later reject "array = Heater(...)"
+Heater hotends[HOTENDS]   = ARRAY_BY_HOTENDS(Heater(IS_HOTEND, HOTEND_CHECK_INTERVAL, HOTEND_HYSTERESIS, WATCH_HOTEND_PERIOD, WATCH_HOTEND_INCREASE));
+Heater beds[BEDS]         = ARRAY_BY_BEDS(Heater(IS_BED, BED_CHECK_INTERVAL, BED_HYSTERESIS, WATCH_BED_PERIOD, WATCH_BED_INCREASE));
+Heater chambers[CHAMBERS] = ARRAY_BY_CHAMBERS(Heater(IS_CHAMBER, CHAMBER_CHECK_INTERVAL, CHAMBER_HYSTERESIS, WATCH_CHAMBER_PERIOD, WATCH_CHAMBER_INCREASE));
+Heater coolers[COOLERS]   = ARRAY_BY_N(COOLERS, Heater(IS_COOLER, COOLER_CHECK_INTERVAL, COOLER_HYSTERESIS, WATCH_COOLER_PERIOD, WATCH_COOLER_INCREASE));
 
 /** Public Function */
 void Heater::init() {
@@ -58,7 +59,7 @@ void Heater::init() {
 
   thermal_runaway_state = TRInactive;
 
-  data.sensor.CalcDerivedParameters();
+  update_sensor_parameters();
   data.pid.update();
 
   if (printer.isRunning()) return; // All running not reinitialize
@@ -73,6 +74,13 @@ void Heater::init() {
 
 }
 
+void Heater::update_sensor_parameters() {
+  data.sensor.CalcDerivedParameters();
+  #if ENABLED(SENSOR_LOOKUP_TABLE)
+    sensor_table.build(data.sensor);
+  #endif
+}
+
 void Heater::set_target_temp(const int16_t celsius) {
 
   if (celsius == 0)
@@ -76,6 +76,10 @@ class Heater {
 
     heater_data_t   data;
 
+    #if ENABLED(SENSOR_LOOKUP_TABLE)
+      sensor_table_t  sensor_table;
+    #endif
+
     uint8_t         pwm_value;
 
     int16_t         target_temperature,
@@ -109,6 +113,8 @@ class Heater {
 
     void init();
 
+    void update_sensor_parameters();
+
     void set_target_temp(const int16_t celsius);
     void wait_for_target(bool no_wait_for_cooling=true);
     
@@ -132,7 +138,15 @@ class Heater {
     void thermal_runaway_protection();
     void start_watching();
 
-    FORCE_INLINE void update_current_temperature() { this->current_temperature = this->data.sensor.getTemperature(); }
+    FORCE_INLINE void update_current_temperature() {
+      #if ENABLED(SENSOR_LOOKUP_TABLE)
+        if (this->sensor_table.valid) {
+          this->current_temperature = this->sensor_table.getTemperature(this->data.sensor.raw);
+          return;
+        }
+      #endif
+      this->current_temperature = this->data.sensor.getTemperature();
+    }
     FORCE_INLINE float deg_current()  { return this->current_temperature; }
     FORCE_INLINE int16_t deg_target() { return this->target_temperature;  }
     FORCE_INLINE int16_t deg_idle()   { return this->idle_temperature;    }
@@ -73,31 +73,8 @@ typedef struct {
           return (raw * float(AD595_MAX) / float(AD_RANGE)) * ad595_gain + ad595_offset;
       #endif
 
-      if (WITHIN(type, 1, 9)) {
-        const int32_t averagedVssaReading = 2 * adcLowOffset,
-                      averagedVrefReading = AD_RANGE + 2 * adcHighOffset;
-
-        // Calculate the resistance
-        const float denom = (float)(averagedVrefReading - raw) - 0.5;
-        if (denom <= 0.0) return ABS_ZERO;
-
-        const float resistance = pullup_res * ((float)(raw - averagedVssaReading) + 0.5) / denom;
-        const float logResistance = LOG(resistance);
-        const float recipT = shA + shB * logResistance + shC * logResistance * logResistance * logResistance;
-
-        /*
-        SERIAL_MV("Debug denom:", denom, 5);
-        SERIAL_MV(" resistance:", resistance, 5);
-        SERIAL_MV(" logResistance:", logResistance, 5);
-        SERIAL_MV(" shA:", shA, 5);
-        SERIAL_MV(" shB:", shB, 5);
-        SERIAL_MV(" shC:", shC, 5);
-        SERIAL_MV(" recipT:", recipT, 5);
-        SERIAL_EOL();
-        */
-
-        return (recipT > 0.0) ? (1.0 / recipT) + (ABS_ZERO) : 2000.0;
-      }
+      if (WITHIN(type, 1, 9))
+        return thermistor_temperature(raw);
 
       #if HAS_DHT
         if (type == 11)
@@ -105,36 +82,88 @@ typedef struct {
       #endif
 
       #if HAS_AMPLIFIER
+        if (type == 20)
+          return amplifier_temperature(raw);
+      #endif
+
+      if (type == 998) return DUMMY_THERMISTOR_998_VALUE;
+      if (type == 999) return DUMMY_THERMISTOR_999_VALUE;
+
+      return 25;
+    }
+
+    /**
+     * Sensors converted from the adc value alone,
+     * the ones a lookup table can be built for
+     */
+    bool is_adc_sensor() {
+      return WITHIN(type, 1, 9)
+        #if HAS_AMPLIFIER
+          || type == 20
+        #endif
+      ;
+    }
+
+    float adc_temperature(const int16_t adc) {
+      #if HAS_AMPLIFIER
+        if (type == 20) return amplifier_temperature(adc);
+      #endif
+      return thermistor_temperature(adc);
+    }
+
+    float thermistor_temperature(const int16_t adc) {
+
+      const int32_t averagedVssaReading = 2 * adcLowOffset,
+                    averagedVrefReading = AD_RANGE + 2 * adcHighOffset;
+
+      // Calculate the resistance
+      const float denom = (float)(averagedVrefReading - adc) - 0.5;
+      if (denom <= 0.0) return ABS_ZERO;
+
+      const float resistance = pullup_res * ((float)(adc - averagedVssaReading) + 0.5) / denom;
+      const float logResistance = LOG(resistance);
+      const float recipT = shA + shB * logResistance + shC * logResistance * logResistance * logResistance;
+
+      /*
+      SERIAL_MV("Debug denom:", denom, 5);
+      SERIAL_MV(" resistance:", resistance, 5);
+      SERIAL_MV(" logResistance:", logResistance, 5);
+      SERIAL_MV(" shA:", shA, 5);
+      SERIAL_MV(" shB:", shB, 5);
+      SERIAL_MV(" shC:", shC, 5);
+      SERIAL_MV(" recipT:", recipT, 5);
+      SERIAL_EOL();
+      */
+
+      return (recipT > 0.0) ? (1.0 / recipT) + (ABS_ZERO) : 2000.0;
+    }
+
+    #if HAS_AMPLIFIER
+
+      float amplifier_temperature(const int16_t adc) {
 
         #define PGM_RD_W(x) (short)pgm_read_word(&x)
         static uint8_t  ttbllen_map = COUNT(temptable_amplifier);
         float celsius = 0;
         uint8_t i;
 
-        if (type == 20) {
-          for (i = 1; i < ttbllen_map; i++) {
-            if (PGM_RD_W(temptable_amplifier[i][0]) > raw) {
-              celsius = PGM_RD_W(temptable_amplifier[i - 1][1]) +
-                        (raw - PGM_RD_W(temptable_amplifier[i - 1][0])) *
-                        (float)(PGM_RD_W(temptable_amplifier[i][1]) - PGM_RD_W(temptable_amplifier[i - 1][1])) /
-                        (float)(PGM_RD_W(temptable_amplifier[i][0]) - PGM_RD_W(temptable_amplifier[i - 1][0]));
-              break;
-            }
+        for (i = 1; i < ttbllen_map; i++) {
+          if (PGM_RD_W(temptable_amplifier[i][0]) > adc) {
+            celsius = PGM_RD_W(temptable_amplifier[i - 1][1]) +
+                      (adc - PGM_RD_W(temptable_amplifier[i - 1][0])) *
+                      (float)(PGM_RD_W(temptable_amplifier[i][1]) - PGM_RD_W(temptable_amplifier[i - 1][1])) /
+                      (float)(PGM_RD_W(temptable_amplifier[i][0]) - PGM_RD_W(temptable_amplifier[i - 1][0]));
+            break;
           }
-
-          // Overflow: Set to last value in the table
-          if (i == ttbllen_map) celsius = PGM_RD_W(temptable_amplifier[i - 1][1]);
-
-          return celsius;
         }
 
-      #endif // HAS_AMPLIFIER
+        // Overflow: Set to last value in the table
+        if (i == ttbllen_map) celsius = PGM_RD_W(temptable_amplifier[i - 1][1]);
 
-      if (type == 998) return DUMMY_THERMISTOR_998_VALUE;
-      if (type == 999) return DUMMY_THERMISTOR_999_VALUE;
+        return celsius;
+      }
 
-      return 25;
-    }
+    #endif // HAS_AMPLIFIER
 
     bool set_pullup_res(const float value) {
       if (!WITHIN(value, 1, 1000000)) return false;
@@ -289,3 +318,84 @@ typedef struct {
     #endif // HAS_MAX6675
 
 } sensor_data_t;
+
+#if ENABLED(SENSOR_LOOKUP_TABLE)
+
+  /**
+   * Lookup table adc -> temperature of a sensor.
+   *
+   * The nodes are spaced by octaves of the adc range from both ends,
+   * SENSOR_TABLE_DIV nodes every octave, so they are dense where the
+   * thermistor curve is steep (hot end of the range and open sensor end)
+   * and a temperature is read with one index and one interpolation:
+   *   adc   0 1 .. 7 8 10 .. 14 16 20 .. 28 32 .. AD_RANGE/2 .. AD_RANGE-8 .. AD_RANGE
+   */
+  #define SENSOR_TABLE_DIV_BITS 3
+  #define SENSOR_TABLE_DIV      (1 << (SENSOR_TABLE_DIV_BITS))
+
+  constexpr uint8_t sensor_table_log2(const uint32_t v) { return v > 1 ? 1 + sensor_table_log2(v >> 1) : 0; }
+
+  constexpr uint16_t  SENSOR_TABLE_HALF   = SENSOR_TABLE_DIV * (sensor_table_log2(AD_RANGE) - (SENSOR_TABLE_DIV_BITS)),
+                      SENSOR_TABLE_NODES  = 2 * SENSOR_TABLE_HALF + 1;
+
+  static_assert((AD_RANGE & (AD_RANGE - 1)) == 0, "SENSOR_LOOKUP_TABLE needs a power of 2 AD_RANGE.");
+  static_assert(SENSOR_TABLE_NODES <= 255, "SENSOR_LOOKUP_TABLE is too big for the AD_RANGE.");
+
+  typedef struct {
+
+    public: /** Public Parameters */
+
+      bool    valid;
+      int16_t celsius[SENSOR_TABLE_NODES];  // Temperature of every node in 1/16 °C
+
+    public: /** Public Function */
+
+      /**
+       * Calculate the table of the sensor, call it when the sensor parameters change
+       */
+      void build(sensor_data_t &sensor) {
+        valid = false;
+        if (!sensor.is_adc_sensor()) return;
+        for (uint8_t k = 0; k < SENSOR_TABLE_NODES; k++) {
+          const float t = sensor.adc_temperature(node_adc(k));
+          celsius[k] = LROUND(constrain(t, -273.0f, 2000.0f) * 16.0f);
+        }
+        valid = true;
+      }
+
+      float getTemperature(const int16_t raw) {
+        const int32_t adc = constrain(raw, 0, AD_RANGE);
+        uint8_t k, shift;
+        if (adc <= AD_RANGE / 2)
+          k = node(adc, shift);
+        else {
+          k = 2 * SENSOR_TABLE_HALF - node(AD_RANGE - adc, shift);
+          if (node_adc(k) > adc) k--;
+        }
+        if (k == SENSOR_TABLE_NODES - 1) return celsius[k] * 0.0625f;
+        const int32_t c0 = celsius[k];
+        return (c0 + (((celsius[k + 1] - c0) * (adc - node_adc(k))) >> shift)) * 0.0625f;
+      }
+
+    private: /** Private Function */
+
+      // Adc value of node k of the lower half
+      static uint16_t half_adc(const uint8_t k) {
+        return k < SENSOR_TABLE_DIV ? k : (SENSOR_TABLE_DIV + (k & (SENSOR_TABLE_DIV - 1))) << ((k >> (SENSOR_TABLE_DIV_BITS)) - 1);
+      }
+
+      static int32_t node_adc(const uint8_t k) {
+        return k <= SENSOR_TABLE_HALF ? half_adc(k) : AD_RANGE - half_adc(2 * SENSOR_TABLE_HALF - k);
+      }
+
+      // Lower half node at or below adc, shift is the log2 of its spacing
+      static uint8_t node(const uint16_t adc, uint8_t &shift) {
+        shift = 0;
+        if (adc < SENSOR_TABLE_DIV) return adc;
+        for (uint16_t x = adc >> (SENSOR_TABLE_DIV_BITS); x > 1; x >>= 1) shift++;
+        return SENSOR_TABLE_DIV * shift + (adc >> shift);
+      }
+
+  } sensor_table_t;
+
+#endif // ENABLED(SENSOR_LOOKUP_TABLE)
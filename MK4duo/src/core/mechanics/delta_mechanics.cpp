@@ -211,18 +211,86 @@ void Delta_Mechanics::get_cartesian_from_steppers() {
     float raw[XYZE];
     COPY_ARRAY(raw, current_position);
 
-    // Calculate and execute the segments
-    while (--numLines) {
+    #if DELTA_SEGMENT_BATCH > 1
+
+      /**
+       * The lines are calculated in batches. The axis positions are exact at
+       * the start, middle and end of a batch and follow the quadratic through
+       * them in between, stepped with forward differences. The error of the
+       * quadratic is checked against the exact position at one and three
+       * quarters of the batch, close to where it is largest in each half,
+       * and a batch out of tolerance is calculated exactly line by line.
+       */
+      float abce[ABCE];
+      get_abce(raw, abce);
+
+      bool buffered = true;
+      while (buffered && numLines > 1) {
+
+        static millis_s next_idle_ms = 0;
+        if (expired(&next_idle_ms, 200U)) printer.idle();
+
+        const uint8_t batch = MIN(numLines - 1, DELTA_SEGMENT_BATCH);
+        numLines -= batch;
+
+        float abce_end[ABCE], d1[ABCE], d2[ABCE];
+        bool exact = batch < 4;
+
+        if (!exact) {
+          float point[XYZE], abce_mid[ABCE], abce_quarter[ABCE], abce_3quarter[ABCE];
+          LOOP_XYZE(i) point[i] = raw[i] + segment_distance[i] * (batch * 0.5f);
+          get_abce(point, abce_mid);
+          LOOP_XYZE(i) point[i] = raw[i] + segment_distance[i] * (batch * 0.25f);
+          get_abce(point, abce_quarter);
+          LOOP_XYZE(i) point[i] = raw[i] + segment_distance[i] * (batch * 0.75f);
+          get_abce(point, abce_3quarter);
+          LOOP_XYZE(i) point[i] = raw[i] + segment_distance[i] * batch;
+          get_abce(point, abce_end);
+
+          const float du = 1.0f / batch;
+          LOOP_ABCE(i) {
+            const float b = 4.0f * abce_mid[i] - 3.0f * abce[i] - abce_end[i],
+                        c = 2.0f * (abce[i] + abce_end[i]) - 4.0f * abce_mid[i];
+            if (ABS(abce[i] + 0.25f * b + 0.0625f * c - abce_quarter[i]) > DELTA_SEGMENT_TOLERANCE
+              || ABS(abce[i] + 0.75f * b + 0.5625f * c - abce_3quarter[i]) > DELTA_SEGMENT_TOLERANCE
+            ) exact = true;
+            d1[i] = (b + c * du) * du;
+            d2[i] = 2.0f * c * sq(du);
+          }
+        }
 
-      static millis_s next_idle_ms = 0;
-      if (expired(&next_idle_ms, 200U)) printer.idle();
+        for (uint8_t s = 0; s < batch; s++) {
+          LOOP_XYZE(i) raw[i] += segment_distance[i];
+          if (exact)
+            get_abce(raw, abce);
+          else if (s == batch - 1)
+            COPY_ARRAY(abce, abce_end);
+          else LOOP_ABCE(i) {
+            abce[i] += d1[i];
+            d1[i] += d2[i];
+          }
+          if (!(buffered = planner.buffer_kinematic_segment(abce, raw, _feedrate_mm_s, tools.extruder.active, cartesian_segment_mm)))
+            break;
+        }
 
-      LOOP_XYZE(i) raw[i] += segment_distance[i];
+      }
 
-      if (!planner.buffer_line(raw, _feedrate_mm_s, tools.extruder.active, cartesian_segment_mm))
-        break;
+    #else
 
-    }
+      // Calculate and execute the segments
+      while (--numLines) {
+
+        static millis_s next_idle_ms = 0;
+        if (expired(&next_idle_ms, 200U)) printer.idle();
+
+        LOOP_XYZE(i) raw[i] += segment_distance[i];
+
+        if (!planner.buffer_line(raw, _feedrate_mm_s, tools.extruder.active, cartesian_segment_mm))
+          break;
+
+      }
+
+    #endif
 
     planner.buffer_line(destination, _feedrate_mm_s, tools.extruder.active, cartesian_segment_mm);
 
@@ -232,6 +300,23 @@ void Delta_Mechanics::get_cartesian_from_steppers() {
 
 #endif // DISABLED(AUTO_BED_LEVELING_UBL)
 
+#if DISABLED(AUTO_BED_LEVELING_UBL) && DELTA_SEGMENT_BATCH > 1
+
+  void Delta_Mechanics::get_abce(const float (&raw)[XYZE], float (&abce)[ABCE]) {
+    float pos[XYZE];
+    COPY_ARRAY(pos, raw);
+    #if HAS_POSITION_MODIFIERS
+      planner.apply_modifiers(pos);
+    #endif
+    Transform(pos);
+    abce[A_AXIS] = delta[A_AXIS];
+    abce[B_AXIS] = delta[B_AXIS];
+    abce[C_AXIS] = delta[C_AXIS];
+    abce[E_AXIS] = pos[E_AXIS];
+  }
+
+#endif
+
 /**
  *  Plan a move to (X, Y, Z) and set the current_position
  *  The final current_position may not be the one that was requested
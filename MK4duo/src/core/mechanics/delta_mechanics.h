@@ -194,6 +194,13 @@ class Delta_Mechanics : public Mechanics {
      */
     static void Set_clip_start_height();
 
+    #if DISABLED(AUTO_BED_LEVELING_UBL) && DELTA_SEGMENT_BATCH > 1
+      /**
+       * Axis positions of a cartesian point, with the planner modifiers applied
+       */
+      static void get_abce(const float (&raw)[XYZE], float (&abce)[ABCE]);
+    #endif
+
     #if ENABLED(DELTA_FAST_SQRT) && ENABLED(__AVR__)
       static float Q_rsqrt(float number);
     #endif
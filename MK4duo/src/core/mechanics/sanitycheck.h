@@ -250,6 +250,12 @@
 #if DISABLED(N_ARC_CORRECTION)
   #error "DEPENDENCY ERROR: Missing setting N_ARC_CORRECTION."
 #endif
+#if ENABLED(ARC_SUPPORT) && ARC_SEGMENT_BATCH > BLOCK_BUFFER_SIZE / 4
+  #error "DEPENDENCY ERROR: ARC_SEGMENT_BATCH must be at most BLOCK_BUFFER_SIZE / 4."
+#endif
+#if ENABLED(AUTO_BED_LEVELING_UBL) && UBL_SEGMENT_BATCH > BLOCK_BUFFER_SIZE / 4
+  #error "DEPENDENCY ERROR: UBL_SEGMENT_BATCH must be at most BLOCK_BUFFER_SIZE / 4."
+#endif
 #if DISABLED(DEFAULT_AXIS_STEPS_PER_UNIT)
   #error "DEPENDENCY ERROR: Missing setting DEFAULT_AXIS_STEPS_PER_UNIT."
 #endif
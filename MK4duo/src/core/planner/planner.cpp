@@ -90,6 +90,32 @@ uint8_t Planner::delay_before_delivering = 0;
   bool  Planner::autotemp_enabled = false;
 #endif
 
+#if ENABLED(COLOR_MIXING_EXTRUDER)
+  mixer_color_t Planner::color_pool[MIXING_COLOR_SLOTS][MIXING_STEPPERS] = { { 0 } };
+  uint8_t       Planner::color_head = 0;
+#endif
+
+#if ENABLED(LASER_RASTER)
+  unsigned char Planner::raster_pool[LASER_RASTER_LINES][LASER_MAX_RASTER_LINE] = { { 0 } };
+  uint8_t       Planner::raster_head = 0;
+#endif
+
+#if ENABLED(PLANNER_BENCHMARK)
+  planner_bench_t Planner::bench[BENCH_COUNT] = { { 0 } };
+  #if ENABLED(PLANNER_FIXED_POINT)
+    planner_fixed_check_t Planner::fixed_check = { 0, 0, 0 };
+  #endif
+  // Each phase has its own start time, the phases can nest
+  #define BENCH_START(P)  const uint64_t P##_start_ns = HAL_real_ns()
+  #define BENCH_END(P)    bench_add(P, P##_start_ns)
+#else
+  #define BENCH_START(P)  NOOP
+  #define BENCH_END(P)    NOOP
+#endif
+
+uint8_t Planner::batch_size  = 0,
+        Planner::batch_count = 0;
+
 int32_t Planner::position[NUM_AXIS] = { 0 };
 
 uint32_t Planner::cutoff_long = 0;
@@ -921,12 +947,15 @@ bool Planner::buffer_steps(const int32_t (&target)[XYZE]
   // If we are cleaning, do not accept queuing of movements
   if (cleaning_buffer_flag) return false;
 
-  // Wait for the next available block
+  // Wait for the next available block and its side pool entries
   uint8_t next_buffer_head;
-  block_t * const block = get_next_free_block(next_buffer_head);
+  block_t * const block = get_next_free_block(next_buffer_head, 1, true);
+
+  BENCH_START(BENCH_BUFFER_STEPS);
+  BENCH_START(BENCH_FILL_BLOCK);
 
   // Fill the block with the specified movement
-  if (!fill_block(block, false, target
+  const bool filled = fill_block(block, false, target
     #if HAS_POSITION_FLOAT
       , target_float
     #endif
@@ -934,7 +963,11 @@ bool Planner::buffer_steps(const int32_t (&target)[XYZE]
       , delta_mm_cart
     #endif
     , fr_mm_s, extruder, millimeters
-  )) {
+  );
+
+  BENCH_END(BENCH_FILL_BLOCK);
+
+  if (!filled) {
     // Movement was not queued, probably because it was too short.
     // Simply accept that as movement queued and done
     return true;
@@ -953,8 +986,14 @@ bool Planner::buffer_steps(const int32_t (&target)[XYZE]
   // Move buffer head
   block_buffer_head = next_buffer_head;
 
-  // Recalculate and optimize trapezoidal speed profiles
-  recalculate();
+  // Recalculate and optimize trapezoidal speed profiles.
+  // In a batch only once per batch, but always if the stepper could run out of blocks.
+  if (++batch_count >= batch_size || moves_planned() < (BLOCK_BUFFER_SIZE) / 2) {
+    batch_count = 0;
+    recalculate();
+  }
+
+  BENCH_END(BENCH_BUFFER_STEPS);
 
   // Movement successfully queued!
   return true;
@@ -1167,7 +1206,16 @@ bool Planner::fill_block(block_t * const block, bool split_move,
 
   // For a mixing extruder, get a magnified step_event_count for each
   #if ENABLED(COLOR_MIXING_EXTRUDER)
-    mixer.populate_block(block->b_color);
+    {
+      // Blocks of the same color share the entry of the color pool
+      mixer_color_t b_color[MIXING_STEPPERS];
+      mixer.populate_block(b_color);
+      if (memcmp(b_color, color_pool[color_head], sizeof(b_color))) {
+        if (++color_head == MIXING_COLOR_SLOTS) color_head = 0;
+        COPY_ARRAY(color_pool[color_head], b_color);
+      }
+      block->color_index = color_head;
+    }
   #endif
 
   #if ENABLED(BARICUDA)
@@ -1401,6 +1449,9 @@ bool Planner::fill_block(block_t * const block, bool split_move,
     block->laser_duration   = laser.duration;
     block->laser_status     = laser.status;
     block->laser_mode       = laser.mode;
+    #if ENABLED(LASER_RASTER)
+      block->raster_index   = LASER_RASTER_LINES; // No raster line
+    #endif
 
     // When operating in PULSED or RASTER modes, laser pulsing must operate in sync with movement.
     // Calculate steps between laser firings (steps_l) and consider that when determining largest
@@ -1408,23 +1459,30 @@ bool Planner::fill_block(block_t * const block, bool split_move,
     if (laser.mode == RASTER || laser.mode == PULSED) {
       block->steps_l = ABS(block->millimeters * laser.ppm);
       #if ENABLED(LASER_RASTER)
-        for (uint8_t i = 0; i < LASER_MAX_RASTER_LINE; i++) {
-          // Scale the image intensity based on the raster power.
-          // 100% power on a pixel basis is 255, convert back to 255 = 100.
-          #if ENABLED(LASER_REMAP_INTENSITY)
-            const int NewRange = (laser.rasterlaserpower * 255.0 / 100.0 - LASER_REMAP_INTENSITY);
-            float     NewValue = (float)(((((float)laser.raster_data[i] - 0) * NewRange) / 255.0) + LASER_REMAP_INTENSITY);
-          #else
-            const int NewRange = (laser.rasterlaserpower * 255.0 / 100.0);
-            float     NewValue = (float)(((((float)laser.raster_data[i] - 0) * NewRange) / 255.0));
-          #endif
+        if (laser.mode == RASTER) {
+          // Raster lines take the entries of the raster pool in turn,
+          // get_next_free_block has waited for this one to be free
+          block->raster_index = raster_head;
+          if (++raster_head == LASER_RASTER_LINES) raster_head = 0;
+          unsigned char * const raster_data = raster_pool[block->raster_index];
+          for (uint8_t i = 0; i < LASER_MAX_RASTER_LINE; i++) {
+            // Scale the image intensity based on the raster power.
+            // 100% power on a pixel basis is 255, convert back to 255 = 100.
+            #if ENABLED(LASER_REMAP_INTENSITY)
+              const int NewRange = (laser.rasterlaserpower * 255.0 / 100.0 - LASER_REMAP_INTENSITY);
+              float     NewValue = (float)(((((float)laser.raster_data[i] - 0) * NewRange) / 255.0) + LASER_REMAP_INTENSITY);
+            #else
+              const int NewRange = (laser.rasterlaserpower * 255.0 / 100.0);
+              float     NewValue = (float)(((((float)laser.raster_data[i] - 0) * NewRange) / 255.0));
+            #endif
 
-          #if ENABLED(LASER_REMAP_INTENSITY)
-            // If less than 7%, turn off the laser tube.
-            if (NewValue <= LASER_REMAP_INTENSITY) NewValue = 0;
-          #endif
+            #if ENABLED(LASER_REMAP_INTENSITY)
+              // If less than 7%, turn off the laser tube.
+              if (NewValue <= LASER_REMAP_INTENSITY) NewValue = 0;
+            #endif
 
-          block->laser_raster_data[i] = NewValue;
+            raster_data[i] = NewValue;
+          }
         }
       #endif
     }
@@ -1670,6 +1728,17 @@ bool Planner::fill_block(block_t * const block, bool split_move,
   }
   block->acceleration_steps_per_s2 = accel;
   block->acceleration = accel / steps_per_mm;
+  #if ENABLED(PLANNER_FIXED_POINT)
+    if (accel) {
+      // accel = mantissa * 2^exp, mantissa in [0.5, 1): the inverse keeps 31 significant bits
+      int exp;
+      const float mantissa = frexpf(accel, &exp);
+      block->acceleration_inverse = 1073741824.0f / mantissa; // 2^30
+      block->acceleration_shift = exp - 1;
+    }
+    else
+      block->acceleration_inverse = block->acceleration_shift = 0;
+  #endif
   #if DISABLED(BEZIER_JERK_CONTROL)
     block->acceleration_rate = (uint32_t)(accel * (4096.0f * 4096.0f / (HAL_TIMER_RATE)));
   #endif
@@ -1896,6 +1965,18 @@ bool Planner::fill_block(block_t * const block, bool split_move,
 
 } // fill_block()
 
+/**
+ * Planner::end_batch
+ * Stop the batch, recalculate the blocks it queued
+ */
+void Planner::end_batch() {
+  batch_size = 0;
+  if (batch_count) {
+    batch_count = 0;
+    recalculate();
+  }
+}
+
 /**
  * Planner::buffer_sync_block
  * Add a block to the buffer that just updates the position
@@ -2035,7 +2116,11 @@ bool Planner::buffer_segment(const float &a, const float &b, const float &c, con
  *  millimeters  - the length of the movement, if known
  *  inv_duration - the reciprocal if the duration of the movement, if known (kinematic only if feeedrate scaling is enabled)
  */
-bool Planner::buffer_line(const float &rx, const float &ry, const float &rz, const float &e, const float &fr_mm_s, const uint8_t extruder, const float millimeters/*=0.0*/) {
+bool Planner::buffer_line(const float &rx, const float &ry, const float &rz, const float &e, const float &fr_mm_s, const uint8_t extruder, const float millimeters/*=0.0*/
+  #if ENABLED(SCARA_FEEDRATE_SCALING)
+    , const float &inv_duration/*=0.0*/
+  #endif
+) {
 
   float raw[XYZE] = { rx, ry, rz, e };
   #if HAS_POSITION_MODIFIERS
@@ -2044,12 +2129,39 @@ bool Planner::buffer_line(const float &rx, const float &ry, const float &rz, con
 
   #if IS_KINEMATIC
 
+    mechanics.Transform(raw);
+
+    const float abce[ABCE] = { mechanics.delta[A_AXIS], mechanics.delta[B_AXIS], mechanics.delta[C_AXIS], raw[E_AXIS] },
+                cart[XYZE] = { rx, ry, rz, e };
+
+    return buffer_kinematic_segment(abce, cart, fr_mm_s, extruder, millimeters
+      #if ENABLED(SCARA_FEEDRATE_SCALING)
+        , inv_duration
+      #endif
+    );
+
+  #else
+
+    return buffer_segment(raw, fr_mm_s, extruder, millimeters);
+
+  #endif
+
+}
+
+#if IS_KINEMATIC
+
+  bool Planner::buffer_kinematic_segment(const float (&abce)[ABCE], const float (&cart)[XYZE], const float &fr_mm_s, const uint8_t extruder, const float millimeters/*=0.0*/
+    #if ENABLED(SCARA_FEEDRATE_SCALING)
+      , const float &inv_duration/*=0.0*/
+    #endif
+  ) {
+
     const float delta_mm_cart[] = {
-      rx - position_cart[X_AXIS],
-      ry - position_cart[Y_AXIS],
-      rz - position_cart[Z_AXIS]
+      cart[X_AXIS] - position_cart[X_AXIS],
+      cart[Y_AXIS] - position_cart[Y_AXIS],
+      cart[Z_AXIS] - position_cart[Z_AXIS]
       #if ENABLED(JUNCTION_DEVIATION)
-        , e - position_cart[E_AXIS]
+        , cart[E_AXIS] - position_cart[E_AXIS]
       #endif
     };
 
@@ -2057,39 +2169,27 @@ bool Planner::buffer_line(const float &rx, const float &ry, const float &rz, con
     if (mm == 0.0)
       mm = (delta_mm_cart[X_AXIS] != 0.0 || delta_mm_cart[Y_AXIS] != 0.0) ? SQRT(sq(delta_mm_cart[X_AXIS]) + sq(delta_mm_cart[Y_AXIS]) + sq(delta_mm_cart[Z_AXIS])) : ABS(delta_mm_cart[Z_AXIS]);
 
-    mechanics.Transform(raw);
-
     #if ENABLED(SCARA_FEEDRATE_SCALING)
       // For SCARA scale the feed rate from mm/s to degrees/s
       // i.e., Complete the angular vector in the given time.
       const float duration_recip = inv_duration ? inv_duration : fr_mm_s / mm,
-                  feedrate = HYPOT(delta[A_AXIS] - position_float[A_AXIS], delta[B_AXIS] - position_float[B_AXIS]) * duration_recip;
+                  feedrate = HYPOT(abce[A_AXIS] - position_float[A_AXIS], abce[B_AXIS] - position_float[B_AXIS]) * duration_recip;
     #else
       const float feedrate = fr_mm_s;
     #endif
 
-    if (buffer_segment(mechanics.delta[A_AXIS], mechanics.delta[B_AXIS], mechanics.delta[C_AXIS], raw[E_AXIS]
+    if (!buffer_segment(abce
       #if ENABLED(JUNCTION_DEVIATION)
         , delta_mm_cart
       #endif
       , feedrate, extruder, mm
-    )) {
-      position_cart[X_AXIS] = rx;
-      position_cart[Y_AXIS] = ry;
-      position_cart[Z_AXIS] = rz;
-      position_cart[E_AXIS] = e;
-      return true;
-    }
-    else
-      return false;
-
-  #else
-
-    return buffer_segment(raw, fr_mm_s, extruder, millimeters);
+    )) return false;
 
-  #endif
+    COPY_ARRAY(position_cart, cart);
+    return true;
+  }
 
-}
+#endif // IS_KINEMATIC
 
 /**
  * Directly set the planner ABC position (and stepper positions)
@@ -2219,6 +2319,70 @@ void Planner::refresh_positioning() {
 #endif
 
 /** Private Function */
+#define MINIMAL_STEP_RATE 120
+
+/**
+ * Trapezoid steps with the float math
+ */
+bool Planner::float_trapezoid_steps(const block_t* const block, const uint32_t initial_rate, const uint32_t final_rate, uint32_t &accelerate_steps, int32_t &plateau_steps) {
+
+  const int32_t accel = block->acceleration_steps_per_s2;
+
+  // Steps required for acceleration, deceleration to/from nominal rate
+  accelerate_steps = CEIL(estimate_acceleration_distance(initial_rate, block->nominal_rate, accel));
+  const uint32_t decelerate_steps = FLOOR(estimate_acceleration_distance(block->nominal_rate, final_rate, -accel));
+  // Steps between acceleration and deceleration, if any
+  plateau_steps = block->step_event_count - accelerate_steps - decelerate_steps;
+
+  // Does accelerate_steps + decelerate_steps exceed step_event_count?
+  // Then we can't possibly reach the nominal rate, there will be no cruising.
+  // Use intersection_distance() to calculate accel / braking time in order to
+  // reach the final_rate exactly at the end of this block.
+  if (plateau_steps < 0) {
+    const float accelerate_steps_float = CEIL(intersection_distance(initial_rate, final_rate, accel, block->step_event_count));
+    accelerate_steps = MIN(uint32_t(MAX(accelerate_steps_float, 0)), block->step_event_count);
+    plateau_steps = 0;
+    return false;
+  }
+
+  return true;
+}
+
+#if ENABLED(PLANNER_FIXED_POINT)
+
+  /**
+   * Same as float_trapezoid_steps, with integer rates and the inverse
+   * of the acceleration computed by fill_block: no division at all.
+   * Steps are rounded like the float math, give or take one step.
+   */
+  bool Planner::fixed_trapezoid_steps(const block_t* const block, const uint32_t initial_rate, const uint32_t final_rate, uint32_t &accelerate_steps, int32_t &plateau_steps) {
+
+    const uint32_t nominal_rate = block->nominal_rate;
+
+    accelerate_steps = fixed_acceleration_distance(initial_rate, nominal_rate, block);
+    if (accelerate_steps) accelerate_steps++; // Round up
+    const uint32_t decelerate_steps = fixed_acceleration_distance(final_rate, nominal_rate, block);
+    plateau_steps = block->step_event_count - accelerate_steps - decelerate_steps;
+
+    if (plateau_steps < 0) {
+      // Half of the block, moved by half the distance between initial and final rate
+      const uint32_t count = block->step_event_count;
+      if (final_rate >= initial_rate)
+        accelerate_steps = (count + fixed_acceleration_distance(initial_rate, final_rate, block) + 1) >> 1;
+      else {
+        const uint32_t distance = fixed_acceleration_distance(final_rate, initial_rate, block);
+        accelerate_steps = count > distance ? (count - distance + 1) >> 1 : 0;
+      }
+      NOMORE(accelerate_steps, count);
+      plateau_steps = 0;
+      return false;
+    }
+
+    return true;
+  }
+
+#endif // ENABLED(PLANNER_FIXED_POINT)
+
 /**
  * Calculate trapezoid parameters, multiplying the entry- and exit-speeds
  * by the provided factors.
@@ -2229,8 +2393,6 @@ void Planner::refresh_positioning() {
  * is not and will not use the block while we modify it, so it is safe to
  * alter it's values.
  */
-#define MINIMAL_STEP_RATE 120
-
 void Planner::calculate_trapezoid_for_block(block_t* const block, const float &entry_factor, const float &exit_factor) {
 
   uint32_t initial_rate = CEIL(entry_factor * block->nominal_rate),
@@ -2240,38 +2402,39 @@ void Planner::calculate_trapezoid_for_block(block_t* const block, const float &e
   NOLESS(initial_rate,  uint32_t(MINIMAL_STEP_RATE));
   NOLESS(final_rate,    uint32_t(MINIMAL_STEP_RATE));
 
-  #if ENABLED(BEZIER_JERK_CONTROL)
-    uint32_t cruise_rate = initial_rate;
-  #endif
+  uint32_t  accelerate_steps;
+  int32_t   plateau_steps;
+
+  #if ENABLED(PLANNER_FIXED_POINT)
+
+    const bool cruising = fixed_trapezoid_steps(block, initial_rate, final_rate, accelerate_steps, plateau_steps);
+
+    #if ENABLED(PLANNER_BENCHMARK)
+      // Check the fixed point trapezoid against the float one
+      uint32_t  float_accelerate_steps;
+      int32_t   float_plateau_steps;
+      float_trapezoid_steps(block, initial_rate, final_rate, float_accelerate_steps, float_plateau_steps);
+      // The stepper runs the same past the end of the block: with an exit rate above
+      // the nominal rate the float math sets decelerate_after beyond step_event_count
+      const uint32_t  count = block->step_event_count,
+                      error_until = ABS(int32_t(MIN(accelerate_steps, count) - MIN(float_accelerate_steps, count))),
+                      error_after = ABS(int32_t(MIN(accelerate_steps + plateau_steps, count) - MIN(float_accelerate_steps + float_plateau_steps, count)));
+      fixed_check.count++;
+      if (error_until || error_after) fixed_check.differ++;
+      NOLESS(fixed_check.max_steps, MAX(error_until, error_after));
+    #endif
 
-  const int32_t accel = block->acceleration_steps_per_s2;
+  #else
+    const bool cruising = float_trapezoid_steps(block, initial_rate, final_rate, accelerate_steps, plateau_steps);
+  #endif
 
-            // Steps required for acceleration, deceleration to/from nominal rate
-  uint32_t  accelerate_steps = CEIL(estimate_acceleration_distance(initial_rate, block->nominal_rate, accel)),
-            decelerate_steps = FLOOR(estimate_acceleration_distance(block->nominal_rate, final_rate, -accel));
-            // Steps between acceleration and deceleration, if any
-  int32_t   plateau_steps = block->step_event_count - accelerate_steps - decelerate_steps;
+  #if ENABLED(BEZIER_JERK_CONTROL)
 
-  // Does accelerate_steps + decelerate_steps exceed step_event_count?
-  // Then we can't possibly reach the nominal rate, there will be no cruising.
-  // Use intersection_distance() to calculate accel / braking time in order to
-  // reach the final_rate exactly at the end of this block.
-  if (plateau_steps < 0) {
-    const float accelerate_steps_float = CEIL(intersection_distance(initial_rate, final_rate, accel, block->step_event_count));
-    accelerate_steps = MIN(uint32_t(MAX(accelerate_steps_float, 0)), block->step_event_count);
-    plateau_steps = 0;
+    const int32_t accel = block->acceleration_steps_per_s2;
 
-    #if ENABLED(BEZIER_JERK_CONTROL)
-      // We won't reach the cruising rate. Let's calculate the speed we will reach
-      cruise_rate = final_speed(initial_rate, accel, accelerate_steps);
-    #endif
-  }
-  #if ENABLED(BEZIER_JERK_CONTROL)
-    else // We have some plateau time, so the cruise rate will be the nominal rate
-      cruise_rate = block->nominal_rate;
-  #endif
+    // We won't reach the cruising rate without plateau. Let's calculate the speed we will reach
+    const uint32_t cruise_rate = cruising ? block->nominal_rate : final_speed(initial_rate, accel, accelerate_steps);
 
-  #if ENABLED(BEZIER_JERK_CONTROL)
     // Jerk controlled speed requires to express speed versus time, NOT steps
     uint32_t  acceleration_time = ((float)(cruise_rate - initial_rate) / accel) * (STEPPER_TIMER_RATE),
               deceleration_time = ((float)(cruise_rate - final_rate) / accel) * (STEPPER_TIMER_RATE);
@@ -2279,6 +2442,9 @@ void Planner::calculate_trapezoid_for_block(block_t* const block, const float &e
     // And to offload calculations from the ISR, we also calculate the inverse of those times here
     uint32_t  acceleration_time_inverse = get_period_inverse(acceleration_time),
               deceleration_time_inverse = get_period_inverse(deceleration_time);
+
+  #else
+    UNUSED(cruising);
   #endif
 
   // Store new block parameters
@@ -2667,14 +2833,55 @@ void Planner::recalculate_trapezoids() {
 }
 
 void Planner::recalculate() {
+
+  BENCH_START(BENCH_RECALCULATE);
+
   // Initialize block index to the last block in the planner buffer.
   const uint8_t block_index = prev_block_index(block_buffer_head);
 
   // If there is just one block, no planning can be done. Avoid it!
   if (block_index != block_buffer_planned) {
+    BENCH_START(BENCH_REVERSE_PASS);
     reverse_pass();
+    BENCH_END(BENCH_REVERSE_PASS);
+    BENCH_START(BENCH_FORWARD_PASS);
     forward_pass();
+    BENCH_END(BENCH_FORWARD_PASS);
   }
 
+  BENCH_START(BENCH_TRAPEZOIDS);
   recalculate_trapezoids();
+  BENCH_END(BENCH_TRAPEZOIDS);
+
+  BENCH_END(BENCH_RECALCULATE);
 }
+
+bool Planner::pool_entries_free() {
+  #if ENABLED(COLOR_MIXING_EXTRUDER)
+    {
+      // A new color takes the next entry of the color pool
+      mixer_color_t b_color[MIXING_STEPPERS];
+      mixer.populate_block(b_color);
+      if (memcmp(b_color, color_pool[color_head], sizeof(b_color))
+        && pool_entry_used<&block_t::color_index>(color_head + 1 < MIXING_COLOR_SLOTS ? color_head + 1 : 0)
+      ) return false;
+    }
+  #endif
+  #if ENABLED(LASER_RASTER)
+    // A raster move takes the next entry of the raster pool
+    if (laser.mode == RASTER && pool_entry_used<&block_t::raster_index>(raster_head)) return false;
+  #endif
+  return true;
+}
+
+#if ENABLED(PLANNER_BENCHMARK)
+
+  void Planner::bench_add(const PlannerBenchEnum phase, const uint64_t start_ns) {
+    const uint32_t elapsed = uint32_t(HAL_real_ns() - start_ns);
+    planner_bench_t &b = bench[phase];
+    b.count++;
+    b.total_ns += elapsed;
+    NOLESS(b.max_ns, elapsed);
+  }
+
+#endif // ENABLED(PLANNER_BENCHMARK)
@@ -43,12 +43,20 @@ typedef struct block_t {
 
   volatile uint8_t flag;                    // Block flags (See BlockFlagEnum enum above) - Modified by ISR and main thread!
 
-  // Fields used by the motion planner to manage acceleration
-  float nominal_speed_sqr,                  // The nominal speed for this block in (mm/sec)^2
-        entry_speed_sqr,                    // Entry speed at previous-current junction in (mm/sec)^2
-        max_entry_speed_sqr,                // Maximum allowable junction entry speed in (mm/sec)^2
-        millimeters,                        // The total travel of this block in mm
-        acceleration;                       // acceleration mm/sec^2
+  /**
+   * Fields used by the Stepper ISR, packed at the head of the block
+   */
+  uint8_t direction_bits;                   // The direction bit set for this block
+
+  #if EXTRUDERS > 1
+    uint8_t active_extruder;                // The extruder to move (if E move)
+  #else
+    static constexpr uint8_t active_extruder = 0;
+  #endif
+
+  #if ENABLED(COLOR_MIXING_EXTRUDER)
+    uint8_t color_index;                    // Normalized color for the mixing steppers, in Planner::color_pool
+  #endif
 
   // Data used by all move blocks
   union {
@@ -60,20 +68,14 @@ typedef struct block_t {
 
   uint32_t step_event_count;                // The number of step events required to complete this block
 
-  #if EXTRUDERS > 1
-    uint8_t active_extruder;                // The extruder to move (if E move)
-  #else
-    static constexpr uint8_t active_extruder = 0;
-  #endif
-
-  #if ENABLED(COLOR_MIXING_EXTRUDER)
-    mixer_color_t b_color[MIXING_STEPPERS]; // Normalized color for the mixing steppers
-  #endif
-
   // Settings for the trapezoid generator
   uint32_t  accelerate_until,               // The index of the step event on which to stop acceleration
             decelerate_after;               // The index of the step event on which to start decelerating
 
+  uint32_t  nominal_rate,                   // The nominal step rate for this block in step_events/sec
+            initial_rate,                   // The jerk-adjusted step rate at start of block
+            final_rate;                     // The minimal rate at exit
+
   #if ENABLED(BEZIER_JERK_CONTROL)
     uint32_t  cruise_rate,                  // The actual cruise rate to use, between end of the acceleration phase and start of deceleration phase
               acceleration_time,            // Acceleration time and deceleration time in STEP timer counts
@@ -84,47 +86,84 @@ typedef struct block_t {
     uint32_t  acceleration_rate;            // The acceleration rate used for acceleration calculation
   #endif
 
-  uint8_t direction_bits;                   // The direction bit set for this block
-
   // Advance extrusion
   #if ENABLED(LIN_ADVANCE)
     bool      use_advance_lead;
     uint16_t  advance_speed,                // STEP timer value for extruder speed offset ISR
               max_adv_steps,                // max. advance steps to get cruising speed pressure (not always nominal_speed!)
               final_adv_steps;              // advance steps due to exit speed
-    float     e_D_ratio;
-  #endif
-
-  uint32_t  nominal_rate,                   // The nominal step rate for this block in step_events/sec
-            initial_rate,                   // The jerk-adjusted step rate at start of block
-            final_rate,                     // The minimal rate at exit
-            acceleration_steps_per_s2;      // acceleration steps/sec^2
-
-  #if ENABLED(BARICUDA)
-    uint8_t valve_pressure, e_to_p_pressure;
-  #endif
-
-  #if HAS_SPI_LCD
-    uint32_t segment_time_us;
   #endif
 
   #if ENABLED(LASER)
     uint8_t   laser_mode;       // CONTINUOUS, PULSED, RASTER
     bool      laser_status;     // LASER_OFF, LASER_ON
+    #if ENABLED(LASER_RASTER)
+      uint8_t raster_index;     // Raster line of this block in Planner::raster_pool
+    #endif
     float     laser_ppm,        // pulses per millimeter, for pulsed and raster firing modes
               laser_intensity;  // Laser firing instensity in clock cycles for the PWM timer
     uint32_t  laser_duration,   // Laser firing duration in microseconds, for pulsed and raster firing modes
               steps_l;          // Step count between firings of the laser, for pulsed firing mode
+  #endif
 
-    #if ENABLED(LASER_RASTER)
-      unsigned char laser_raster_data[LASER_MAX_RASTER_LINE];
-    #endif
+  /**
+   * Fields used only by the planner
+   */
+  float nominal_speed_sqr,                  // The nominal speed for this block in (mm/sec)^2
+        entry_speed_sqr,                    // Entry speed at previous-current junction in (mm/sec)^2
+        max_entry_speed_sqr,                // Maximum allowable junction entry speed in (mm/sec)^2
+        millimeters,                        // The total travel of this block in mm
+        acceleration;                       // acceleration mm/sec^2
+
+  uint32_t  acceleration_steps_per_s2;      // acceleration steps/sec^2
+
+  #if ENABLED(PLANNER_FIXED_POINT)
+    uint32_t  acceleration_inverse;         // 2^(32 + acceleration_shift) / (2 * acceleration_steps_per_s2)
+    uint8_t   acceleration_shift;
+  #endif
+
+  #if ENABLED(LIN_ADVANCE)
+    float     e_D_ratio;
+  #endif
+
+  #if ENABLED(BARICUDA)
+    uint8_t valve_pressure, e_to_p_pressure;
+  #endif
+
+  #if HAS_SPI_LCD
+    uint32_t segment_time_us;
   #endif
 
 } block_t;
 
 #define BLOCK_MOD(n) ((n)&(BLOCK_BUFFER_SIZE-1))
 
+#if ENABLED(PLANNER_BENCHMARK)
+  enum PlannerBenchEnum : uint8_t {
+    BENCH_BUFFER_STEPS,
+    BENCH_FILL_BLOCK,
+    BENCH_RECALCULATE,
+    BENCH_REVERSE_PASS,
+    BENCH_FORWARD_PASS,
+    BENCH_TRAPEZOIDS,
+    BENCH_COUNT
+  };
+
+  typedef struct {
+    uint32_t  count,
+              max_ns;
+    uint64_t  total_ns;
+  } planner_bench_t;
+
+  #if ENABLED(PLANNER_FIXED_POINT)
+    typedef struct {
+      uint32_t  count,                      // Trapezoids checked against the float math
+                differ,                     // Trapezoids with a different result
+                max_steps;                  // Largest difference of accelerate_until / decelerate_after
+    } planner_fixed_check_t;
+  #endif
+#endif
+
 class Planner {
 
   public: /** Constructor */
@@ -171,8 +210,36 @@ class Planner {
       static bool abort_on_endstop_hit;
     #endif
 
+    /**
+     * Side pools for the large and rarely used block payloads.
+     * Entries are given to the blocks in turn, a block keeps only the index.
+     */
+    #if ENABLED(COLOR_MIXING_EXTRUDER)
+      static mixer_color_t color_pool[MIXING_COLOR_SLOTS][MIXING_STEPPERS];
+    #endif
+    #if ENABLED(LASER_RASTER)
+      static unsigned char raster_pool[LASER_RASTER_LINES][LASER_MAX_RASTER_LINE];
+    #endif
+
+    #if ENABLED(PLANNER_BENCHMARK)
+      static planner_bench_t bench[BENCH_COUNT];  // Real time spent per planner phase
+      #if ENABLED(PLANNER_FIXED_POINT)
+        static planner_fixed_check_t fixed_check; // Fixed point trapezoids compared with the float math
+      #endif
+    #endif
+
   private: /** Private Parameters */
 
+    static uint8_t  batch_size,                 // Blocks recalculated together, see begin_batch()
+                    batch_count;                // Blocks queued since the last recalculate
+
+    #if ENABLED(COLOR_MIXING_EXTRUDER)
+      static uint8_t color_head;                // Last entry of color_pool given to a block
+    #endif
+    #if ENABLED(LASER_RASTER)
+      static uint8_t raster_head;               // Next entry of raster_pool
+    #endif
+
     /**
      * The current position of the tool in absolute steps
      * Recalculated if any data.axis_steps_per_mm are changed by gcode
@@ -290,16 +357,25 @@ class Planner {
      */
     FORCE_INLINE static uint8_t moves_free() { return BLOCK_BUFFER_SIZE - 1 - moves_planned(); }
 
+    /**
+     * Queue the next moves in batches of 'size' blocks, recalculated once per batch
+     * while the buffer is at least half full. end_batch() plans what is left.
+     */
+    FORCE_INLINE static void begin_batch(const uint8_t size) { batch_size = size; batch_count = 0; }
+    static void end_batch();
+
     /**
      * Planner::get_next_free_block
      *
      * - Get the next head indices (passed by reference)
      * - Wait for the number of spaces to open up in the planner
+     * - With 'pools' also wait for the side pool entries a move will take,
+     *   so fill_block never waits with the head block half filled
      * - Return the first head block
      */
-    FORCE_INLINE static block_t* get_next_free_block(uint8_t &next_buffer_head, const uint8_t count=1) {
+    FORCE_INLINE static block_t* get_next_free_block(uint8_t &next_buffer_head, const uint8_t count=1, const bool pools=false) {
       // Wait until there are enough slots free
-      while (moves_free() < count) { printer.idle(); }
+      while (moves_free() < count || (pools && !pool_entries_free())) { printer.idle(); }
 
       // Return the first available block
       next_buffer_head = next_block_index(block_buffer_head);
@@ -402,7 +478,11 @@ class Planner {
      *  extruder    - target extruder
      *  millimeters - the length of the movement, if known
      */
-    static bool buffer_line(const float &rx, const float &ry, const float &rz, const float &e, const float &fr_mm_s, const uint8_t extruder, const float millimeters=0.0);
+    static bool buffer_line(const float &rx, const float &ry, const float &rz, const float &e, const float &fr_mm_s, const uint8_t extruder, const float millimeters=0.0
+      #if ENABLED(SCARA_FEEDRATE_SCALING)
+        , const float &inv_duration=0.0
+      #endif
+    );
 
     FORCE_INLINE static bool buffer_line(const float (&cart)[XYZE], const float &fr_mm_s, const uint8_t extruder, const float millimeters=0.0
       #if ENABLED(SCARA_FEEDRATE_SCALING)
@@ -416,6 +496,28 @@ class Planner {
       );
     }
 
+    #if IS_KINEMATIC
+      /**
+       * Planner::buffer_kinematic_segment
+       *
+       * Add a new linear movement to the buffer for a cartesian target
+       * whose axis positions were already computed by the caller.
+       * buffer_line calls it after the kinematic transform.
+       *
+       *  abce         - target positions in axis units, modifiers applied
+       *  cart         - the cartesian target, as given to buffer_line
+       *  fr_mm_s      - (target) speed of the move
+       *  extruder     - target extruder
+       *  millimeters  - the length of the movement, if known
+       *  inv_duration - the reciprocal of the duration of the movement, if known (SCARA feedrate scaling)
+       */
+      static bool buffer_kinematic_segment(const float (&abce)[ABCE], const float (&cart)[XYZE], const float &fr_mm_s, const uint8_t extruder, const float millimeters=0.0
+        #if ENABLED(SCARA_FEEDRATE_SCALING)
+          , const float &inv_duration=0.0
+        #endif
+      );
+    #endif
+
     /**
      * Set the planner.position and individual stepper positions.
      * Used by G92, G28, G29, and other procedures.
@@ -547,6 +649,73 @@ class Planner {
       return NULL;
     }
 
+    #if ENABLED(STEP_TIMELINE)
+
+      /**
+       * The next block for the step generator. NULL if there is none.
+       * This also marks the block as busy: it stays in the buffer until
+       * the Stepper ISR has output the last of its step events.
+       * Called from the main loop, see Stepper::timeline_fill()
+       */
+      static block_t* get_next_block() {
+
+        // Get the number of moves not handed to the step generator so far
+        const uint8_t nr_moves = nonbusy_moves_planned();
+
+        // If there are any moves queued ...
+        if (nr_moves) {
+
+          // The delay of delivery is counted down by the idle Stepper ISR
+          if (delay_before_delivering) {
+            // If the number of movements queued is less than 3, and there is still time
+            //  to wait, do not deliver anything
+            if (nr_moves < 3) return NULL;
+            delay_before_delivering = 0;
+          }
+
+          const uint8_t block_index = block_buffer_nonbusy;
+          block_t * const block = &block_buffer[block_index];
+
+          // No trapezoid calculated? Don't execute yet.
+          if (TEST(block->flag, BLOCK_BIT_RECALCULATE)) return NULL;
+
+          #if HAS_SPI_LCD
+            block_buffer_runtime_us -= block->segment_time_us; // We can't be sure how long an active block will take, so don't count it.
+          #endif
+
+          // As this block is busy, advance the nonbusy block pointer
+          block_buffer_nonbusy = next_block_index(block_index);
+
+          // Push block_buffer_planned pointer, if encountered.
+          if (block_index == block_buffer_planned)
+            block_buffer_planned = block_buffer_nonbusy;
+
+          // Return the block
+          return block;
+        }
+
+        // The queue became empty
+        #if HAS_SPI_LCD
+          if (!has_blocks_queued()) clear_block_buffer_runtime();
+        #endif
+
+        return NULL;
+      }
+
+      /**
+       * Hand the busy blocks to the step generator again,
+       * after their step events were dropped
+       */
+      static void rewind_nonbusy_blocks() {
+        #if HAS_SPI_LCD
+          for (uint8_t b = block_buffer_tail; b != block_buffer_nonbusy; b = next_block_index(b))
+            block_buffer_runtime_us += block_buffer[b].segment_time_us;
+        #endif
+        block_buffer_nonbusy = block_buffer_tail;
+      }
+
+    #endif // STEP_TIMELINE
+
     #if HAS_SPI_LCD
 
       static uint16_t block_buffer_runtime() {
@@ -600,12 +769,32 @@ class Planner {
 
   private: /** Private Function */
 
+    #if ENABLED(PLANNER_BENCHMARK)
+      static void bench_add(const PlannerBenchEnum phase, const uint64_t start_ns);
+    #endif
+
     /**
      * Get the index of the next / previous block in the ring buffer
      */
     static constexpr uint8_t next_block_index(const uint8_t block_index) { return BLOCK_MOD(block_index + 1); }
     static constexpr uint8_t prev_block_index(const uint8_t block_index) { return BLOCK_MOD(block_index - 1); }
 
+    /**
+     * Check if a queued block uses the entry 'index' of a side pool.
+     * Blocks release their entries by leaving the buffer.
+     */
+    template <uint8_t block_t::*POOL_INDEX>
+    static bool pool_entry_used(const uint8_t index) {
+      for (uint8_t b = block_buffer_tail; b != block_buffer_head; b = next_block_index(b))
+        if (block_buffer[b].*POOL_INDEX == index) return true;
+      return false;
+    }
+
+    /**
+     * Check if the side pool entries the next move will take are free
+     */
+    static bool pool_entries_free();
+
     /**
      * Calculate the distance (not time) it takes to accelerate
      * from initial_rate to target_rate using the given acceleration:
@@ -646,6 +835,49 @@ class Planner {
       }
     #endif
 
+    #if ENABLED(PLANNER_FIXED_POINT)
+
+      /**
+       * High 32 bits of the 64 bit product a * b.
+       * Built from four 16x16 bit products, that an 8 bit MCU
+       * does much faster than a float division.
+       */
+      FORCE_INLINE static uint32_t mul_hi32(const uint32_t a, const uint32_t b) {
+        const uint16_t  al = a, ah = a >> 16,
+                        bl = b, bh = b >> 16;
+        const uint32_t  lh = (uint32_t)al * bh,
+                        hl = (uint32_t)ah * bl,
+                        mid = (((uint32_t)al * bl) >> 16) + (lh & 0xFFFF) + (hl & 0xFFFF);
+        return (uint32_t)ah * bh + (lh >> 16) + (hl >> 16) + (mid >> 16);
+      }
+
+      /**
+       * Steps to accelerate from rate1 to rate2 with the normalized inverse of the
+       * double acceleration: (rate2 - rate1) * (rate2 + rate1) / (2 * accel).
+       * Factors above 16 bits are scaled down so their product fits in 32 bits.
+       */
+      static uint32_t fixed_acceleration_distance(const uint32_t rate1, const uint32_t rate2, const block_t* const block) {
+        if (rate2 <= rate1) return 0;
+        uint32_t  diff = rate2 - rate1,
+                  sum  = rate2 + rate1;
+        int8_t    shift = -block->acceleration_shift;
+        for (; diff > 0xFFFF; diff >>= 1) shift++;
+        for (; sum  > 0xFFFF; sum  >>= 1) shift++;
+        const uint32_t distance = mul_hi32(diff * sum, block->acceleration_inverse);
+        return shift < 0 ? distance >> -shift : distance << shift;
+      }
+
+    #endif
+
+    /**
+     * Acceleration and plateau steps of the trapezoid,
+     * return false if the nominal rate can't be reached
+     */
+    static bool float_trapezoid_steps(const block_t* const block, const uint32_t initial_rate, const uint32_t final_rate, uint32_t &accelerate_steps, int32_t &plateau_steps);
+    #if ENABLED(PLANNER_FIXED_POINT)
+      static bool fixed_trapezoid_steps(const block_t* const block, const uint32_t initial_rate, const uint32_t final_rate, uint32_t &accelerate_steps, int32_t &plateau_steps);
+    #endif
+
     static void calculate_trapezoid_for_block(block_t* const block, const float &entry_factor, const float &exit_factor);
 
     static void reverse_pass_kernel(block_t* const current, const block_t* const next);
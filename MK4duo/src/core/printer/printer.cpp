@@ -560,6 +560,11 @@ void Printer::stop() {
  */
 void Printer::idle(const bool ignore_stepper_queue/*=false*/) {
 
+  #if ENABLED(STEP_TIMELINE)
+    // Keep the Stepper ISR fed with step events
+    stepper.timeline_fill();
+  #endif
+
   #if ENABLED(SPI_ENDSTOPS)
     if (endstops.tmc_spi_homing.any
       #if ENABLED(IMPROVE_HOMING_RELIABILITY)
@@ -571,8 +576,15 @@ void Printer::idle(const bool ignore_stepper_queue/*=false*/) {
     }
   #endif
 
+  // Heaters control requested by the Tick
+  thermalManager.deferred_spin();
+
   lcdui.update();
 
+  #if ENABLED(STEP_TIMELINE)
+    stepper.timeline_fill();
+  #endif
+
   #if ENABLED(HOST_KEEPALIVE_FEATURE)
     host_keepalive_tick();
   #endif
@@ -594,6 +606,10 @@ void Printer::idle(const bool ignore_stepper_queue/*=false*/) {
 
   sound.spin();
 
+  #if HAS_SD_PRINT_INDEX
+    printindex.spin();
+  #endif
+
   #if HAS_MAX31855 || HAS_MAX6675
     thermalManager.getTemperature_SPI();
   #endif
@@ -38,6 +38,23 @@
   #endif
 #endif
 
+#if ENABLED(STEP_TIMELINE)
+  #if ENABLED(LIN_ADVANCE)
+    #error "DEPENDENCY ERROR: STEP_TIMELINE is not compatible with LIN_ADVANCE."
+  #elif ENABLED(COLOR_MIXING_EXTRUDER)
+    #error "DEPENDENCY ERROR: STEP_TIMELINE is not compatible with COLOR_MIXING_EXTRUDER."
+  #elif ENABLED(LASER)
+    #error "DEPENDENCY ERROR: STEP_TIMELINE is not compatible with LASER."
+  #elif ENABLED(Z_LATE_ENABLE)
+    #error "DEPENDENCY ERROR: STEP_TIMELINE is not compatible with Z_LATE_ENABLE."
+  #elif ENABLED(PLANNER_BENCHMARK)
+    #error "DEPENDENCY ERROR: STEP_TIMELINE is not compatible with PLANNER_BENCHMARK."
+  #endif
+  #if STEP_TIMELINE_SIZE < 16 || STEP_TIMELINE_SIZE > 256 || (STEP_TIMELINE_SIZE & (STEP_TIMELINE_SIZE - 1))
+    #error "DEPENDENCY ERROR: STEP_TIMELINE_SIZE must be a power of 2 from 16 to 256."
+  #endif
+#endif
+
 #if ENABLED(DIGIPOT_I2C)
   #if DISABLED(DIGIPOT_I2C_NUM_CHANNELS)
     #error "DEPENDENCY ERROR: Missing setting DIGIPOT_I2C_NUM_CHANNELS."
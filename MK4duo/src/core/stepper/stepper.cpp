@@ -185,6 +185,24 @@ int8_t  Stepper::count_direction[NUM_AXIS]  = { 1, 1, 1, 1 };
   #endif // LASER_RASTER
 #endif // LASER
 
+#if ENABLED(STEP_TIMELINE)
+  step_event_t      Stepper::timeline[STEP_TIMELINE_SIZE];
+  volatile uint8_t  Stepper::timeline_head      = 0,
+                    Stepper::timeline_tail      = 0;
+  volatile bool     Stepper::timeline_hold      = false,
+                    Stepper::timeline_filling   = false,
+                    Stepper::timeline_fast      = false;
+  volatile uint16_t Stepper::timeline_underruns = 0;
+  bool              Stepper::timeline_in_block  = false,
+                    Stepper::timeline_due       = false,
+                    Stepper::timeline_regular   = false;
+  uint8_t           Stepper::timeline_group     = 0;
+  uint32_t          Stepper::timeline_waited    = 0,
+                    Stepper::timeline_carry     = 0,
+                    Stepper::timeline_spacing   = 0,
+                    Stepper::timeline_interval  = 0;
+#endif
+
 /** Public Function */
 void Stepper::init() {
 
@@ -432,16 +450,25 @@ void Stepper::Step() {
     // Enable ISRs to reduce USART processing latency
     ENABLE_ISRS();
 
-    // Run main stepping pulse phase ISR if we have to
-    if (!nextMainISR) pulse_phase_step();
+    #if ENABLED(STEP_TIMELINE)
 
-    #if ENABLED(LIN_ADVANCE)
-      // Run linear advance stepper ISR
-      if (!nextAdvanceISR) nextAdvanceISR = lin_advance_step();
-    #endif
+      // Output the step events made ahead by the main loop
+      if (!nextMainISR) nextMainISR = timeline_step();
+
+    #else
+
+      // Run main stepping pulse phase ISR if we have to
+      if (!nextMainISR) pulse_phase_step();
+
+      #if ENABLED(LIN_ADVANCE)
+        // Run linear advance stepper ISR
+        if (!nextAdvanceISR) nextAdvanceISR = lin_advance_step();
+      #endif
 
-    // Run main stepping block processing ISR if we have to
-    if (!nextMainISR) nextMainISR = block_phase_step();
+      // Run main stepping block processing ISR if we have to
+      if (!nextMainISR) nextMainISR = block_phase_step();
+
+    #endif
 
     #if ENABLED(LIN_ADVANCE)
       uint32_t interval = MIN(nextAdvanceISR, nextMainISR); // Nearest time interval
@@ -530,29 +557,41 @@ void Stepper::Step() {
  */
 bool Stepper::is_block_busy(const block_t* const block) {
 
-  #if ENABLED(__AVR__)
+  #if ENABLED(STEP_TIMELINE)
 
-    // Keep reading until 2 consecutive reads return the same value,
-    // meaning there was no update in-between caused by an interrupt.
-    // This works because stepper ISRs happen at a slower rate than
-    // successive reads of a variable, so 2 consecutive reads with
-    // the same value means no interrupt updated it.
-    block_t* vold, *vnew = current_block;
-    sw_barrier();
-    do {
-      vold = vnew;
-      vnew = current_block;
+    // Every block handed to the step generator stays busy until
+    // the Stepper ISR has output the last of its step events
+    if (!block) return false;
+    const uint8_t tail = planner.block_buffer_tail;
+    return BLOCK_MOD(uint8_t(block - planner.block_buffer) - tail) < BLOCK_MOD(planner.block_buffer_nonbusy - tail);
+
+  #else
+
+    #if ENABLED(__AVR__)
+
+      // Keep reading until 2 consecutive reads return the same value,
+      // meaning there was no update in-between caused by an interrupt.
+      // This works because stepper ISRs happen at a slower rate than
+      // successive reads of a variable, so 2 consecutive reads with
+      // the same value means no interrupt updated it.
+      block_t* vold, *vnew = current_block;
       sw_barrier();
-    } while (vold != vnew);
+      do {
+        vold = vnew;
+        vnew = current_block;
+        sw_barrier();
+      } while (vold != vnew);
 
-  #else // CPU 32 BIT
+    #else // CPU 32 BIT
 
-    block_t *vnew = current_block;
+      block_t *vnew = current_block;
 
-  #endif
+    #endif
 
-  // Return if the block is busy or not
-  return block == vnew;
+    // Return if the block is busy or not
+    return block == vnew;
+
+  #endif
 
 }
 
@@ -1422,7 +1461,7 @@ void Stepper::pulse_phase_step() {
           if (current_block->laser_mode == RASTER && current_block->laser_status == LASER_ON) { // Raster Firing Mode
             // For some reason, when comparing raster power to ppm line burns the rasters were around 2% more powerful
             // going from darkened paper to burning through paper.
-            laser.fire(current_block->laser_raster_data[counter_raster]);
+            laser.fire(planner.raster_pool[current_block->raster_index][counter_raster]);
             counter_raster++;
           }
         #endif // LASER_RASTER
@@ -1453,6 +1492,261 @@ void Stepper::pulse_phase_step() {
 
 }
 
+/**
+ * Flag all the moving axes of the current block, for proper endstop handling
+ */
+FORCE_INLINE uint8_t Stepper::block_moving_axes() {
+
+  #if IS_CORE
+    // Define conditions for checking endstops
+    #define S_(N) current_block->steps[CORE_AXIS_##N]
+    #define D_(N) TEST(current_block->direction_bits, CORE_AXIS_##N)
+  #endif
+
+  #if CORE_IS_XY || CORE_IS_XZ
+    /**
+     * Head direction in -X axis for CoreXY and CoreXZ bots.
+     *
+     * If steps differ, both axes are moving.
+     * If DeltaA == -DeltaB, the movement is only in the 2nd axis (Y or Z, handled below)
+     * If DeltaA ==  DeltaB, the movement is only in the 1st axis (X)
+     */
+    #if MECH(COREXY) || MECH(COREXZ)
+      #define X_CMP ==
+    #else
+      #define X_CMP !=
+    #endif
+    #define X_MOVE_TEST ( S_(1) != S_(2) || (S_(1) > 0 && D_(1) X_CMP D_(2)) )
+  #else
+    #define X_MOVE_TEST !!current_block->steps[A_AXIS]
+  #endif
+
+  #if CORE_IS_XY || CORE_IS_YZ
+    /**
+     * Head direction in -Y axis for CoreXY / CoreYZ bots.
+     *
+     * If steps differ, both axes are moving
+     * If DeltaA ==  DeltaB, the movement is only in the 1st axis (X or Y)
+     * If DeltaA == -DeltaB, the movement is only in the 2nd axis (Y or Z)
+     */
+    #if MECH(COREYX) || MECH(COREYZ)
+      #define Y_CMP ==
+    #else
+      #define Y_CMP !=
+    #endif
+    #define Y_MOVE_TEST ( S_(1) != S_(2) || (S_(1) > 0 && D_(1) Y_CMP D_(2)) )
+  #else
+    #define Y_MOVE_TEST !!current_block->steps[B_AXIS]
+  #endif
+
+  #if CORE_IS_XZ || CORE_IS_YZ
+    /**
+     * Head direction in -Z axis for CoreXZ or CoreYZ bots.
+     *
+     * If steps differ, both axes are moving
+     * If DeltaA ==  DeltaB, the movement is only in the 1st axis (X or Y, already handled above)
+     * If DeltaA == -DeltaB, the movement is only in the 2nd axis (Z)
+     */
+    #if MECH(COREZX) || MECH(COREZY)
+      #define Z_CMP ==
+    #else
+      #define Z_CMP !=
+    #endif
+    #define Z_MOVE_TEST ( S_(1) != S_(2) || (S_(1) > 0 && D_(1) Z_CMP D_(2)) )
+  #else
+    #define Z_MOVE_TEST !!current_block->steps[C_AXIS]
+  #endif
+
+  uint8_t axis_bits = 0;
+  if (X_MOVE_TEST) SBI(axis_bits, A_AXIS);
+  if (Y_MOVE_TEST) SBI(axis_bits, B_AXIS);
+  if (Z_MOVE_TEST) SBI(axis_bits, C_AXIS);
+  //if (!!current_block->steps[E_AXIS]) SBI(axis_bits, E_AXIS);
+  //if (!!current_block->steps[A_AXIS]) SBI(axis_bits, X_HEAD);
+  //if (!!current_block->steps[B_AXIS]) SBI(axis_bits, Y_HEAD);
+  //if (!!current_block->steps[C_AXIS]) SBI(axis_bits, Z_HEAD);
+
+  return axis_bits;
+}
+
+/**
+ * Initialize the Bresenham line tracer and the trapezoid generator
+ * from the current block. Return the interval to the first step.
+ */
+FORCE_INLINE uint32_t Stepper::block_init() {
+
+  // No data.acceleration / deceleration time elapsed so far
+  acceleration_time = deceleration_time = 0;
+
+  uint8_t oversampling = 0;                           // Assume we won't use it
+
+  #if ENABLED(ADAPTIVE_STEP_SMOOTHING)
+    // At this point, we must decide if we can use Stepper movement axis smoothing.
+    uint32_t max_rate = current_block->nominal_rate;  // Get the maximum rate (maximum event speed)
+    while (max_rate < HAL_frequency_limit[0]) {
+      max_rate <<= 1;
+      if (max_rate >= HAL_frequency_limit[0]) break;
+      ++oversampling;
+    }
+    oversampling_factor = oversampling;
+  #endif
+
+  // Based on the oversampling factor, do the calculations
+  step_event_count = current_block->step_event_count << oversampling;
+
+  // Initialize Bresenham delta errors to 1/2
+  delta_error[X_AXIS] = delta_error[Y_AXIS] = delta_error[Z_AXIS] = delta_error[E_AXIS] = -int32_t(step_event_count);
+
+  #if ENABLED(LASER)
+    delta_error_laser = delta_error[X_AXIS];
+    laser.dur = current_block->laser_duration;
+  #endif
+
+  // Calculate Bresenham dividends
+  advance_dividend[X_AXIS] = current_block->steps[X_AXIS] << 1;
+  advance_dividend[Y_AXIS] = current_block->steps[Y_AXIS] << 1;
+  advance_dividend[Z_AXIS] = current_block->steps[Z_AXIS] << 1;
+  advance_dividend[E_AXIS] = current_block->steps[E_AXIS] << 1;
+
+  // Calculate Bresenham divisor
+  advance_divisor = step_event_count << 1;
+
+  // No step events completed so far
+  step_events_completed = 0;
+
+  // Compute the data.acceleration and deceleration points
+  accelerate_until = current_block->accelerate_until << oversampling;
+  decelerate_after = current_block->decelerate_after << oversampling;
+
+  // Mark the time_nominal as not calculated yet
+  ticks_nominal = -1;
+
+  #if DISABLED(BEZIER_JERK_CONTROL)
+    // Set as deceleration point the initial rate of the block
+    acc_step_rate = current_block->initial_rate;
+  #else
+    // Initialize the Bézier speed curve
+    _calc_bezier_curve_coeffs(current_block->initial_rate, current_block->cruise_rate, current_block->acceleration_time_inverse);
+    // We haven't started the 2nd half of the trapezoid
+    bezier_2nd_half = false;
+  #endif
+
+  #if ENABLED(LASER) && ENABLED(LASER_RASTER)
+     if (current_block->laser_mode == RASTER) counter_raster = 0;
+  #endif
+
+  // Calculate the initial timer interval
+  return calc_timer_interval(current_block->initial_rate, &steps_per_isr, oversampling_factor);
+}
+
+/**
+ * Advance the trapezoid generator of the current block.
+ * Return the interval to the next step.
+ */
+FORCE_INLINE uint32_t Stepper::trapezoid_interval() {
+
+  uint32_t interval;
+
+  // Are we in acceleration phase ?
+  if (step_events_completed <= accelerate_until) {
+
+    #if ENABLED(BEZIER_JERK_CONTROL)
+      // Get the next speed to use (Jerk limited!)
+      uint32_t acc_step_rate =
+        acceleration_time < current_block->acceleration_time
+          ? _eval_bezier_curve(acceleration_time)
+          : current_block->cruise_rate;
+    #else
+      acc_step_rate = HAL_MULTI_ACC(acceleration_time, current_block->acceleration_rate) + current_block->initial_rate;
+      NOMORE(acc_step_rate, current_block->nominal_rate);
+    #endif
+
+    // acc_step_rate is in steps/second
+
+    // step_rate to timer interval
+    interval = calc_timer_interval(acc_step_rate, &steps_per_isr, oversampling_factor);
+    acceleration_time += interval;
+
+    #if ENABLED(LIN_ADVANCE)
+      if (LA_use_advance_lead) {
+        // Fire ISR if final adv_rate is reached
+        if (LA_steps && LA_isr_rate != current_block->advance_speed) nextAdvanceISR = 0;
+      }
+      else if (LA_steps) nextAdvanceISR = 0;
+    #endif // ENABLED(LIN_ADVANCE)
+  }
+  // Are we in deceleration phase
+  else if (step_events_completed > decelerate_after) {
+    uint32_t step_rate;
+
+    #if ENABLED(BEZIER_JERK_CONTROL)
+      // If this is the 1st time we process the 2nd half of the trapezoid...
+      if (!bezier_2nd_half) {
+        // Initialize the Bézier speed curve
+        _calc_bezier_curve_coeffs(current_block->cruise_rate, current_block->final_rate, current_block->deceleration_time_inverse);
+        bezier_2nd_half = true;
+        // The first point starts at cruise rate. Just save evaluation of the Bézier curve
+        step_rate = current_block->cruise_rate;
+      }
+      else {
+        // Calculate the next speed to use
+        step_rate = deceleration_time < current_block->deceleration_time
+          ? _eval_bezier_curve(deceleration_time)
+          : current_block->final_rate;
+      }
+    #else
+
+      // Using the old trapezoidal control
+      step_rate = HAL_MULTI_ACC(deceleration_time, current_block->acceleration_rate);
+
+      if (step_rate < acc_step_rate) { // Still decelerating?
+        step_rate = acc_step_rate - step_rate;
+        NOLESS(step_rate, current_block->final_rate);
+      }
+      else
+        step_rate = current_block->final_rate;
+    #endif
+
+    // step_rate is in steps/second
+
+    // step_rate to timer interval
+    interval = calc_timer_interval(step_rate, &steps_per_isr, oversampling_factor);
+    deceleration_time += interval;
+
+    #if ENABLED(LIN_ADVANCE)
+      if (LA_use_advance_lead) {
+        // Wake up eISR on first deceleration loop and fire ISR if final adv_rate is reached
+        if (step_events_completed <= decelerate_after + steps_per_isr ||
+           (LA_steps && LA_isr_rate != current_block->advance_speed)
+        ) {
+          nextAdvanceISR = 0;
+          LA_isr_rate = current_block->advance_speed;
+        }
+      }
+      else if (LA_steps) nextAdvanceISR = 0;
+    #endif // LIN_ADVANCE
+  }
+  // We must be in cruise phase otherwise
+  else {
+
+    #if ENABLED(LIN_ADVANCE)
+      // If there are any esteps, fire the next advance_isr "now"
+      if (LA_steps && LA_isr_rate != current_block->advance_speed) nextAdvanceISR = 0;
+    #endif
+
+    // Calculate the ticks_nominal for this nominal speed, if not done yet
+    if (ticks_nominal < 0) {
+      // step_rate to timer interval and loops for the nominal speed
+      ticks_nominal = calc_timer_interval(current_block->nominal_rate, &steps_per_isr, oversampling_factor);
+    }
+
+    // The timer interval is just the nominal value for the nominal speed
+    interval = ticks_nominal;
+  }
+
+  return interval;
+}
+
 uint32_t Stepper::block_phase_step() {
 
   // If no queued movements, just wait 1ms for the next move
@@ -1476,103 +1770,7 @@ uint32_t Stepper::block_phase_step() {
     }
     else {
       // Step events not completed yet...
-
-      // Are we in acceleration phase ?
-      if (step_events_completed <= accelerate_until) {
-
-        #if ENABLED(BEZIER_JERK_CONTROL)
-          // Get the next speed to use (Jerk limited!)
-          uint32_t acc_step_rate =
-            acceleration_time < current_block->acceleration_time
-              ? _eval_bezier_curve(acceleration_time)
-              : current_block->cruise_rate;
-        #else
-          acc_step_rate = HAL_MULTI_ACC(acceleration_time, current_block->acceleration_rate) + current_block->initial_rate;
-          NOMORE(acc_step_rate, current_block->nominal_rate);
-        #endif
-
-        // acc_step_rate is in steps/second
-
-        // step_rate to timer interval
-        interval = calc_timer_interval(acc_step_rate, &steps_per_isr, oversampling_factor);
-        acceleration_time += interval;
-
-        #if ENABLED(LIN_ADVANCE)
-          if (LA_use_advance_lead) {
-            // Fire ISR if final adv_rate is reached
-            if (LA_steps && LA_isr_rate != current_block->advance_speed) nextAdvanceISR = 0;
-          }
-          else if (LA_steps) nextAdvanceISR = 0;
-        #endif // ENABLED(LIN_ADVANCE)
-      }
-      // Are we in deceleration phase
-      else if (step_events_completed > decelerate_after) {
-        uint32_t step_rate;
-
-        #if ENABLED(BEZIER_JERK_CONTROL)
-          // If this is the 1st time we process the 2nd half of the trapezoid...
-          if (!bezier_2nd_half) {
-            // Initialize the Bézier speed curve
-            _calc_bezier_curve_coeffs(current_block->cruise_rate, current_block->final_rate, current_block->deceleration_time_inverse);
-            bezier_2nd_half = true;
-            // The first point starts at cruise rate. Just save evaluation of the Bézier curve
-            step_rate = current_block->cruise_rate;
-          }
-          else {
-            // Calculate the next speed to use
-            step_rate = deceleration_time < current_block->deceleration_time
-              ? _eval_bezier_curve(deceleration_time)
-              : current_block->final_rate;
-          }
-        #else
-
-          // Using the old trapezoidal control
-          step_rate = HAL_MULTI_ACC(deceleration_time, current_block->acceleration_rate);
-
-          if (step_rate < acc_step_rate) { // Still decelerating?
-            step_rate = acc_step_rate - step_rate;
-            NOLESS(step_rate, current_block->final_rate);
-          }
-          else
-            step_rate = current_block->final_rate;
-        #endif
-
-        // step_rate is in steps/second
-
-        // step_rate to timer interval
-        interval = calc_timer_interval(step_rate, &steps_per_isr, oversampling_factor);
-        deceleration_time += interval;
-
-        #if ENABLED(LIN_ADVANCE)
-          if (LA_use_advance_lead) {
-            // Wake up eISR on first deceleration loop and fire ISR if final adv_rate is reached
-            if (step_events_completed <= decelerate_after + steps_per_isr ||
-               (LA_steps && LA_isr_rate != current_block->advance_speed)
-            ) {
-              nextAdvanceISR = 0;
-              LA_isr_rate = current_block->advance_speed;
-            }
-          }
-          else if (LA_steps) nextAdvanceISR = 0;
-        #endif // LIN_ADVANCE
-      }
-      // We must be in cruise phase otherwise
-      else {
-
-        #if ENABLED(LIN_ADVANCE)
-          // If there are any esteps, fire the next advance_isr "now"
-          if (LA_steps && LA_isr_rate != current_block->advance_speed) nextAdvanceISR = 0;
-        #endif
-
-        // Calculate the ticks_nominal for this nominal speed, if not done yet
-        if (ticks_nominal < 0) {
-          // step_rate to timer interval and loops for the nominal speed
-          ticks_nominal = calc_timer_interval(current_block->nominal_rate, &steps_per_isr, oversampling_factor);
-        }
-
-        // The timer interval is just the nominal value for the nominal speed
-        interval = ticks_nominal;
-      }
+      interval = trapezoid_interval();
     }
   }
 
@@ -1597,122 +1795,13 @@ uint32_t Stepper::block_phase_step() {
       }
 
       // Flag all moving axes for proper endstop handling
+      axis_did_move = block_moving_axes();
 
-      #if IS_CORE
-        // Define conditions for checking endstops
-        #define S_(N) current_block->steps[CORE_AXIS_##N]
-        #define D_(N) TEST(current_block->direction_bits, CORE_AXIS_##N)
-      #endif
-
-      #if CORE_IS_XY || CORE_IS_XZ
-        /**
-         * Head direction in -X axis for CoreXY and CoreXZ bots.
-         *
-         * If steps differ, both axes are moving.
-         * If DeltaA == -DeltaB, the movement is only in the 2nd axis (Y or Z, handled below)
-         * If DeltaA ==  DeltaB, the movement is only in the 1st axis (X)
-         */
-        #if MECH(COREXY) || MECH(COREXZ)
-          #define X_CMP ==
-        #else
-          #define X_CMP !=
-        #endif
-        #define X_MOVE_TEST ( S_(1) != S_(2) || (S_(1) > 0 && D_(1) X_CMP D_(2)) )
-      #else
-        #define X_MOVE_TEST !!current_block->steps[A_AXIS]
-      #endif
-
-      #if CORE_IS_XY || CORE_IS_YZ
-        /**
-         * Head direction in -Y axis for CoreXY / CoreYZ bots.
-         *
-         * If steps differ, both axes are moving
-         * If DeltaA ==  DeltaB, the movement is only in the 1st axis (X or Y)
-         * If DeltaA == -DeltaB, the movement is only in the 2nd axis (Y or Z)
-         */
-        #if MECH(COREYX) || MECH(COREYZ)
-          #define Y_CMP ==
-        #else
-          #define Y_CMP !=
-        #endif
-        #define Y_MOVE_TEST ( S_(1) != S_(2) || (S_(1) > 0 && D_(1) Y_CMP D_(2)) )
-      #else
-        #define Y_MOVE_TEST !!current_block->steps[B_AXIS]
-      #endif
-
-      #if CORE_IS_XZ || CORE_IS_YZ
-        /**
-         * Head direction in -Z axis for CoreXZ or CoreYZ bots.
-         *
-         * If steps differ, both axes are moving
-         * If DeltaA ==  DeltaB, the movement is only in the 1st axis (X or Y, already handled above)
-         * If DeltaA == -DeltaB, the movement is only in the 2nd axis (Z)
-         */
-        #if MECH(COREZX) || MECH(COREZY)
-          #define Z_CMP ==
-        #else
-          #define Z_CMP !=
-        #endif
-        #define Z_MOVE_TEST ( S_(1) != S_(2) || (S_(1) > 0 && D_(1) Z_CMP D_(2)) )
-      #else
-        #define Z_MOVE_TEST !!current_block->steps[C_AXIS]
-      #endif
-
-      uint8_t axis_bits = 0;
-      if (X_MOVE_TEST) SBI(axis_bits, A_AXIS);
-      if (Y_MOVE_TEST) SBI(axis_bits, B_AXIS);
-      if (Z_MOVE_TEST) SBI(axis_bits, C_AXIS);
-      //if (!!current_block->steps[E_AXIS]) SBI(axis_bits, E_AXIS);
-      //if (!!current_block->steps[A_AXIS]) SBI(axis_bits, X_HEAD);
-      //if (!!current_block->steps[B_AXIS]) SBI(axis_bits, Y_HEAD);
-      //if (!!current_block->steps[C_AXIS]) SBI(axis_bits, Z_HEAD);
-      axis_did_move = axis_bits;
-
-      // No data.acceleration / deceleration time elapsed so far
-      acceleration_time = deceleration_time = 0;
-
-      uint8_t oversampling = 0;                           // Assume we won't use it
-
-      #if ENABLED(ADAPTIVE_STEP_SMOOTHING)
-        // At this point, we must decide if we can use Stepper movement axis smoothing.
-        uint32_t max_rate = current_block->nominal_rate;  // Get the maximum rate (maximum event speed)
-        while (max_rate < HAL_frequency_limit[0]) {
-          max_rate <<= 1;
-          if (max_rate >= HAL_frequency_limit[0]) break;
-          ++oversampling;
-        }
-        oversampling_factor = oversampling;
-      #endif
-
-      // Based on the oversampling factor, do the calculations
-      step_event_count = current_block->step_event_count << oversampling;
-
-      // Initialize Bresenham delta errors to 1/2
-      delta_error[X_AXIS] = delta_error[Y_AXIS] = delta_error[Z_AXIS] = delta_error[E_AXIS] = -int32_t(step_event_count);
-
-      #if ENABLED(LASER)
-        delta_error_laser = delta_error[X_AXIS];
-        laser.dur = current_block->laser_duration;
-      #endif
-
-      // Calculate Bresenham dividends
-      advance_dividend[X_AXIS] = current_block->steps[X_AXIS] << 1;
-      advance_dividend[Y_AXIS] = current_block->steps[Y_AXIS] << 1;
-      advance_dividend[Z_AXIS] = current_block->steps[Z_AXIS] << 1;
-      advance_dividend[E_AXIS] = current_block->steps[E_AXIS] << 1;
-
-      // Calculate Bresenham divisor
-      advance_divisor = step_event_count << 1;
-
-      // No step events completed so far
-      step_events_completed = 0;
-
-      // Compute the data.acceleration and deceleration points
-      accelerate_until = current_block->accelerate_until << oversampling;
-      decelerate_after = current_block->decelerate_after << oversampling;
+      // Initialize the Bresenham line tracer and the trapezoid generator
+      interval = block_init();
 
       #if ENABLED(COLOR_MIXING_EXTRUDER)
-        mixer.stepper_setup(current_block->b_color);
+        mixer.stepper_setup(planner.color_pool[current_block->color_index]);
       #endif
 
       #if EXTRUDERS > 1
@@ -1765,35 +1854,18 @@ uint32_t Stepper::block_phase_step() {
         if (current_block->steps[Z_AXIS]) enable_Z();
       #endif
 
-      // Mark the time_nominal as not calculated yet
-      ticks_nominal = -1;
-
-      #if DISABLED(BEZIER_JERK_CONTROL)
-        // Set as deceleration point the initial rate of the block
-        acc_step_rate = current_block->initial_rate;
-      #else
-        // Initialize the Bézier speed curve
-        _calc_bezier_curve_coeffs(current_block->initial_rate, current_block->cruise_rate, current_block->acceleration_time_inverse);
-        // We haven't started the 2nd half of the trapezoid
-        bezier_2nd_half = false;
-      #endif
-
-      #if ENABLED(LASER) && ENABLED(LASER_RASTER)
-         if (current_block->laser_mode == RASTER) counter_raster = 0;
-      #endif
-
-      // Calculate the initial timer interval
-      interval = calc_timer_interval(current_block->initial_rate, &steps_per_isr, oversampling_factor);
     }
   }
 
   // Continuous firing of the laser during a move happens here, PPM and raster happen further down
   #if ENABLED(LASER)
-    if (current_block->laser_mode == CONTINUOUS && current_block->laser_status == LASER_ON)
-      laser.fire(current_block->laser_intensity);
+    if (current_block) {
+      if (current_block->laser_mode == CONTINUOUS && current_block->laser_status == LASER_ON)
+        laser.fire(current_block->laser_intensity);
 
-    if (current_block->laser_status == LASER_OFF)
-      laser.extinguish();
+      if (current_block->laser_status == LASER_OFF)
+        laser.extinguish();
+    }
   #endif
 
   // Return the interval to wait
@@ -1893,6 +1965,354 @@ FORCE_INLINE void Stepper::pulse_tick_stop() {
 
 }
 
+#if ENABLED(STEP_TIMELINE)
+
+  #define TIMELINE_MOD(n)     ((n) & (STEP_TIMELINE_SIZE - 1))
+  #define TIMELINE_POLL_TICKS (STEPPER_TIMER_RATE / 4000UL)   // 250µs, while waiting the main loop in a block
+  #define TIMELINE_ISR_EVENTS ((STEP_TIMELINE_SIZE) / 8)      // Step events converted by the ISR on an underrun, and left when the next block is taken
+
+  // Keep the compiler from moving memory accesses across the index updates
+  #ifndef sw_barrier
+    #define sw_barrier() asm volatile("": : :"memory");
+  #endif
+
+  /**
+   * Fill the timeline with step events, as far as it has room,
+   * and report the underruns of the ISR at most once a second.
+   */
+  void Stepper::timeline_fill() {
+
+    // The ISR converts the blocks too on an underrun, but not while we do
+    timeline_filling = true;
+    sw_barrier();
+
+    // The ISR dropped an aborted block: drop the step events made
+    // ahead too and convert again the blocks left in the planner
+    if (timeline_hold) {
+      timeline_head = timeline_tail;
+      planner.rewind_nonbusy_blocks();
+      current_block = NULL;
+      timeline_group = 0;
+      timeline_carry = 0;
+      timeline_fast = false;
+      sw_barrier();
+      timeline_hold = false;
+    }
+
+    timeline_convert(0);
+
+    sw_barrier();
+    timeline_filling = false;
+
+    static millis_l underrun_report_ms = 0;
+    if (timeline_underruns && ELAPSED(millis(), underrun_report_ms)) {
+      underrun_report_ms = millis() + 1000UL;
+      CRITICAL_SECTION_START;
+      const uint16_t underruns = timeline_underruns;
+      timeline_underruns = 0;
+      CRITICAL_SECTION_END;
+      SERIAL_LMV(ECHO, "Step timeline underruns: ", underruns);
+    }
+
+  }
+
+  /**
+   * Convert the planner blocks into step events, until only keep_free are left free.
+   *
+   * This is the Bresenham line tracer and the trapezoid generator of
+   * block_phase_step(), run ahead of time. Each group of steps that the
+   * ISR would output at once is spread evenly over its interval, and the
+   * step events without steps (oversampling) are merged into the next one.
+   * A block faster than one step event per ISR_TIMELINE_CYCLES is left to
+   * the ISR, that steps it as block_phase_step(): the conversion waits
+   * until the block ends, as the ISR then owns the line tracer.
+   */
+  void Stepper::timeline_convert(const uint8_t keep_free) {
+
+    // As long as there is room for a step event and no fast block is left to the ISR
+    while (!timeline_fast && TIMELINE_MOD(timeline_tail - timeline_head - 1) > keep_free) {
+
+      uint8_t flag = 0;
+
+      if (!current_block) {
+
+        // Take the next block only when the step events run low: the blocks
+        // left in the planner are still replanned with the ones that follow
+        if (TIMELINE_MOD(timeline_head - timeline_tail) >= TIMELINE_ISR_EVENTS) return;
+
+        if (!(current_block = planner.get_next_block())) return;
+
+        // Sync block? The ISR syncs the stepper counts when it gets there
+        if (TEST(current_block->flag, BLOCK_BIT_SYNC_POSITION)) {
+          timeline_push(0, 0, _BV(STEP_EVENT_BIT_SYNC), 0);
+          current_block = NULL;
+          continue;
+        }
+
+        // Initialize the Bresenham line tracer and the trapezoid generator
+        timeline_interval = block_init();
+        flag = _BV(STEP_EVENT_BIT_FIRST);
+
+        // Too fast for the step events? The ISR steps it with multistepping
+        if (current_block->nominal_rate > (F_CPU) / (ISR_TIMELINE_CYCLES)) {
+          timeline_fast = true;
+          timeline_push(timeline_carry, 0, flag | _BV(STEP_EVENT_BIT_FAST),
+            block_moving_axes() | (current_block->active_extruder << 4)
+          );
+          timeline_carry = 0;
+          return;
+        }
+      }
+
+      // Spread the next group of steps over its interval
+      if (!timeline_group) {
+        timeline_group = MIN(step_event_count - step_events_completed, uint32_t(steps_per_isr));
+        timeline_spacing = timeline_interval / timeline_group;
+        timeline_carry += timeline_interval - timeline_spacing * timeline_group;
+      }
+
+      timeline_carry += timeline_spacing;
+
+      uint8_t step_bits = 0;
+      LOOP_XYZE(i) {
+        delta_error[i] += advance_dividend[i];
+        if (delta_error[i] >= 0) {
+          delta_error[i] -= advance_divisor;
+          SBI(step_bits, i);
+        }
+      }
+
+      --timeline_group;
+      if (++step_events_completed >= step_event_count) SBI(flag, STEP_EVENT_BIT_LAST);
+
+      if (step_bits || flag) {
+        timeline_push(timeline_carry, step_bits, flag,
+          TEST(flag, STEP_EVENT_BIT_FIRST) ? block_moving_axes() | (current_block->active_extruder << 4) : 0
+        );
+        timeline_carry = 0;
+      }
+
+      if (TEST(flag, STEP_EVENT_BIT_LAST)) {
+        // The trailing interval of a block is dropped, as by block_phase_step()
+        current_block = NULL;
+        timeline_group = 0;
+      }
+      else if (!timeline_group)
+        timeline_interval = trapezoid_interval();
+    }
+
+  }
+
+  FORCE_INLINE void Stepper::timeline_push(const uint32_t interval, const uint8_t step_bits, const uint8_t flag, const uint8_t info) {
+    step_event_t &event = timeline[timeline_head];
+    event.interval  = interval;
+    event.step_bits = step_bits;
+    event.dir_bits  = current_block->direction_bits;
+    event.flag      = flag;
+    event.info      = info;
+    // The event must be complete before the ISR can see it
+    sw_barrier();
+    timeline_head = TIMELINE_MOD(timeline_head + 1);
+  }
+
+  /**
+   * Output the step event that is due, if any, and return the interval
+   * to the next one. Nothing here depends on the block being traced.
+   */
+  uint32_t Stepper::timeline_step() {
+
+    // If we must abort the current block, do so! The main loop
+    // then drops the step events made ahead, so hold until then.
+    if (abort_current_block) {
+      abort_current_block = false;
+      if (timeline_in_block) {
+        timeline_in_block = false;
+        axis_did_move = 0;
+        planner.discard_current_block();
+      }
+      timeline_due = false;
+      timeline_waited = 0;
+      timeline_regular = false;
+      timeline_hold = true;
+    }
+
+    if (timeline_hold) return (STEPPER_TIMER_RATE / 1000);
+
+    // Step the fast block until it ends, then go on with the step events
+    if (timeline_regular) {
+      const uint32_t interval = timeline_regular_step();
+      if (timeline_regular) return interval;
+    }
+
+    if (timeline_due) {
+
+      const step_event_t &event = timeline[timeline_tail];
+
+      if (TEST(event.flag, STEP_EVENT_BIT_SYNC)) {
+        // Sync block, the step events before it were all output
+        const block_t * const block = &planner.block_buffer[planner.block_buffer_tail];
+        _set_position(
+          block->position[A_AXIS], block->position[B_AXIS],
+          block->position[C_AXIS], block->position[E_AXIS]
+        );
+        planner.discard_current_block();
+      }
+      else {
+
+        if (TEST(event.flag, STEP_EVENT_BIT_FIRST)) {
+          timeline_in_block = true;
+          axis_did_move = event.info & 0x0F;
+          #if EXTRUDERS > 1
+            active_extruder = event.info >> 4;
+            active_extruder_driver = get_active_extruder_driver();
+          #endif
+        }
+
+        if (event.dir_bits != last_direction_bits || active_extruder != last_moved_extruder) {
+          last_direction_bits = event.dir_bits;
+          #if EXTRUDERS > 1
+            last_moved_extruder = active_extruder;
+          #endif
+          set_directions();
+        }
+
+        if (TEST(event.flag, STEP_EVENT_BIT_FIRST)) {
+          // Check the limits before the first step, as by block_phase_step().
+          // If the block gets aborted, the next call drops it.
+          endstops.update();
+          if (abort_current_block) return 0;
+        }
+
+        // Get the timer count and estimate the end of the pulse
+        const hal_timer_t pulse_end = HAL_timer_get_current_count(STEPPER_TIMER_NUM) + HAL_min_pulse_tick;
+
+        #if HAS_X_STEP
+          if (TEST(event.step_bits, X_AXIS)) {
+            start_X_step();
+            count_position[X_AXIS] += count_direction[X_AXIS];
+          }
+        #endif
+        #if HAS_Y_STEP
+          if (TEST(event.step_bits, Y_AXIS)) {
+            start_Y_step();
+            count_position[Y_AXIS] += count_direction[Y_AXIS];
+          }
+        #endif
+        #if HAS_Z_STEP
+          if (TEST(event.step_bits, Z_AXIS)) {
+            start_Z_step();
+            count_position[Z_AXIS] += count_direction[Z_AXIS];
+          }
+        #endif
+        #if HAS_EXTRUDERS
+          if (TEST(event.step_bits, E_AXIS)) {
+            E_STEP_WRITE(active_extruder_driver, !INVERT_E_STEP_PIN);
+            count_position[E_AXIS] += count_direction[E_AXIS];
+          }
+        #endif
+
+        if (data.minimum_pulse) {
+          // Just wait for the requested pulse time.
+          while (HAL_timer_get_current_count(STEPPER_TIMER_NUM) < pulse_end) { /* nada */ }
+        }
+
+        #if HAS_X_STEP
+          if (TEST(event.step_bits, X_AXIS)) stop_X_step();
+        #endif
+        #if HAS_Y_STEP
+          if (TEST(event.step_bits, Y_AXIS)) stop_Y_step();
+        #endif
+        #if HAS_Z_STEP
+          if (TEST(event.step_bits, Z_AXIS)) stop_Z_step();
+        #endif
+        #if HAS_EXTRUDERS
+          if (TEST(event.step_bits, E_AXIS)) E_STEP_WRITE(active_extruder_driver, INVERT_E_STEP_PIN);
+        #endif
+
+        if (TEST(event.flag, STEP_EVENT_BIT_LAST)) {
+          #if ENABLED(EXTRUDER_ENCODER_CONTROL) && FILAMENT_RUNOUT_DISTANCE_MM > 0
+            filamentrunout.block_completed(&planner.block_buffer[planner.block_buffer_tail]);
+          #endif
+          timeline_in_block = false;
+          axis_did_move = 0;
+          planner.discard_current_block();
+        }
+
+        if (TEST(event.flag, STEP_EVENT_BIT_FAST)) timeline_regular = true;
+      }
+
+      timeline_due = false;
+      timeline_waited = 0;
+      timeline_tail = TIMELINE_MOD(timeline_tail + 1);
+
+      // A fast block: its first steps are due after the interval of block_init()
+      if (timeline_regular) return timeline_interval;
+    }
+
+    // Nothing made ahead? In a block the main loop fell behind: count the underrun.
+    // Convert a few step events here, unless the main loop is converting, so
+    // neither the rest of a block nor the next one at a junction waits for it.
+    if (timeline_tail == timeline_head) {
+      if (timeline_in_block && !timeline_waited) ++timeline_underruns;
+      if (!timeline_filling) timeline_convert((STEP_TIMELINE_SIZE) - 1 - (TIMELINE_ISR_EVENTS));
+    }
+
+    // Still nothing? Poll shortly for the rest of a block or for a block on its way,
+    // else wait 1ms for the next move
+    if (timeline_tail == timeline_head) {
+      if (timeline_in_block) {
+        timeline_waited += TIMELINE_POLL_TICKS;
+        return TIMELINE_POLL_TICKS;
+      }
+      // The delay of delivery of the blocks is counted in 1ms waits, see Planner::get_next_block()
+      if (planner.delay_before_delivering) {
+        --planner.delay_before_delivering;
+        return (STEPPER_TIMER_RATE / 1000);
+      }
+      return planner.nonbusy_moves_planned() ? TIMELINE_POLL_TICKS : (STEPPER_TIMER_RATE / 1000);
+    }
+
+    // The next step event is due after its interval, from the last one output.
+    // A late one still leaves the drivers the time between two pulses.
+    const uint32_t interval = timeline[timeline_tail].interval;
+    timeline_due = true;
+    return interval > timeline_waited + HAL_add_pulse_ticks ? interval - timeline_waited : HAL_add_pulse_ticks;
+  }
+
+  /**
+   * Output the steps of the fast block as pulse_phase_step() and block_phase_step()
+   * and return the interval to the next ones. At the end of the block the main loop
+   * converts again and 0 is returned, for timeline_step() to go on at once.
+   */
+  uint32_t Stepper::timeline_regular_step() {
+
+    pulse_phase_step();
+
+    // The block got aborted and dropped by pulse_phase_step(), hold as timeline_step()
+    if (!current_block) {
+      timeline_in_block = false;
+      abort_current_block = true;
+      return 0;
+    }
+
+    if (step_events_completed < step_event_count) return trapezoid_interval();
+
+    #if ENABLED(EXTRUDER_ENCODER_CONTROL) && FILAMENT_RUNOUT_DISTANCE_MM > 0
+      filamentrunout.block_completed(current_block);
+    #endif
+    timeline_in_block = false;
+    timeline_regular = false;
+    axis_did_move = 0;
+    current_block = NULL;
+    planner.discard_current_block();
+    // The line tracer is free for the main loop again
+    sw_barrier();
+    timeline_fast = false;
+    return 0;
+  }
+
+#endif // STEP_TIMELINE
+
 /**
  * Start X Y Z Step
  */
@@ -51,6 +51,27 @@ typedef struct {
   uint8_t   minimum_pulse;
   bool      quad_stepping;
 } stepper_data_t;
+
+#if ENABLED(STEP_TIMELINE)
+
+  // Flags of a step event
+  enum StepEventBit : uint8_t {
+    STEP_EVENT_BIT_FIRST, // First step event of a block
+    STEP_EVENT_BIT_LAST,  // Last step event of a block, the block is discarded after it
+    STEP_EVENT_BIT_SYNC,  // Sync block, the stepper counts are set from it
+    STEP_EVENT_BIT_FAST   // Block too fast for the step events, the ISR steps it as block_phase_step()
+  };
+
+  // Struct Step event, made ahead by the main loop for the Stepper ISR
+  typedef struct {
+    uint32_t  interval;   // Timer ticks from the previous step event
+    uint8_t   step_bits,  // Axes to step
+              dir_bits,   // Direction bits of the block
+              flag,       // StepEventBit flags
+              info;       // First event: moving axes in the low nibble, extruder in the high nibble
+  } step_event_t;
+
+#endif
   
 class Stepper {
 
@@ -165,6 +186,24 @@ class Stepper {
       #endif
     #endif
 
+    #if ENABLED(STEP_TIMELINE)
+      static step_event_t     timeline[STEP_TIMELINE_SIZE]; // Step events made ahead by timeline_fill()
+      static volatile uint8_t timeline_head,                // Next step event to fill, by the main loop or the ISR on an underrun
+                              timeline_tail;                // Next step event to output, written by the ISR only
+      static volatile bool    timeline_hold,                // The ISR dropped a block, the main loop must flush the step events
+                              timeline_filling,             // The main loop is in timeline_fill(), the ISR must not convert
+                              timeline_fast;                // A fast block is left to the ISR, no conversion until it ends
+      static volatile uint16_t timeline_underruns;          // Times the ISR found no step event made ahead in a block
+      static bool             timeline_in_block,            // The ISR is outputting the step events of a block
+                              timeline_due,                 // The step event at the tail is output at the next ISR
+                              timeline_regular;             // The ISR steps the fast block itself
+      static uint8_t          timeline_group;               // Step events left in the group being spread
+      static uint32_t         timeline_waited,              // Ticks waited for the main loop since the last step event
+                              timeline_carry,               // Ticks of the step events merged into the next one
+                              timeline_spacing,             // Ticks between the step events of the group
+                              timeline_interval;            // Ticks of the next group of step events
+    #endif
+
   public: /** Public Function */
 
     /**
@@ -187,6 +226,13 @@ class Stepper {
      */
     static bool is_block_busy(const block_t* const block);
 
+    #if ENABLED(STEP_TIMELINE)
+      /**
+       * Convert the planner blocks into step events for the Stepper ISR - Called from the main loop
+       */
+      static void timeline_fill();
+    #endif
+
     /**
      * Get the position of a stepper, in steps
      */
@@ -357,6 +403,35 @@ class Stepper {
      */
     static uint32_t block_phase_step();
 
+    /**
+     * Block setup and trapezoid generator, shared by the step timeline
+     */
+    static uint8_t block_moving_axes();
+    static uint32_t block_init();
+    static uint32_t trapezoid_interval();
+
+    #if ENABLED(STEP_TIMELINE)
+      /**
+       * Output the step event that is due and return the interval to the next one
+       */
+      static uint32_t timeline_step();
+
+      /**
+       * Step the fast block as block_phase_step() and return the interval to the next steps
+       */
+      static uint32_t timeline_regular_step();
+
+      /**
+       * Convert the planner blocks into step events until only keep_free are left free
+       */
+      static void timeline_convert(const uint8_t keep_free);
+
+      /**
+       * Queue a step event of the current block
+       */
+      static void timeline_push(const uint32_t interval, const uint8_t step_bits, const uint8_t flag, const uint8_t info);
+    #endif
+
     /**
      * Pulse tick Start
      */
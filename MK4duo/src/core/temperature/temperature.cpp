@@ -45,8 +45,18 @@ Temperature thermalManager;
   int16_t Temperature::extrude_min_temp   = EXTRUDE_MINTEMP;
 #endif
 
+millis_s  Temperature::spin_latency_max_ms  = 0;
+uint32_t  Temperature::spin_time_max_us     = 0;
+
 /** Private Parameters */
 
+// Longest time a requested spin may wait for idle(), then the Tick runs it
+#define SPIN_DEFER_MAX_MS 500
+
+volatile bool Temperature::spin_requested = false,
+              Temperature::spin_running   = false;
+millis_s      Temperature::spin_request_ms = 0;
+
 #if ENABLED(FILAMENT_WIDTH_SENSOR)
   int8_t    Temperature::meas_shift_index;          // Index of a delayed sample in buffer
   uint16_t  Temperature::current_raw_filwidth = 0;  // Measured filament diameter - one extruder only
@@ -374,9 +384,43 @@ void Temperature::set_current_temp_raw() {
 
 }
 
+void Temperature::request_spin() {
+  if (!spin_requested) {
+    spin_request_ms = millis();
+    spin_requested = true;
+  }
+  else if (!spin_running && (millis_s)(millis() - spin_request_ms) > SPIN_DEFER_MAX_MS) {
+    // idle() is not called, don't leave the heaters without control
+    spin_requested = false;
+    spin();
+  }
+}
+
+void Temperature::deferred_spin() {
+
+  // Claim the request with the ISRs off, the Tick fallback of request_spin() checks it too
+  CRITICAL_SECTION_START;
+  const bool claimed = spin_requested && !spin_running;
+  if (claimed) {
+    spin_running = true;
+    spin_requested = false;
+  }
+  const millis_s latency = millis() - spin_request_ms;
+  CRITICAL_SECTION_END;
+  if (!claimed) return;
+
+  NOLESS(spin_latency_max_ms, latency);
+
+  const uint32_t start_us = micros();
+  spin();
+  NOLESS(spin_time_max_us, micros() - start_us);
+
+  spin_running = false;
+}
+
 /**
  * Spin Manage heating activities for heaters, bed, chamber and cooler
- *  - Is called every 100ms.
+ *  - Is requested every 100ms by the HAL Tick, runs from idle().
  *  - Acquire updated temperature readings
  *  - Also resets the watchdog timer
  *  - Invoke thermal runaway protection
@@ -385,6 +429,13 @@ void Temperature::set_current_temp_raw() {
  */
 void Temperature::spin() {
 
+  // Take the raw values of the Tick, all at once
+  if (HAL::Analog_is_ready) {
+    CRITICAL_SECTION_START;
+    set_current_temp_raw();
+    CRITICAL_SECTION_END;
+  }
+
   #if ENABLED(EMERGENCY_PARSER)
     if (emergency_parser.killed_by_M112) printer.kill(PSTR("M112"));
   #endif
@@ -777,6 +828,12 @@ void Temperature::report_temperatures(const bool showRaw/*=false*/) {
     SERIAL_MV(", Humidity:", dhtsensor.Humidity, 1);
   #endif
 
+  if (showRaw) {
+    SERIAL_MV(" SPIN latency:", spin_latency_max_ms);
+    SERIAL_MV("ms, time:", spin_time_max_us);
+    SERIAL_MSG("us");
+  }
+
 }
 
 // Private function
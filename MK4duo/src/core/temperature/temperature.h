@@ -49,8 +49,15 @@ class Temperature {
       static int16_t extrude_min_temp;
     #endif
 
+    static millis_s spin_latency_max_ms;    // Worst delay between the request of spin() and its run
+    static uint32_t spin_time_max_us;       // Worst run time of spin()
+
   private: /** Private Parameters */
 
+    static volatile bool  spin_requested,
+                          spin_running;
+    static millis_s       spin_request_ms;
+
     #if ENABLED(FILAMENT_WIDTH_SENSOR)
       static int8_t   meas_shift_index;     // Index of a delayed sample in buffer
       static uint16_t current_raw_filwidth; // Measured filament diameter - one extruder only
@@ -73,12 +80,23 @@ class Temperature {
     static void factory_parameters();
 
     /**
-     * Called from the Temperature ISR
+     * Copy the raw values latched by the HAL Tick to the sensors
      */
     static void set_current_temp_raw();
 
     /**
-     * Call periodically to HAL isr
+     * Called by the HAL Tick every 100ms.
+     * The heaters control is deferred to idle(), out of the interrupt.
+     */
+    static void request_spin();
+
+    /**
+     * Called from idle(), run the requested spin
+     */
+    static void deferred_spin();
+
+    /**
+     * Heaters control
      */
     static void spin();
 
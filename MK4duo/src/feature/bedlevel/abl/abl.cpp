@@ -28,8 +28,34 @@
 
   int   AutoBedLevel::bilinear_grid_spacing[2],
         AutoBedLevel::bilinear_start[2];
-  float AutoBedLevel::bilinear_grid_factor[2],
-        AutoBedLevel::z_values[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y] = { 0, 0 };
+  float AutoBedLevel::bilinear_grid_factor[2];
+
+  abl_z_t AutoBedLevel::z_values[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y] = { 0, 0 };
+
+  #if ENABLED(ABL_COMPACT_MESH)
+    float AutoBedLevel::mesh_plane[3] = { 0 };
+    #if ENABLED(ABL_REFINE)
+      uint8_t       AutoBedLevel::refine_count = 0,
+                    AutoBedLevel::refined_cells[(ABL_CELLS_X * ABL_CELLS_Y + 7) / 8] = { 0 };
+      abl_refine_t  AutoBedLevel::refine[ABL_REFINE_POINTS];
+    #endif
+  #else
+    abl_cell_t AutoBedLevel::cells[ABL_CELLS_Y][ABL_CELLS_X];
+  #endif
+
+  // Set all the points as not probed
+  void AutoBedLevel::reset_mesh() {
+    for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++)
+      for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++)
+        set_z_value(x, y, NAN);
+    #if ENABLED(ABL_COMPACT_MESH)
+      ZERO(mesh_plane);
+      #if ENABLED(ABL_REFINE)
+        refine_count = 0;
+        ZERO(refined_cells);
+      #endif
+    #endif
+  }
 
   /**
    * Extrapolate a single point from its neighbors
@@ -48,7 +74,7 @@
       DEBUG_CHR(']');
     }
 
-    if (!isnan(z_values[x][y])) {
+    if (!isnan(z_value(x, y))) {
       if (printer.debugFeature()) DEBUG_EM(" (done)");
       return;  // Don't overwrite good values.
     }
@@ -56,9 +82,9 @@
 
     // Get X neighbors, Y neighbors, and XY neighbors
     const uint8_t x1 = x + xdir, y1 = y + ydir, x2 = x1 + xdir, y2 = y1 + ydir;
-    float a1 = z_values[x1][y ], a2 = z_values[x2][y ],
-          b1 = z_values[x ][y1], b2 = z_values[x ][y2],
-          c1 = z_values[x1][y1], c2 = z_values[x2][y2];
+    float a1 = z_value(x1, y ), a2 = z_value(x2, y ),
+          b1 = z_value(x , y1), b2 = z_value(x , y2),
+          c1 = z_value(x1, y1), c2 = z_value(x2, y2);
 
     // Treat far unprobed points as zero, near as equal to far
     if (isnan(a2)) a2 = 0.0; if (isnan(a1)) a1 = a2;
@@ -68,7 +94,7 @@
     const float a = 2 * a1 - a2, b = 2 * b1 - b2, c = 2 * c1 - c2;
 
     // Take the average instead of the median
-    z_values[x][y] = (a + b + c) / 3.0;
+    set_z_value(x, y, (a + b + c) / 3.0);
 
     // Median is robust (ignores outliers).
     // z_values[x][y] = (a < b) ? ((b < c) ? b : (c < a) ? a : c)
@@ -127,9 +153,19 @@
 
   void AutoBedLevel::print_bilinear_leveling_grid() {
     SERIAL_LM(ECHO, "Bilinear Leveling Grid:");
-    bedlevel.print_2d_array(GRID_MAX_POINTS_X, GRID_MAX_POINTS_Y, 3,
-      [](const uint8_t ix, const uint8_t iy){ return z_values[ix][iy]; }
-    );
+    bedlevel.print_2d_array(GRID_MAX_POINTS_X, GRID_MAX_POINTS_Y, 3, z_value);
+    #if ENABLED(ABL_REFINE)
+      if (refine_count) {
+        SERIAL_LM(ECHO, "Refined cells:");
+        for (uint8_t i = 0; i < refine_count; i++) {
+          if (refine[i].z == ABL_Z_INVALID) continue;
+          SERIAL_MV(" ", (int)refine[i].x);
+          SERIAL_MV(",", (int)refine[i].y);
+          SERIAL_MV(" ", plane_z(refine[i].x + 0.5f, refine[i].y + 0.5f) + refine[i].z * (ABL_MESH_UNIT), 3);
+        }
+        SERIAL_EOL();
+      }
+    #endif
   }
 
   #if ENABLED(ABL_BILINEAR_SUBDIVISION)
@@ -231,6 +267,14 @@
 
   #endif // ABL_BILINEAR_SUBDIVISION
 
+  #if ENABLED(ABL_BILINEAR_SUBDIVISION)
+    #define ABL_BG_FACTOR(A)  bilinear_grid_factor_virt[A]
+    #define ABL_BG_GRID(X,Y)  z_values_virt[X][Y]
+  #else
+    #define ABL_BG_FACTOR(A)  bilinear_grid_factor[A]
+    #define ABL_BG_GRID(X,Y)  z_values[X][Y]
+  #endif
+
   // Refresh after other values have been updated
   void AutoBedLevel::refresh_bed_level() {
     bilinear_grid_factor[X_AXIS] = RECIPROCAL(bilinear_grid_spacing[X_AXIS]);
@@ -238,101 +282,301 @@
     #if ENABLED(ABL_BILINEAR_SUBDIVISION)
       virt_interpolate();
     #endif
+    #if ENABLED(ABL_COMPACT_MESH)
+      fit_mesh_plane();
+      #if ENABLED(ABL_REFINE)
+        ZERO(refined_cells);
+        NOMORE(refine_count, ABL_REFINE_POINTS);
+        for (uint8_t i = 0; i < refine_count; i++) {
+          if (refine[i].z == ABL_Z_INVALID) continue;
+          const uint16_t c = refine[i].y * (ABL_CELLS_X) + refine[i].x;
+          SBI(refined_cells[c >> 3], c & 7);
+        }
+      #endif
+    #else
+      refresh_cells();
+    #endif
   }
 
-  #if ENABLED(ABL_BILINEAR_SUBDIVISION)
-    #define ABL_BG_SPACING(A) bilinear_grid_spacing_virt[A]
-    #define ABL_BG_FACTOR(A)  bilinear_grid_factor_virt[A]
-    #define ABL_BG_POINTS_X   ABL_GRID_POINTS_VIRT_X
-    #define ABL_BG_POINTS_Y   ABL_GRID_POINTS_VIRT_Y
-    #define ABL_BG_GRID(X,Y)  z_values_virt[X][Y]
-  #else
-    #define ABL_BG_SPACING(A) bilinear_grid_spacing[A]
-    #define ABL_BG_FACTOR(A)  bilinear_grid_factor[A]
-    #define ABL_BG_POINTS_X   GRID_MAX_POINTS_X
-    #define ABL_BG_POINTS_Y   GRID_MAX_POINTS_Y
-    #define ABL_BG_GRID(X,Y)  z_values[X][Y]
-  #endif
+  #if ENABLED(ABL_COMPACT_MESH)
+
+    abl_z_t AutoBedLevel::encode_z(const float &z, const float &i, const float &j) {
+      if (isnan(z)) return ABL_Z_INVALID;
+      const float steps = (z - plane_z(i, j)) * (1.0f / (ABL_MESH_UNIT));
+      return LROUND(constrain(steps, -32767, 32767));
+    }
+
+    void AutoBedLevel::set_z_value(const uint8_t x, const uint8_t y, const float &z) {
+      z_values[x][y] = encode_z(z, x, y);
+    }
 
-  // Get the Z adjustment for non-linear bed leveling
-  float AutoBedLevel::bilinear_z_offset(const float raw[XYZ]) {
+    /**
+     * Fit the plane of the bed to the points (least squares)
+     * and store the points again as offsets from it, so the
+     * offsets stay small whatever the tilt of the bed.
+     */
+    void AutoBedLevel::fit_mesh_plane() {
+      struct linear_fit_data lsf_results;
+      incremental_LSF_reset(&lsf_results);
+      for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++)
+        for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++)
+          if (z_values[x][y] != ABL_Z_INVALID)
+            incremental_LSF(&lsf_results, x, y, z_value(x, y));
+
+      if (finish_incremental_LSF(&lsf_results)) return;   // Less than 3 points, keep the plane
+
+      const float old_plane[3] = { mesh_plane[0], mesh_plane[1], mesh_plane[2] };
+      #define OLD_PLANE_Z(I,J) (old_plane[0] * (I) + old_plane[1] * (J) + old_plane[2])
+
+      mesh_plane[0] = -lsf_results.A;
+      mesh_plane[1] = -lsf_results.B;
+      mesh_plane[2] = -lsf_results.D;
+
+      for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++)
+        for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++)
+          if (z_values[x][y] != ABL_Z_INVALID)
+            z_values[x][y] = encode_z(OLD_PLANE_Z(x, y) + z_values[x][y] * (ABL_MESH_UNIT), x, y);
+
+      #if ENABLED(ABL_REFINE)
+        for (uint8_t i = 0; i < refine_count; i++) {
+          if (refine[i].z == ABL_Z_INVALID) continue;
+          const float ci = refine[i].x + 0.5f, cj = refine[i].y + 0.5f;
+          refine[i].z = encode_z(OLD_PLANE_Z(ci, cj) + refine[i].z * (ABL_MESH_UNIT), ci, cj);
+        }
+      #endif
+    }
 
-    static float  z1, d2, z3, d4, L, D, ratio_x, ratio_y,
-                  last_x = -999.999, last_y = -999.999;
+    #if ENABLED(ABL_REFINE)
 
-    // Whole units for the grid line indices. Constrained within bounds.
-    static int8_t gridx, gridy, nextx, nexty,
-                  last_gridx = -99, last_gridy = -99;
+      uint8_t AutoBedLevel::select_refine_cells() {
 
-    // XY relative to the probed area
-    const float rx = raw[X_AXIS] - bilinear_start[X_AXIS],
-                ry = raw[Y_AXIS] - bilinear_start[Y_AXIS];
+        // Second difference of the grid at a point, taken on the
+        // nearest inner point on the grid borders. 0 if unknown.
+        auto d2 = [](const uint8_t x, const uint8_t y) -> int32_t {
+          int32_t d = 0;
+          #if GRID_MAX_POINTS_X > 2
+            const uint8_t xi = constrain(x, 1, GRID_MAX_POINTS_X - 2);
+            if (z_values[xi - 1][y] != ABL_Z_INVALID && z_values[xi][y] != ABL_Z_INVALID && z_values[xi + 1][y] != ABL_Z_INVALID)
+              d += int32_t(z_values[xi - 1][y]) - 2 * int32_t(z_values[xi][y]) + z_values[xi + 1][y];
+          #endif
+          #if GRID_MAX_POINTS_Y > 2
+            const uint8_t yi = constrain(y, 1, GRID_MAX_POINTS_Y - 2);
+            if (z_values[x][yi - 1] != ABL_Z_INVALID && z_values[x][yi] != ABL_Z_INVALID && z_values[x][yi + 1] != ABL_Z_INVALID)
+              d += int32_t(z_values[x][yi - 1]) - 2 * int32_t(z_values[x][yi]) + z_values[x][yi + 1];
+          #endif
+          return d;
+        };
 
-    if (last_x != rx) {
-      last_x = rx;
-      ratio_x = rx * ABL_BG_FACTOR(X_AXIS);
-      const float gx = constrain(FLOOR(ratio_x), 0, ABL_BG_POINTS_X - 1);
-      ratio_x -= gx;      // Subtract whole to get the ratio within the grid box
-      NOLESS(ratio_x, 0); // Never < 0.0. (> 1.0 is ok when nextx==gridx.)
-      gridx = gx;
-      nextx = MIN(gridx + 1, ABL_BG_POINTS_X - 1);
-    }
+        // The bilinear surface misses the center of a cell by about
+        // (Zxx + Zyy) / 8, here averaged on the four corners
+        constexpr int32_t threshold = (ABL_REFINE_THRESHOLD) * 32 / (ABL_MESH_UNIT);
+
+        int32_t error[ABL_REFINE_POINTS];
+        refine_count = 0;
+
+        for (uint8_t y = 0; y < ABL_CELLS_Y; y++) {
+          for (uint8_t x = 0; x < ABL_CELLS_X; x++) {
+
+            if ( z_values[x][y]     == ABL_Z_INVALID || z_values[x + 1][y]     == ABL_Z_INVALID
+              || z_values[x][y + 1] == ABL_Z_INVALID || z_values[x + 1][y + 1] == ABL_Z_INVALID
+            ) continue;
+
+            const int32_t e = ABS(d2(x, y) + d2(x + 1, y) + d2(x, y + 1) + d2(x + 1, y + 1));
+            if (e <= threshold) continue;
 
-    if (last_y != ry || last_gridx != gridx) {
+            // Keep the list sorted by error, drop the smallest when full
+            uint8_t i = refine_count < ABL_REFINE_POINTS ? refine_count++ : ABL_REFINE_POINTS;
+            for (; i > 0 && error[i - 1] < e; i--) {
+              if (i < ABL_REFINE_POINTS) {
+                error[i] = error[i - 1];
+                refine[i] = refine[i - 1];
+              }
+            }
+            if (i < ABL_REFINE_POINTS) {
+              error[i] = e;
+              refine[i].x = x;
+              refine[i].y = y;
+            }
+          }
+        }
+
+        // Probe them in grid order
+        for (uint8_t i = 1; i < refine_count; i++) {
+          const abl_refine_t r = refine[i];
+          uint8_t j = i;
+          for (; j > 0 && (refine[j - 1].y > r.y || (refine[j - 1].y == r.y && refine[j - 1].x > r.x)); j--)
+            refine[j] = refine[j - 1];
+          refine[j] = r;
+        }
 
-      if (last_y != ry) {
-        last_y = ry;
-        ratio_y = ry * ABL_BG_FACTOR(Y_AXIS);
-        const float gy = constrain(FLOOR(ratio_y), 0, ABL_BG_POINTS_Y - 1);
-        ratio_y -= gy;
-        NOLESS(ratio_y, 0);
-        gridy = gy;
-        nexty = MIN(gridy + 1, ABL_BG_POINTS_Y - 1);
+        for (uint8_t i = 0; i < refine_count; i++) refine[i].z = ABL_Z_INVALID;
+
+        return refine_count;
+      }
+
+      void AutoBedLevel::set_refine_z(const uint8_t i, const float &z) {
+        refine[i].z = encode_z(z, refine[i].x + 0.5f, refine[i].y + 0.5f);
       }
 
-      if (last_gridx != gridx || last_gridy != gridy) {
-        last_gridx = gridx;
-        last_gridy = gridy;
-        // Z at the box corners
-        z1 = ABL_BG_GRID(gridx, gridy);       // left-front
-        d2 = ABL_BG_GRID(gridx, nexty) - z1;  // left-back (delta)
-        z3 = ABL_BG_GRID(nextx, gridy);       // right-front
-        d4 = ABL_BG_GRID(nextx, nexty) - z3;  // right-back (delta)
+    #endif // ABL_REFINE
+
+    // Get the Z adjustment for non-linear bed leveling
+    float AutoBedLevel::bilinear_z_offset(const float raw[XYZ]) {
+
+      // Position in grid units, constrained to the grid so out of it
+      // the edge value is held
+      float gx = (raw[X_AXIS] - bilinear_start[X_AXIS]) * bilinear_grid_factor[X_AXIS],
+            gy = (raw[Y_AXIS] - bilinear_start[Y_AXIS]) * bilinear_grid_factor[Y_AXIS];
+      LIMIT(gx, 0, ABL_CELLS_X);
+      LIMIT(gy, 0, ABL_CELLS_Y);
+
+      const uint8_t cx = MIN(uint8_t(gx), ABL_CELLS_X - 1),
+                    cy = MIN(uint8_t(gy), ABL_CELLS_Y - 1);
+
+      const float plane = plane_z(gx, gy);
+      gx -= cx;
+      gy -= cy;
+
+      // Offsets at the corners
+      const int16_t z1 = z_values[cx    ][cy    ],   // left-front
+                    z2 = z_values[cx    ][cy + 1],   // left-back
+                    z3 = z_values[cx + 1][cy    ],   // right-front
+                    z4 = z_values[cx + 1][cy + 1];   // right-back
+
+      float offset = z1 + (z3 - z1) * gx + ((z2 - z1) + (int32_t(z4) - z3 - z2 + z1) * gx) * gy;
+
+      #if ENABLED(ABL_REFINE)
+        if (is_refined(cx, cy)) {
+          for (uint8_t i = 0; i < refine_count; i++) {
+            if (refine[i].x == cx && refine[i].y == cy) {
+              const float bump = 16.0f * gx * (1.0f - gx) * gy * (1.0f - gy);
+              offset += (refine[i].z - (int32_t(z1) + z2 + z3 + z4) * 0.25f) * bump;
+              break;
+            }
+          }
+        }
+      #endif
+
+      return plane + offset * (ABL_MESH_UNIT);
+    }
+
+  #else // !ABL_COMPACT_MESH
+
+    // Convert the grid into one bilinear surface per cell
+    void AutoBedLevel::refresh_cells() {
+      for (uint8_t y = 0; y < ABL_CELLS_Y; y++) {
+        for (uint8_t x = 0; x < ABL_CELLS_X; x++) {
+          abl_cell_t &cell = cells[y][x];
+          const float z1 = ABL_BG_GRID(x,     y    ),   // left-front
+                      z2 = ABL_BG_GRID(x,     y + 1),   // left-back
+                      z3 = ABL_BG_GRID(x + 1, y    ),   // right-front
+                      z4 = ABL_BG_GRID(x + 1, y + 1);   // right-back
+          cell.z0  = z1;
+          cell.dx  = z3 - z1;
+          cell.dy  = z2 - z1;
+          cell.dxy = (z4 - z3) - (z2 - z1);
+        }
       }
+    }
+
+    // Get the Z adjustment for non-linear bed leveling
+    float AutoBedLevel::bilinear_z_offset(const float raw[XYZ]) {
 
-      // Bilinear interpolate. Needed since ry or gridx has changed.
-                  L = z1 + d2 * ratio_y;   // Linear interp. LF -> LB
-      const float R = z3 + d4 * ratio_y;   // Linear interp. RF -> RB
+      // Position in grid units, constrained to the grid so out of it
+      // the edge value is held
+      float gx = (raw[X_AXIS] - bilinear_start[X_AXIS]) * ABL_BG_FACTOR(X_AXIS),
+            gy = (raw[Y_AXIS] - bilinear_start[Y_AXIS]) * ABL_BG_FACTOR(Y_AXIS);
+      LIMIT(gx, 0, ABL_CELLS_X);
+      LIMIT(gy, 0, ABL_CELLS_Y);
+
+      // The cell and the ratios within it
+      const uint8_t cx = MIN(uint8_t(gx), ABL_CELLS_X - 1),
+                    cy = MIN(uint8_t(gy), ABL_CELLS_Y - 1);
+      gx -= cx;
+      gy -= cy;
+
+      const abl_cell_t &cell = cells[cy][cx];
+      return cell.z0 + cell.dx * gx + (cell.dy + cell.dxy * gx) * gy;
+    }
 
-      D = R - L;
+  #endif // !ABL_COMPACT_MESH
+
+  /**
+   * Walk a line through the cells, merging the crossings of the
+   * X and Y borders. The borders are the inner grid lines, out of
+   * the grid the correction is held so there is nothing to split.
+   */
+  uint8_t AutoBedLevel::line_crossings(const float p1[XYZ], const float p2[XYZ], float ratio[ABL_LINE_CROSSINGS]) {
+
+    // Grid position, in half cells when refined cells are split at the middle
+    const float gx1 = (p1[X_AXIS] - bilinear_start[X_AXIS]) * ABL_BG_FACTOR(X_AXIS) * (ABL_LINE_DIVS),
+                gy1 = (p1[Y_AXIS] - bilinear_start[Y_AXIS]) * ABL_BG_FACTOR(Y_AXIS) * (ABL_LINE_DIVS),
+                gx2 = (p2[X_AXIS] - bilinear_start[X_AXIS]) * ABL_BG_FACTOR(X_AXIS) * (ABL_LINE_DIVS),
+                gy2 = (p2[Y_AXIS] - bilinear_start[Y_AXIS]) * ABL_BG_FACTOR(Y_AXIS) * (ABL_LINE_DIVS),
+                dgx = gx2 - gx1, dgy = gy2 - gy1;
+
+    constexpr int8_t x_lines = (ABL_CELLS_X) * (ABL_LINE_DIVS) - 1,
+                     y_lines = (ABL_CELLS_Y) * (ABL_LINE_DIVS) - 1;
+
+    // Inner grid lines crossed, in the order of the walk. The ends of a
+    // line far off the mesh are past the int8_t range, so keep 16 bits.
+    int16_t x_line = 0, x_end = 0,
+            y_line = 0, y_end = 0;
+    int8_t  x_dir = 0, y_dir = 0;
+
+    if (dgx > 0) {
+      x_dir = 1;
+      x_line = MAX(int16_t(FLOOR(gx1)) + 1, 1);
+      x_end = MIN(int16_t(CEIL(gx2)) - 1, x_lines);
+    }
+    else if (dgx < 0) {
+      x_dir = -1;
+      x_line = MIN(int16_t(CEIL(gx1)) - 1, x_lines);
+      x_end = MAX(int16_t(FLOOR(gx2)) + 1, 1);
+    }
+    if (dgy > 0) {
+      y_dir = 1;
+      y_line = MAX(int16_t(FLOOR(gy1)) + 1, 1);
+      y_end = MIN(int16_t(CEIL(gy2)) - 1, y_lines);
+    }
+    else if (dgy < 0) {
+      y_dir = -1;
+      y_line = MIN(int16_t(CEIL(gy1)) - 1, y_lines);
+      y_end = MAX(int16_t(FLOOR(gy2)) + 1, 1);
     }
 
-    const float offset = L + ratio_x * D;   // the offset almost always changes
-
-    /*
-    static float last_offset = 0;
-    if (ABS(last_offset - offset) > 0.2) {
-      SERIAL_MSG("Sudden Shift at ");
-      SERIAL_MV("x=", rx);
-      SERIAL_MV(" / ", ABL_BG_SPACING(X_AXIS));
-      SERIAL_EMV(" -> gridx=", gridx);
-      SERIAL_MV(" y=", ry);
-      SERIAL_MV(" / ", ABL_BG_SPACING(Y_AXIS));
-      SERIAL_EMV(" -> gridy=", gridy);
-      SERIAL_MV(" ratio_x=", ratio_x);
-      SERIAL_EMV(" ratio_y=", ratio_y);
-      SERIAL_MV(" z1=", z1);
-      SERIAL_MV(" d2=", d2);
-      SERIAL_MV(" z3=", z3);
-      SERIAL_EMV(" d4=", d4);
-      SERIAL_MV(" L=", L);
-      SERIAL_MV(" R=", R);
-      SERIAL_EMV(" offset=", offset);
+    #define LINES_LEFT(A) (A##_dir && (A##_line - A##_end) * A##_dir <= 0)
+
+    uint8_t count = 0;
+    float last = 0.0f;
+    while (LINES_LEFT(x) || LINES_LEFT(y)) {
+      const float tx = LINES_LEFT(x) ? (x_line - gx1) / dgx : 2.0f,
+                  ty = LINES_LEFT(y) ? (y_line - gy1) / dgy : 2.0f;
+      float t;
+      #if ENABLED(ABL_REFINE)
+        int8_t mid_x = -1, mid_y = -1;        // Cell of a middle line crossing
+        if (tx <= ty) {
+          t = tx;
+          if (TEST(x_line, 0)) { mid_x = x_line >> 1; mid_y = constrain(int16_t(gy1 + dgy * t) >> 1, 0, ABL_CELLS_Y - 1); }
+          x_line += x_dir;
+        }
+        else {
+          t = ty;
+          if (TEST(y_line, 0)) { mid_y = y_line >> 1; mid_x = constrain(int16_t(gx1 + dgx * t) >> 1, 0, ABL_CELLS_X - 1); }
+          y_line += y_dir;
+        }
+        if (mid_x >= 0 && !is_refined(mid_x, mid_y)) continue;   // Middle line of a plain cell
+      #else
+        if (tx <= ty) { t = tx; x_line += x_dir; }
+        else          { t = ty; y_line += y_dir; }
+      #endif
+      if (t <= last + 0.000001f) continue;   // Through a grid point, already split
+
+      ratio[count] = last = t;
+      if (++count >= ABL_LINE_CROSSINGS) break;
     }
-    last_offset = offset;
-    */
 
-    return offset;
+    return count;
   }
 
   #if !IS_KINEMATIC
@@ -341,65 +585,25 @@
      * Prepare a bilinear-leveled linear move on Cartesian,
      * splitting the move where it crosses mesh borders.
      */
-    void AutoBedLevel::bilinear_line_to_destination(float fr_mm_s, uint16_t x_splits/*= 0xFFFF*/, uint16_t y_splits/*= 0xFFFF*/) {
-
-      int cx1 = (mechanics.current_position[X_AXIS] - bilinear_start[X_AXIS]) * ABL_BG_FACTOR(X_AXIS),
-          cy1 = (mechanics.current_position[Y_AXIS] - bilinear_start[Y_AXIS]) * ABL_BG_FACTOR(Y_AXIS),
-          cx2 = (mechanics.destination[X_AXIS]      - bilinear_start[X_AXIS]) * ABL_BG_FACTOR(X_AXIS),
-          cy2 = (mechanics.destination[Y_AXIS]      - bilinear_start[Y_AXIS]) * ABL_BG_FACTOR(Y_AXIS);
-
-      LIMIT(cx1, 0, ABL_BG_POINTS_X - 2);
-      LIMIT(cy1, 0, ABL_BG_POINTS_Y - 2);
-      LIMIT(cx2, 0, ABL_BG_POINTS_X - 2);
-      LIMIT(cy2, 0, ABL_BG_POINTS_Y - 2);
-
-      if (cx1 == cx2 && cy1 == cy2) {
-        // Start and end on same mesh square
-        mechanics.buffer_line_to_destination(fr_mm_s);
-        mechanics.set_current_to_destination();
-        return;
-      }
-
-      #define LINE_SEGMENT_END(A) (mechanics.current_position[_AXIS(A)] + (mechanics.destination[_AXIS(A)] - mechanics.current_position[_AXIS(A)]) * normalized_dist)
+    void AutoBedLevel::bilinear_line_to_destination(const float fr_mm_s) {
 
-      float normalized_dist, end[XYZE];
-      const int8_t gcx = MAX(cx1, cx2), gcy = MAX(cy1, cy2);
+      float ratio[ABL_LINE_CROSSINGS];
+      const uint8_t count = line_crossings(mechanics.current_position, mechanics.destination, ratio);
 
-      // Crosses on the X and not already split on this X?
-      // The x_splits flags are insurance against rounding errors.
-      if (cx2 != cx1 && TEST(x_splits, gcx)) {
-        // Split on the X grid line
-        CBI(x_splits, gcx);
+      if (count) {
+        float start[XYZE], end[XYZE];
+        COPY_ARRAY(start, mechanics.current_position);
         COPY_ARRAY(end, mechanics.destination);
-        mechanics.destination[X_AXIS] = bilinear_start[X_AXIS] + ABL_BG_SPACING(X_AXIS) * gcx;
-        normalized_dist = (mechanics.destination[X_AXIS] - mechanics.current_position[X_AXIS]) / (end[X_AXIS] - mechanics.current_position[X_AXIS]);
-        mechanics.destination[Y_AXIS] = LINE_SEGMENT_END(Y);
-      }
-      // Crosses on the Y and not already split on this Y?
-      else if (cy2 != cy1 && TEST(y_splits, gcy)) {
-        CBI(y_splits, gcy);
-        COPY_ARRAY(end, mechanics.destination);
-        mechanics.destination[Y_AXIS] = bilinear_start[Y_AXIS] + ABL_BG_SPACING(Y_AXIS) * gcy;
-        normalized_dist = (mechanics.destination[Y_AXIS] - mechanics.current_position[Y_AXIS]) / (end[Y_AXIS] - mechanics.current_position[Y_AXIS]);
-        mechanics.destination[X_AXIS] = LINE_SEGMENT_END(X);
-      }
-      else {
-        // Must already have been split on these border(s)
-        // This should be a rare case.
-        mechanics.buffer_line_to_destination(fr_mm_s);
-        mechanics.set_current_to_destination();
-        return;
+        for (uint8_t i = 0; i < count; i++) {
+          LOOP_XYZE(axis) mechanics.destination[axis] = start[axis] + (end[axis] - start[axis]) * ratio[i];
+          mechanics.buffer_line_to_destination(fr_mm_s);
+          mechanics.set_current_to_destination();
+        }
+        COPY_ARRAY(mechanics.destination, end);
       }
 
-      mechanics.destination[Z_AXIS] = LINE_SEGMENT_END(Z);
-      mechanics.destination[E_AXIS] = LINE_SEGMENT_END(E);
-
-      // Do the split and look for more borders
-      bilinear_line_to_destination(fr_mm_s, x_splits, y_splits);
-
-      // Restore destination from stack
-      COPY_ARRAY(mechanics.destination, end);
-      bilinear_line_to_destination(fr_mm_s, x_splits, y_splits);
+      mechanics.buffer_line_to_destination(fr_mm_s);
+      mechanics.set_current_to_destination();
     }
 
   #endif // !IS_KINEMATIC
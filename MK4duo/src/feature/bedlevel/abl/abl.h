@@ -21,6 +21,62 @@
  */
 #pragma once
 
+#if ENABLED(ABL_BILINEAR_SUBDIVISION)
+  #define ABL_GRID_POINTS_VIRT_X (GRID_MAX_POINTS_X - 1) * (BILINEAR_SUBDIVISIONS) + 1
+  #define ABL_GRID_POINTS_VIRT_Y (GRID_MAX_POINTS_Y - 1) * (BILINEAR_SUBDIVISIONS) + 1
+  #define ABL_CELLS_X ((ABL_GRID_POINTS_VIRT_X) - 1)
+  #define ABL_CELLS_Y ((ABL_GRID_POINTS_VIRT_Y) - 1)
+#else
+  #define ABL_CELLS_X ((GRID_MAX_POINTS_X) - 1)
+  #define ABL_CELLS_Y ((GRID_MAX_POINTS_Y) - 1)
+#endif
+
+#if ENABLED(ABL_COMPACT_MESH) && ABL_REFINE_POINTS > 0
+  #define ABL_REFINE      1
+  #define ABL_LINE_DIVS   2   // Refined cells are also split at their middle lines
+#else
+  #define ABL_LINE_DIVS   1
+#endif
+
+// Most cell borders a line can cross inside the grid (+1, never empty)
+#define ABL_LINE_CROSSINGS ((ABL_CELLS_X + ABL_CELLS_Y) * (ABL_LINE_DIVS) - 1)
+
+#if ENABLED(ABL_COMPACT_MESH)
+
+  /**
+   * Grid points are stored as offsets from the plane of the bed
+   * in ABL_MESH_UNIT steps, ABL_Z_INVALID for a point not probed.
+   */
+  typedef int16_t abl_z_t;
+  #define ABL_Z_INVALID INT16_MIN
+
+  /**
+   * Center of a cell probed because the grid is curved there.
+   * The bilinear surface of the cell is raised by a bump that
+   * meets the center and is zero on the cell borders.
+   */
+  typedef struct {
+    uint8_t x, y;   // Cell
+    abl_z_t z;      // Z at the center, as the grid points
+  } abl_refine_t;
+
+#else
+
+  typedef float abl_z_t;
+
+  /**
+   * Bilinear surface of a grid cell, with x and y the ratios inside the cell
+   *  Z = z0 + dx * x + (dy + dxy * x) * y
+   */
+  typedef struct {
+    float z0,   // Z at the front-left corner
+          dx,   // Z change along X
+          dy,   // Z change along Y on the left side
+          dxy;  // Twist, change of dy along X
+  } abl_cell_t;
+
+#endif
+
 class AutoBedLevel {
 
   public: /** Constructor */
@@ -31,15 +87,32 @@ class AutoBedLevel {
 
     static int    bilinear_grid_spacing[2],
                   bilinear_start[2];
-    static float  z_values[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y];
+    static abl_z_t z_values[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y];
+
+    #if ENABLED(ABL_COMPACT_MESH)
+      // Plane the points are stored from, Z = [0] * i + [1] * j + [2] with i j the grid indexes
+      static float mesh_plane[3];
+      #if ENABLED(ABL_REFINE)
+        static uint8_t      refine_count;
+        static abl_refine_t refine[ABL_REFINE_POINTS];
+      #endif
+    #endif
 
   private: /** Private Parameters */
 
     static float  bilinear_grid_factor[2];
 
+    #if ENABLED(ABL_COMPACT_MESH)
+      #if ENABLED(ABL_REFINE)
+        // One bit per cell, set if the cell has a probed center
+        static uint8_t refined_cells[(ABL_CELLS_X * ABL_CELLS_Y + 7) / 8];
+      #endif
+    #else
+      // Cells of the (subdivided) grid, rows along X, refreshed by refresh_bed_level
+      static abl_cell_t cells[ABL_CELLS_Y][ABL_CELLS_X];
+    #endif
+
     #if ENABLED(ABL_BILINEAR_SUBDIVISION)
-      #define ABL_GRID_POINTS_VIRT_X (GRID_MAX_POINTS_X - 1) * (BILINEAR_SUBDIVISIONS) + 1
-      #define ABL_GRID_POINTS_VIRT_Y (GRID_MAX_POINTS_Y - 1) * (BILINEAR_SUBDIVISIONS) + 1
       #define ABL_TEMP_POINTS_X (GRID_MAX_POINTS_X + 2)
       #define ABL_TEMP_POINTS_Y (GRID_MAX_POINTS_Y + 2)
 
@@ -53,6 +126,56 @@ class AutoBedLevel {
     static float bilinear_z_offset(const float raw[XYZ]);
     static void refresh_bed_level();
 
+    // Set all the points as not probed
+    static void reset_mesh();
+
+    #if ENABLED(ABL_COMPACT_MESH)
+
+      FORCE_INLINE static float plane_z(const float i, const float j) {
+        return mesh_plane[0] * i + mesh_plane[1] * j + mesh_plane[2];
+      }
+
+      FORCE_INLINE static float z_value(const uint8_t x, const uint8_t y) {
+        return z_values[x][y] == ABL_Z_INVALID ? NAN : plane_z(x, y) + z_values[x][y] * (ABL_MESH_UNIT);
+      }
+
+      static void set_z_value(const uint8_t x, const uint8_t y, const float &z);
+
+      // Move the whole grid up or down
+      FORCE_INLINE static void offset_mesh(const float &z) { mesh_plane[2] += z; }
+
+      #if ENABLED(ABL_REFINE)
+
+        /**
+         * Choose the cells to probe at the center, where the estimated
+         * error of the bilinear surface is over ABL_REFINE_THRESHOLD.
+         * Fill refine with the most curved ones, in grid order, and
+         * return their number. The centers are set as not probed.
+         */
+        static uint8_t select_refine_cells();
+
+        FORCE_INLINE static float refine_x(const uint8_t i) { return bilinear_start[X_AXIS] + (refine[i].x + 0.5f) * bilinear_grid_spacing[X_AXIS]; }
+        FORCE_INLINE static float refine_y(const uint8_t i) { return bilinear_start[Y_AXIS] + (refine[i].y + 0.5f) * bilinear_grid_spacing[Y_AXIS]; }
+
+        static void set_refine_z(const uint8_t i, const float &z);
+
+      #endif
+
+    #else
+
+      FORCE_INLINE static float z_value(const uint8_t x, const uint8_t y) { return z_values[x][y]; }
+      FORCE_INLINE static void set_z_value(const uint8_t x, const uint8_t y, const float &z) { z_values[x][y] = z; }
+
+    #endif
+
+    /**
+     * Walk the XY line from p1 to p2 through the grid cells.
+     * Fill ratio with the position along the line of every cell
+     * border crossed, in order. Return the number of crossings.
+     * The planner levels the end of every split itself.
+     */
+    static uint8_t line_crossings(const float p1[XYZ], const float p2[XYZ], float ratio[ABL_LINE_CROSSINGS]);
+
     /**
      * Fill in the unprobed points (corners of circular print surface)
      * using linear extrapolation, away from the center.
@@ -67,11 +190,24 @@ class AutoBedLevel {
     #endif
 
     #if !IS_KINEMATIC
-      void bilinear_line_to_destination(float fr_mm_s, uint16_t x_splits=0xFFFF, uint16_t y_splits=0xFFFF);
+      static void bilinear_line_to_destination(const float fr_mm_s);
     #endif
 
   private: /** Private Function */
 
+    #if ENABLED(ABL_COMPACT_MESH)
+      static void fit_mesh_plane();
+      static abl_z_t encode_z(const float &z, const float &i, const float &j);
+      #if ENABLED(ABL_REFINE)
+        FORCE_INLINE static bool is_refined(const uint8_t x, const uint8_t y) {
+          const uint16_t c = y * (ABL_CELLS_X) + x;
+          return TEST(refined_cells[c >> 3], c & 7);
+        }
+      #endif
+    #else
+      static void refresh_cells();
+    #endif
+
     /**
      * Extrapolate a single point from its neighbors
      */
@@ -178,12 +178,6 @@ void Bedlevel::set_bed_leveling_enabled(const bool enable/*=true*/) {
 
     planner.synchronize();
 
-    #if ENABLED(AUTO_BED_LEVELING_BILINEAR)
-      // Force abl.bilinear_z_offset to re-calculate next time
-      const float reset[XYZ] = { -9999.999, -9999.999, 0 };
-      (void)abl.bilinear_z_offset(reset);
-    #endif
-
     if (flag.leveling_active) {      // leveling from on to off
       // change unleveled current_position to physical current_position without moving steppers.
       apply_leveling(mechanics.current_position[X_AXIS], mechanics.current_position[Y_AXIS], mechanics.current_position[Z_AXIS]);
@@ -241,9 +235,7 @@ void Bedlevel::reset() {
   #elif ENABLED(AUTO_BED_LEVELING_BILINEAR)
     abl.bilinear_start[X_AXIS] = abl.bilinear_start[Y_AXIS] =
     abl.bilinear_grid_spacing[X_AXIS] = abl.bilinear_grid_spacing[Y_AXIS] = 0;
-    for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++)
-      for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++)
-        abl.z_values[x][y] = NAN;
+    abl.reset_mesh();
   #elif ABL_PLANAR
     matrix.set_to_identity();
   #endif
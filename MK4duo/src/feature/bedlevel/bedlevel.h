@@ -40,7 +40,9 @@
 
 #if HAS_LEVELING
 
-#if HAS_MESH
+#if ENABLED(ABL_COMPACT_MESH)
+  #define Z_VALUES(X,Y) abl.z_value(X,Y)
+#elif HAS_MESH
   #define Z_VALUES(X,Y) Z_VALUES_ARR[X][Y]
 #endif
 
@@ -56,6 +58,8 @@ typedef struct {
 #if ABL_PLANAR || ENABLED(AUTO_BED_LEVELING_UBL)
   #include "math/vector_3.h"
   #include "math/least_squares_fit.h"
+#elif ENABLED(ABL_COMPACT_MESH)
+  #include "math/least_squares_fit.h"
 #endif
 #if ENABLED(AUTO_BED_LEVELING_BILINEAR)
   #include "abl/abl.h"
@@ -34,7 +34,7 @@
 
 #include "../../../../MK4duo.h"
 
-#if ABL_PLANAR || ENABLED(AUTO_BED_LEVELING_UBL)
+#if ABL_PLANAR || ENABLED(AUTO_BED_LEVELING_UBL) || ENABLED(ABL_COMPACT_MESH)
 
   #include "least_squares_fit.h"
 
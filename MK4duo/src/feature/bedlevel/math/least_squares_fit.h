@@ -33,7 +33,7 @@
  *
  */
 
-#if ABL_PLANAR || ENABLED(AUTO_BED_LEVELING_UBL)
+#if ABL_PLANAR || ENABLED(AUTO_BED_LEVELING_UBL) || ENABLED(ABL_COMPACT_MESH)
 
   struct linear_fit_data {
     float xbar, ybar, zbar,
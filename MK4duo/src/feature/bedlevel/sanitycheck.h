@@ -69,6 +69,23 @@ static_assert(1 >= 0
   #endif
 #endif
 
+/**
+ * Compact Bilinear grid
+ */
+#if ENABLED(ABL_COMPACT_MESH)
+  #if DISABLED(AUTO_BED_LEVELING_BILINEAR)
+    #error "DEPENDENCY ERROR: ABL_COMPACT_MESH requires AUTO_BED_LEVELING_BILINEAR."
+  #elif ENABLED(ABL_BILINEAR_SUBDIVISION)
+    #error "DEPENDENCY ERROR: ABL_COMPACT_MESH is not compatible with ABL_BILINEAR_SUBDIVISION."
+  #elif ENABLED(MESH_EDIT_MENU)
+    #error "DEPENDENCY ERROR: ABL_COMPACT_MESH is not compatible with MESH_EDIT_MENU."
+  #elif !WITHIN(ABL_REFINE_POINTS, 0, 255)
+    #error "DEPENDENCY ERROR: ABL_REFINE_POINTS must be between 0 and 255."
+  #elif ABL_REFINE_POINTS > 0 && ENABLED(PROBE_MANUALLY)
+    #error "DEPENDENCY ERROR: ABL_REFINE_POINTS requires a probe, set it to 0 with PROBE_MANUALLY."
+  #endif
+#endif
+
 /**
  * Mesh Bed Leveling
  */
@@ -78,6 +78,9 @@
       mechanics.current_position[E_AXIS]
     };
 
+    // Let the planner take the segments in batches
+    planner.begin_batch(UBL_SEGMENT_BATCH);
+
     // Only compute leveling per segment if ubl active and target below z_fade_height.
     if (!bedlevel.flag.leveling_active || !bedlevel.leveling_active_at_z(rtarget[Z_AXIS])) {   // no mesh leveling
       while (--segments) {
@@ -85,6 +88,7 @@
         planner.buffer_line(raw, feedrate, tools.extruder.active, segment_xyz_mm);
       }
       planner.buffer_line(rtarget, feedrate, tools.extruder.active, segment_xyz_mm);
+      planner.end_batch();
       return false; // moved but did not set_current_from_destination();
     }
 
@@ -94,30 +98,27 @@
       const float fade_scaling_factor = bedlevel.fade_scaling_factor_for_z(rtarget[Z_AXIS]);
     #endif
 
+    // Segment step in mesh cells
+    const float step_x = diff[X_AXIS] * (1.0f / (MESH_X_DIST)),
+                step_y = diff[Y_AXIS] * (1.0f / (MESH_Y_DIST));
+
     // increment to first segment destination
     LOOP_XYZE(i) raw[i] += diff[i];
 
-    for(;;) {  // for each mesh cell encountered during the move
-
-      // Compute mesh cell invariants that remain constant for all segments within cell.
-      // Note for cell index, if point is outside the mesh grid (in MESH_INSET perimeter)
-      // the bilinear interpolation from the adjacent cell within the mesh will still work.
-      // Inner loop will exit each time (because out of cell bounds) but will come back
-      // in top of loop and again re-find same adjacent cell and use it, just less efficient
-      // for mesh inset area.
+    for (;;) {  // for each mesh cell encountered during the move
 
-      int8_t cell_xi = (raw[X_AXIS] - (MESH_MIN_X)) * (1.0 / (MESH_X_DIST)),
-             cell_yi = (raw[Y_AXIS] - (MESH_MIN_Y)) * (1.0 / (MESH_Y_DIST));
+      // Position in mesh cells. Out of the mesh (in the MESH_INSET perimeter)
+      // the nearest cell is extended, so it is used until the move gets back
+      // into the mesh instead of being looked up again for every segment.
+      const float gx = (raw[X_AXIS] - (MESH_MIN_X)) * (1.0f / (MESH_X_DIST)),
+                  gy = (raw[Y_AXIS] - (MESH_MIN_Y)) * (1.0f / (MESH_Y_DIST));
 
-      LIMIT(cell_xi, 0, (GRID_MAX_POINTS_X) - 1);
-      LIMIT(cell_yi, 0, (GRID_MAX_POINTS_Y) - 1);
-
-      const float x0 = mesh_index_to_xpos(cell_xi),   // 64 byte table lookup avoids mul+add
-                  y0 = mesh_index_to_ypos(cell_yi);
+      const int8_t cell_xi = constrain(int16_t(FLOOR(gx)), 0, (GRID_MAX_POINTS_X) - 2),
+                   cell_yi = constrain(int16_t(FLOOR(gy)), 0, (GRID_MAX_POINTS_Y) - 2);
 
       float z_x0y0 = z_values[cell_xi  ][cell_yi  ],  // z at lower left corner
-            z_x1y0 = z_values[cell_xi+1][cell_yi  ],  // z at upper left corner
-            z_x0y1 = z_values[cell_xi  ][cell_yi+1],  // z at lower right corner
+            z_x1y0 = z_values[cell_xi+1][cell_yi  ],  // z at lower right corner
+            z_x0y1 = z_values[cell_xi  ][cell_yi+1],  // z at upper left corner
             z_x1y1 = z_values[cell_xi+1][cell_yi+1];  // z at upper right corner
 
       if (isnan(z_x0y0)) z_x0y0 = 0;              // ideally activating bedlevel.active (G29 A)
@@ -125,65 +126,56 @@
       if (isnan(z_x0y1)) z_x0y1 = 0;              //   in order to avoid isnan tests per cell,
       if (isnan(z_x1y1)) z_x1y1 = 0;              //   thus guessing zero for undefined points
 
-      float cx = raw[X_AXIS] - x0,   // cell-relative x and y
-            cy = raw[Y_AXIS] - y0;
-
-      const float z_xmy0 = (z_x1y0 - z_x0y0) * (1.0 / (MESH_X_DIST)),   // z slope per x along y0 (lower left to lower right)
-                  z_xmy1 = (z_x1y1 - z_x0y1) * (1.0 / (MESH_X_DIST));   // z slope per x along y1 (upper left to upper right)
-
-            float z_cxy0 = z_x0y0 + z_xmy0 * cx;            // z height along y0 at cx (changes for each cx in cell)
-
-      const float z_cxy1 = z_x0y1 + z_xmy1 * cx,            // z height along y1 at cx
-                  z_cxyd = z_cxy1 - z_cxy0;                 // z height difference along cx from y0 to y1
-
-            float z_cxym = z_cxyd * (1.0 / (MESH_Y_DIST));  // z slope per y along cx from y0 to y1 (changes for each cx in cell)
-
-      //    float z_cxcy = z_cxy0 + z_cxym * cy;            // interpolated mesh z height along cx at cy (do inside the segment loop)
-
-      // As subsequent segments step through this cell, the z_cxy0 intercept will change
-      // and the z_cxym slope will change, both as a function of cx within the cell, and
-      // each change by a constant for fixed segment lengths.
-
-      const float z_sxy0 = z_xmy0 * diff[X_AXIS],                                     // per-segment adjustment to z_cxy0
-                  z_sxym = (z_xmy1 - z_xmy0) * (1.0 / (MESH_Y_DIST)) * diff[X_AXIS];  // per-segment adjustment to z_cxym
-
-      for(;;) {  // for all segments within this mesh cell
+      // Bilinear surface of the cell, with fx and fy the cell-relative position
+      //  z = z_x0y0 + z_dx * fx + (z_dy + z_dxy * fx) * fy
+      const float fx = gx - cell_xi,
+                  fy = gy - cell_yi,
+                  z_dx  = z_x1y0 - z_x0y0,
+                  z_dy  = z_x0y1 - z_x0y0,
+                  z_dxy = z_x1y1 - z_x0y1 - z_dx;
+
+      // The segments are evenly spaced, so along the line z is a quadratic
+      // of the segment number and is stepped with forward differences.
+      float z_cxcy = z_x0y0 + z_dx * fx + (z_dy + z_dxy * fx) * fy,
+            z_step = z_dx * step_x + z_dy * step_y + z_dxy * (fx * step_y + fy * step_x + step_x * step_y);
+      const float z_step2 = 2.0f * z_dxy * step_x * step_y;
+
+      // Segments after this one that still end in this cell
+      float in_cell = segments - 1;
+      if (step_x > 0 && cell_xi < (GRID_MAX_POINTS_X) - 2) NOMORE(in_cell, (cell_xi + 1 - gx) / step_x);
+      if (step_x < 0 && cell_xi > 0)                       NOMORE(in_cell, (gx - cell_xi) / -step_x);
+      if (step_y > 0 && cell_yi < (GRID_MAX_POINTS_Y) - 2) NOMORE(in_cell, (cell_yi + 1 - gy) / step_y);
+      if (step_y < 0 && cell_yi > 0)                       NOMORE(in_cell, (gy - cell_yi) / -step_y);
+
+      for (uint16_t cell_segments = in_cell;;) {  // for all segments within this mesh cell
 
         if (--segments == 0)                      // if this is last segment, use rtarget for exact
           COPY_ARRAY(raw, rtarget);
 
-        const float z_cxcy = (z_cxy0 + z_cxym * cy) // interpolated mesh z height along cx at cy
+        const float z = raw[Z_AXIS];
+        raw[Z_AXIS] += z_cxcy
           #if ENABLED(ENABLE_LEVELING_FADE_HEIGHT)
-            * fade_scaling_factor                   // apply fade factor to interpolated mesh height
+            * fade_scaling_factor                 // apply fade factor to interpolated mesh height
           #endif
         ;
-
-        const float z = raw[Z_AXIS];
-        raw[Z_AXIS] += z_cxcy;
         planner.buffer_line(raw, feedrate, tools.extruder.active, segment_xyz_mm);
         raw[Z_AXIS] = z;
 
-        if (segments == 0)                        // done with last segment
+        if (segments == 0) {                      // done with last segment
+          planner.end_batch();
           return false;                           // did not set_current_from_destination()
+        }
 
         LOOP_XYZE(i) raw[i] += diff[i];
 
-        cx += diff[X_AXIS];
-        cy += diff[Y_AXIS];
-
-        if (!WITHIN(cx, 0, MESH_X_DIST) || !WITHIN(cy, 0, MESH_Y_DIST)) // done within this cell, break to next
+        if (!cell_segments--)                     // done within this cell, break to next
           break;
 
-        // Next segment still within same mesh cell, adjust the per-segment
-        // slope and intercept to compute next z height.
-
-        z_cxy0 += z_sxy0;   // adjust z_cxy0 by per-segment z_sxy0
-        z_cxym += z_sxym;   // adjust z_cxym by per-segment z_sxym
+        z_cxcy += z_step;
+        z_step += z_step2;
 
       } // segment loop
     } // cell loop
-
-    return false; // caller will update current_position
   }
 
 #else
@@ -243,260 +235,113 @@
         return;
       }
 
-      FINAL_MOVE:
-
-      // The distance is always MESH_X_DIST so multiply by the constant reciprocal.
-      const float xratio = (end[X_AXIS] - mesh_index_to_xpos(cell_dest_xi)) * (1.0f / (MESH_X_DIST));
-
-      float z1 = z_values[cell_dest_xi    ][cell_dest_yi    ] + xratio *
-                (z_values[cell_dest_xi + 1][cell_dest_yi    ] - z_values[cell_dest_xi][cell_dest_yi    ]),
-            z2 = z_values[cell_dest_xi    ][cell_dest_yi + 1] + xratio *
-                (z_values[cell_dest_xi + 1][cell_dest_yi + 1] - z_values[cell_dest_xi][cell_dest_yi + 1]);
-
-      if (cell_dest_xi >= GRID_MAX_POINTS_X - 1) z1 = z2 = 0.0;
-
-      // X cell-fraction done. Interpolate the two Z offsets with the Y fraction for the final Z offset.
-      const float yratio = (end[Y_AXIS] - mesh_index_to_ypos(cell_dest_yi)) * (1.0f / (MESH_Y_DIST)),
-                  z0 = cell_dest_yi < GRID_MAX_POINTS_Y - 1 ? (z1 + (z2 - z1) * yratio) * bedlevel.fade_scaling_factor_for_z(end[Z_AXIS]) : 0.0;
-
-      // Undefined parts of the Mesh in z_values[][] are NAN.
-      // Replace NAN corrections with 0.0 to prevent NAN propagation.
-      planner.buffer_segment(end[X_AXIS], end[Y_AXIS], end[Z_AXIS] + (isnan(z0) ? 0.0 : z0), end[E_AXIS], feed_rate, extruder);
-
-      if (bedlevel.flag.g26_debug)
-        debug_current_and_destination(PSTR("FINAL_MOVE in ubl.line_to_destination_cartesian()"));
-
-      mechanics.set_current_to_destination();
-      return;
     }
+    else {
+
+      /**
+       * The move crosses one or more mesh lines. Walk them in the order they are met,
+       * stepping the line parameter t (0 at start, 1 at end) from one mesh line to the
+       * next with a constant increment per axis, and queue a segment at every crossing.
+       * The correction on a mesh line is a linear interpolation of the two mesh points
+       * around the crossing, so no cell is ever looked up from a position.
+       */
+
+      const float fade_scaling_factor = bedlevel.fade_scaling_factor_for_z(end[Z_AXIS]);
+
+      const float dx = end[X_AXIS] - start[X_AXIS],
+                  dy = end[Y_AXIS] - start[Y_AXIS],
+                  dz = end[Z_AXIS] - start[Z_AXIS],
+                  de = end[E_AXIS] - start[E_AXIS];
+
+      // Mesh lines to cross on each axis, the first of them and the cell on its near side
+      const int8_t  dxi = cell_dest_xi > cell_start_xi ? 1 : -1,
+                    dyi = cell_dest_yi > cell_start_yi ? 1 : -1;
+
+      uint8_t xi_cnt = ABS(cell_dest_xi - cell_start_xi),
+              yi_cnt = ABS(cell_dest_yi - cell_start_yi);
+
+      int8_t  line_xi = cell_start_xi + (dxi > 0),  // next X mesh line
+              line_yi = cell_start_yi + (dyi > 0),  // next Y mesh line
+              current_xi = cell_start_xi,           // cell column of the walk
+              current_yi = cell_start_yi;           // cell row of the walk
+
+      // t at the next crossing of each axis, and from one crossing to the next
+      float tx = xi_cnt ? (mesh_index_to_xpos(line_xi) - start[X_AXIS]) / dx : 2.0f,
+            ty = yi_cnt ? (mesh_index_to_ypos(line_yi) - start[Y_AXIS]) / dy : 2.0f;
+
+      const float tx_step = xi_cnt ? (MESH_X_DIST) / ABS(dx) : 0.0f,
+                  ty_step = yi_cnt ? (MESH_Y_DIST) / ABS(dy) : 0.0f;
+
+      // Let the planner take the segments in batches
+      planner.begin_batch(UBL_SEGMENT_BATCH);
+
+      float last_t = 0.0f;
+      while (xi_cnt || yi_cnt) {
+
+        float t, rx, ry, z0;
+
+        if (xi_cnt && tx <= ty) {
+          // Crossing an X Mesh Line next
+          t = tx;
+          rx = mesh_index_to_xpos(line_xi);
+          ry = start[Y_AXIS] + dy * t;
+          z0 = z_correction_for_y_on_vertical_mesh_line(ry, line_xi, current_yi);
+          current_xi += dxi;
+          line_xi += dxi;
+          tx += tx_step;
+          xi_cnt--;
+        }
+        else {
+          // Crossing a Y Mesh Line next
+          t = ty;
+          rx = start[X_AXIS] + dx * t;
+          ry = mesh_index_to_ypos(line_yi);
+          z0 = z_correction_for_x_on_horizontal_mesh_line(rx, current_xi, line_yi);
+          current_yi += dyi;
+          line_yi += dyi;
+          ty += ty_step;
+          yi_cnt--;
+        }
 
-    /**
-     * Past this point the move is known to cross one or more mesh lines. Check for the most common
-     * case - crossing only one X or Y line - after details are worked out to reduce computation.
-     */
-
-    const float dx = end[X_AXIS] - start[X_AXIS],
-                dy = end[Y_AXIS] - start[Y_AXIS];
-
-    const int left_flag = dx < 0.0 ? 1 : 0,
-              down_flag = dy < 0.0 ? 1 : 0;
-
-    const float adx = left_flag ? -dx : dx,
-                ady = down_flag ? -dy : dy;
-
-    const int dxi = cell_start_xi == cell_dest_xi ? 0 : left_flag ? -1 : 1,
-              dyi = cell_start_yi == cell_dest_yi ? 0 : down_flag ? -1 : 1;
-
-    /**
-     * Compute the extruder scaling factor for each partial move, checking for
-     * zero-length moves that would result in an infinite scaling factor.
-     * A float divide is required for this, but then it just multiplies.
-     * Also select a scaling factor based on the larger of the X and Y
-     * components. The larger of the two is used to preserve precision.
-     */
-
-    const bool use_x_dist = adx > ady;
-
-    float on_axis_distance = use_x_dist ? dx : dy,
-          e_position = end[E_AXIS] - start[E_AXIS],
-          z_position = end[Z_AXIS] - start[Z_AXIS];
-
-    const float e_normalized_dist = e_position / on_axis_distance,
-                z_normalized_dist = z_position / on_axis_distance;
-
-    int current_xi = cell_start_xi,
-        current_yi = cell_start_yi;
-
-    const float m = dy / dx,
-                c = start[Y_AXIS] - m * start[X_AXIS];
-
-    const bool inf_normalized_flag = (isinf(e_normalized_dist) != 0),
-               inf_m_flag = (isinf(m) != 0);
-
-    /**
-     * Handle vertical lines that stay within one column.
-     * These need not be perfectly vertical.
-     */
-    if (dxi == 0) {             // Vertical line?
-      current_yi += down_flag;  // Line going down? Just go to the bottom.
-      while (current_yi != cell_dest_yi + down_flag) {
-        current_yi += dyi;
-        const float next_mesh_line_y = mesh_index_to_ypos(current_yi);
-
-        /**
-         * Skip the calculations for an infinite slope.
-         * For others the next X is the same so this can continue.
-         * Calculate X at the next Y mesh line.
-         */
-        const float rx = inf_m_flag ? start[X_AXIS] : (next_mesh_line_y - c) / m;
-
-        float z0 = z_correction_for_x_on_horizontal_mesh_line(rx, current_xi, current_yi) * bedlevel.fade_scaling_factor_for_z(end[Z_AXIS]);
-
-        // Undefined parts of the Mesh in z_values[][] are NAN.
-        // Replace NAN corrections with 0.0 to prevent NAN propagation.
-        if (isnan(z0)) z0 = 0.0;
-
-        const float ry = mesh_index_to_ypos(current_yi);
-
-        /**
-         * Without this check, it's possible to generate a zero length move, as in the case where
-         * the line is heading down, starting exactly on a mesh line boundary. Since this is rare
-         * it might be fine to remove this check and let planner.buffer_segment() filter it out.
-         */
-        if (ry != start[Y_AXIS]) {
-          if (!inf_normalized_flag) {
-            on_axis_distance = use_x_dist ? rx - start[X_AXIS] : ry - start[Y_AXIS];
-            e_position = start[E_AXIS] + on_axis_distance * e_normalized_dist;
-            z_position = start[Z_AXIS] + on_axis_distance * z_normalized_dist;
-          }
-          else {
-            e_position = end[E_AXIS];
-            z_position = end[Z_AXIS];
-          }
-
-          planner.buffer_segment(rx, ry, z_position + z0, e_position, feed_rate, extruder);
-        } //else printf("FIRST MOVE PRUNED  ");
-      }
-
-      if (bedlevel.flag.g26_debug)
-        debug_current_and_destination(PSTR("vertical move done in ubl.line_to_destination_cartesian()"));
-
-      // At the final destination? Usually not, but when on a Y Mesh Line it's completed.
-      if (mechanics.current_position[X_AXIS] != end[X_AXIS] || mechanics.current_position[Y_AXIS] != end[Y_AXIS])
-        goto FINAL_MOVE;
-
-      mechanics.set_current_to_destination();
-      return;
-    }
-
-    /**
-     * Handle horizontal lines that stay within one row.
-     * These need not be perfectly horizontal.
-     */
-    if (dyi == 0) {             // Horizontal line?
-      current_xi += left_flag;  // Heading left? Just go to the left edge of the cell for the first move.
-      while (current_xi != cell_dest_xi + left_flag) {
-        current_xi += dxi;
-        const float next_mesh_line_x = mesh_index_to_xpos(current_xi),
-                    ry = m * next_mesh_line_x + c;   // Calculate Y at the next X mesh line
-
-        float z0 = z_correction_for_y_on_vertical_mesh_line(ry, current_xi, current_yi) * bedlevel.fade_scaling_factor_for_z(end[Z_AXIS]);
+        // A crossing through a mesh point, or on the start or end point, makes no segment
+        if (t <= last_t || t >= 1.0f) continue;
+        last_t = t;
 
         // Undefined parts of the Mesh in z_values[][] are NAN.
         // Replace NAN corrections with 0.0 to prevent NAN propagation.
+        z0 *= fade_scaling_factor;
         if (isnan(z0)) z0 = 0.0;
 
-        const float rx = mesh_index_to_xpos(current_xi);
-
-        /**
-         * Without this check, it's possible to generate a zero length move, as in the case where
-         * the line is heading left, starting exactly on a mesh line boundary. Since this is rare
-         * it might be fine to remove this check and let planner.buffer_segment() filter it out.
-         */
-        if (rx != start[X_AXIS]) {
-          if (!inf_normalized_flag) {
-            on_axis_distance = use_x_dist ? rx - start[X_AXIS] : ry - start[Y_AXIS];
-            e_position = start[E_AXIS] + on_axis_distance * e_normalized_dist;  // is based on X or Y because this is a horizontal move
-            z_position = start[Z_AXIS] + on_axis_distance * z_normalized_dist;
-          }
-          else {
-            e_position = end[E_AXIS];
-            z_position = end[Z_AXIS];
-          }
-
-          if (!planner.buffer_segment(rx, ry, z_position + z0, e_position, feed_rate, extruder))
-            break;
-        } //else printf("FIRST MOVE PRUNED  ");
+        if (!planner.buffer_segment(rx, ry, start[Z_AXIS] + dz * t + z0, start[E_AXIS] + de * t, feed_rate, extruder))
+          break;
       }
 
-      if (mechanics.current_position[X_AXIS] != end[X_AXIS] || mechanics.current_position[Y_AXIS] != end[Y_AXIS])
-        goto FINAL_MOVE;
+      planner.end_batch();
 
-      mechanics.set_current_to_destination();
-      return;
+      if (bedlevel.flag.g26_debug)
+        debug_current_and_destination(PSTR("mesh lines done in ubl.line_to_destination_cartesian()"));
     }
 
-    /**
-     *
-     * Handle the generic case of a line crossing both X and Y Mesh lines.
-     *
-     */
-
-    int xi_cnt = cell_start_xi - cell_dest_xi,
-        yi_cnt = cell_start_yi - cell_dest_yi;
-
-    if (xi_cnt < 0) xi_cnt = -xi_cnt;
-    if (yi_cnt < 0) yi_cnt = -yi_cnt;
+    // The distance is always MESH_X_DIST so multiply by the constant reciprocal.
+    const float xratio = (end[X_AXIS] - mesh_index_to_xpos(cell_dest_xi)) * (1.0f / (MESH_X_DIST));
 
-    current_xi += left_flag;
-    current_yi += down_flag;
+    float z1 = z_values[cell_dest_xi    ][cell_dest_yi    ] + xratio *
+              (z_values[cell_dest_xi + 1][cell_dest_yi    ] - z_values[cell_dest_xi][cell_dest_yi    ]),
+          z2 = z_values[cell_dest_xi    ][cell_dest_yi + 1] + xratio *
+              (z_values[cell_dest_xi + 1][cell_dest_yi + 1] - z_values[cell_dest_xi][cell_dest_yi + 1]);
 
-    while (xi_cnt || yi_cnt) {
+    if (cell_dest_xi >= GRID_MAX_POINTS_X - 1) z1 = z2 = 0.0;
 
-      const float next_mesh_line_x = mesh_index_to_xpos(current_xi + dxi),
-                  next_mesh_line_y = mesh_index_to_ypos(current_yi + dyi),
-                  ry = m * next_mesh_line_x + c,    // Calculate Y at the next X mesh line
-                  rx = (next_mesh_line_y - c) / m;  // Calculate X at the next Y mesh line
-                                                    // (No need to worry about m being zero.
-                                                    //  If that was the case, it was already detected
-                                                    //  as a vertical line move above.)
+    // X cell-fraction done. Interpolate the two Z offsets with the Y fraction for the final Z offset.
+    const float yratio = (end[Y_AXIS] - mesh_index_to_ypos(cell_dest_yi)) * (1.0f / (MESH_Y_DIST)),
+                z0 = cell_dest_yi < GRID_MAX_POINTS_Y - 1 ? (z1 + (z2 - z1) * yratio) * bedlevel.fade_scaling_factor_for_z(end[Z_AXIS]) : 0.0;
 
-      if (left_flag == (rx > next_mesh_line_x)) {   // Check if we hit the Y line first
-        // Yes!  Crossing a Y Mesh Line next
-        float z0 = z_correction_for_x_on_horizontal_mesh_line(rx, current_xi - left_flag, current_yi + dyi)
-                   * bedlevel.fade_scaling_factor_for_z(end[Z_AXIS]);
-
-        // Undefined parts of the Mesh in z_values[][] are NAN.
-        // Replace NAN corrections with 0.0 to prevent NAN propagation.
-        if (isnan(z0)) z0 = 0.0;
-
-        if (!inf_normalized_flag) {
-          on_axis_distance = use_x_dist ? rx - start[X_AXIS] : next_mesh_line_y - start[Y_AXIS];
-          e_position = start[E_AXIS] + on_axis_distance * e_normalized_dist;
-          z_position = start[Z_AXIS] + on_axis_distance * z_normalized_dist;
-        }
-        else {
-          e_position = end[E_AXIS];
-          z_position = end[Z_AXIS];
-        }
-        if (!planner.buffer_segment(rx, next_mesh_line_y, z_position + z0, e_position, feed_rate, extruder))
-          break;
-        current_yi += dyi;
-        yi_cnt--;
-      }
-      else {
-        // Yes!  Crossing a X Mesh Line next
-        float z0 = z_correction_for_y_on_vertical_mesh_line(ry, current_xi + dxi, current_yi - down_flag)
-                   * bedlevel.fade_scaling_factor_for_z(end[Z_AXIS]);
-
-        // Undefined parts of the Mesh in z_values[][] are NAN.
-        // Replace NAN corrections with 0.0 to prevent NAN propagation.
-        if (isnan(z0)) z0 = 0.0;
-
-        if (!inf_normalized_flag) {
-          on_axis_distance = use_x_dist ? next_mesh_line_x - start[X_AXIS] : ry - start[Y_AXIS];
-          e_position = start[E_AXIS] + on_axis_distance * e_normalized_dist;
-          z_position = start[Z_AXIS] + on_axis_distance * z_normalized_dist;
-        }
-        else {
-          e_position = end[E_AXIS];
-          z_position = end[Z_AXIS];
-        }
-
-        if (!planner.buffer_segment(next_mesh_line_x, ry, z_position + z0, e_position, feed_rate, extruder))
-          break;
-        current_xi += dxi;
-        xi_cnt--;
-      }
-
-      if (xi_cnt < 0 || yi_cnt < 0) break; // Too far! Exit the loop and go to FINAL_MOVE
-    }
+    // Undefined parts of the Mesh in z_values[][] are NAN.
+    // Replace NAN corrections with 0.0 to prevent NAN propagation.
+    planner.buffer_segment(end[X_AXIS], end[Y_AXIS], end[Z_AXIS] + (isnan(z0) ? 0.0 : z0), end[E_AXIS], feed_rate, extruder);
 
     if (bedlevel.flag.g26_debug)
-      debug_current_and_destination(PSTR("generic move done in ubl.line_to_destination_cartesian()"));
-
-    if (mechanics.current_position[X_AXIS] != end[X_AXIS] || mechanics.current_position[Y_AXIS] != end[Y_AXIS])
-      goto FINAL_MOVE;
+      debug_current_and_destination(PSTR("FINAL_MOVE in ubl.line_to_destination_cartesian()"));
 
     mechanics.set_current_to_destination();
   }
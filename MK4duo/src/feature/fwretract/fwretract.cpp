@@ -101,7 +101,7 @@
 
     const float old_feedrate_mm_s = mechanics.feedrate_mm_s,
                 unscale_e = RECIPROCAL(tools.e_factor[tools.extruder.active]),
-                unscale_fr = 100.0 / mechanics.feedrate_percentage, // Disable feedrate scaling for retract moves
+                unscale_fr = RECIPROCAL(MMS_SCALED(1.0f)), // Disable feedrate scaling for retract moves
                 base_retract = swapping ? data.swap_retract_length : data.retract_length;
 
     // The current position will be the destination for E and Z moves
@@ -51,6 +51,9 @@
       #endif
     #endif
   #endif
+  #if ENABLED(LASER_RASTER) && (LASER_RASTER_LINES < 1 || LASER_RASTER_LINES > BLOCK_BUFFER_SIZE)
+    #error "DEPENDENCY ERROR: LASER_RASTER_LINES must be between 1 and BLOCK_BUFFER_SIZE."
+  #endif
 #endif
 
 #endif /* _LASER_SANITYCHECK_H_ */
@@ -39,6 +39,9 @@
   #if ENABLED(FILAMENT_WIDTH_SENSOR)
     #error "DEPENDENCY ERROR: COLOR_MIXING_EXTRUDER is incompatible with FILAMENT_WIDTH_SENSOR. Comment out this line to use it anyway."
   #endif
+  #if MIXING_COLOR_SLOTS < 1 || MIXING_COLOR_SLOTS > BLOCK_BUFFER_SIZE
+    #error "DEPENDENCY ERROR: MIXING_COLOR_SLOTS must be between 1 and BLOCK_BUFFER_SIZE."
+  #endif
 #endif
 
 #endif /* _COLOR_MIXING_SANITYCHECK_H_ */
@@ -0,0 +1,416 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../../MK4duo.h"
+
+#if HAS_SD_PRINT_INDEX
+
+/**
+ * The index of "name.gcode" is the hidden file "name.gcode.idx" in the
+ * same folder. It is made by spin() a chunk at a time while the card is
+ * not printing or saving, after an upload or the first selection of the
+ * file. It holds the slicer data, found in the comments or measured,
+ * and one record for each layer with the file position of the line that
+ * moves to it and the estimated time from the start of the print.
+ * The time only counts the moves at their feedrate, so it is short of
+ * the acceleration, but it grows with the print as the real time does.
+ */
+
+#if ENABLED(__AVR__)
+  #define PRINT_INDEX_CHUNK    64
+#else
+  #define PRINT_INDEX_CHUNK   512
+#endif
+
+#define PRINT_INDEX_MIN_LAYER 0.02f   // Smaller rises are not a new layer (vase mode)
+
+PrintIndex printindex;
+
+/** Public Parameters */
+print_index_header_t PrintIndex::header;
+
+/** Private Parameters */
+SdFile  PrintIndex::index_file,
+        PrintIndex::scan_file,
+        PrintIndex::scan_index;
+
+char    PrintIndex::scan_path[MAX_PATH_NAME_LENGHT];
+bool    PrintIndex::scan_pending = false;
+
+print_index_layer_t PrintIndex::layer_cur,
+                    PrintIndex::layer_next;
+uint16_t            PrintIndex::layer_nr;
+
+print_index_header_t PrintIndex::scan_header;
+
+uint32_t  PrintIndex::scan_pos,
+          PrintIndex::line_pos,
+          PrintIndex::z_line_pos,
+          PrintIndex::scan_seconds,
+          PrintIndex::z_seconds;
+
+float     PrintIndex::position[XYZE],
+          PrintIndex::feedrate_mm_s,
+          PrintIndex::scan_fraction,
+          PrintIndex::layer_z,
+          PrintIndex::extruded;
+
+bool      PrintIndex::relative_mode,
+          PrintIndex::relative_e,
+          PrintIndex::found_genby,
+          PrintIndex::found_first_layer,
+          PrintIndex::found_layer,
+          PrintIndex::found_filament;
+
+char      PrintIndex::line[MAX_CMD_SIZE];
+uint8_t   PrintIndex::line_len;
+
+/** Public Function */
+
+/**
+ * Index the file at path, from the root, when the card is free.
+ * A newer request replaces the one in progress.
+ */
+void PrintIndex::request(const char * const path) {
+  if (scan_file.isOpen()) end_scan(false);
+  close(); // The loaded index may be the one rewritten
+  strncpy(scan_path, path, sizeof(scan_path) - 1);
+  scan_path[sizeof(scan_path) - 1] = '\0';
+  scan_pending = true;
+}
+
+/**
+ * Load the index of the file at path and set the file info of the card.
+ * Return false if there is no index or it is not of this file.
+ */
+bool PrintIndex::load(const char * const path, const uint32_t file_size) {
+  char name[MAX_PATH_NAME_LENGHT + sizeof(PRINT_INDEX_EXT)];
+
+  close();
+  make_index_name(name, path);
+  if (!index_file.open(&card.root, name, O_READ)) return false;
+
+  if (index_file.read(&header, sizeof(header)) != sizeof(header)
+    || header.magic != PRINT_INDEX_MAGIC || header.file_size != file_size
+  ) {
+    close();
+    return false;
+  }
+
+  card.objectHeight     = header.object_height;
+  card.firstlayerHeight = header.first_layer_height;
+  card.layerHeight      = header.layer_height;
+  card.filamentNeeded   = header.filament_needed;
+  strncpy(card.generatedBy, header.generated_by, GENBY_SIZE);
+
+  // Progress starts before the first layer
+  layer_nr = 0;
+  layer_cur.sdpos = 0;
+  layer_cur.time = 0;
+  read_layer(0, layer_next);
+
+  return true;
+}
+
+/**
+ * Index a chunk of the requested file
+ */
+void PrintIndex::spin() {
+
+  const bool card_busy = !card.isDetected() || card.isPrinting() || card.isSaving();
+
+  if (!scan_file.isOpen()) {
+    if (!scan_pending || card_busy) return;
+    scan_pending = false;
+    if (!start_scan()) return;
+  }
+  else if (card_busy) {
+    // Start again when the card is free
+    end_scan(false);
+    scan_pending = true;
+    return;
+  }
+
+  uint8_t buf[PRINT_INDEX_CHUNK];
+  const int16_t n = scan_file.read(buf, sizeof(buf));
+  if (n <= 0) {
+    if (line_len) scan_line();
+    end_scan(n == 0);
+    return;
+  }
+
+  for (int16_t i = 0; i < n; i++) {
+    const char c = buf[i];
+    if (c == '\n' || c == '\r') {
+      if (line_len) scan_line();
+      line_len = 0;
+      line_pos = scan_pos + i + 1;
+    }
+    else if (line_len < sizeof(line) - 1)
+      line[line_len++] = c;
+  }
+  scan_pos += n;
+}
+
+/**
+ * Progress from the estimated time of the loaded index
+ */
+uint8_t PrintIndex::percent_done(const uint32_t sdpos) {
+
+  if (!header.print_time) return 0;
+
+  // Moved back, walk again from the first layer
+  if (sdpos < layer_cur.sdpos) {
+    layer_nr = 0;
+    layer_cur.sdpos = 0;
+    layer_cur.time = 0;
+    read_layer(0, layer_next);
+  }
+
+  while (sdpos >= layer_next.sdpos && layer_nr < header.layer_count) {
+    layer_cur = layer_next;
+    read_layer(++layer_nr, layer_next);
+  }
+
+  // Time in the layer grows with the file position
+  float time = layer_cur.time;
+  if (layer_next.sdpos > layer_cur.sdpos && sdpos < layer_next.sdpos)
+    time += float(layer_next.time - layer_cur.time) * (sdpos - layer_cur.sdpos) / (layer_next.sdpos - layer_cur.sdpos);
+
+  const float percent = time * 100.0f / header.print_time;
+  return percent < 100.0f ? uint8_t(percent) : 100;
+}
+
+/**
+ * Get the record of a layer of the loaded index
+ */
+bool PrintIndex::layer_start(const uint16_t layer, print_index_layer_t &rec) {
+  return isLoaded() && layer < header.layer_count && read_layer(layer, rec);
+}
+
+/** Private Function */
+
+void PrintIndex::make_index_name(char * const name, const char * const path) {
+  strcpy(name, path);
+  strcat(name, PRINT_INDEX_EXT);
+}
+
+// Layers past the last one end at the end of the file
+bool PrintIndex::read_layer(const uint16_t layer, print_index_layer_t &rec) {
+  if (layer < header.layer_count) {
+    if (index_file.seekSet(sizeof(header) + uint32_t(layer) * sizeof(rec))
+      && index_file.read(&rec, sizeof(rec)) == sizeof(rec)
+    ) return true;
+    header.layer_count = layer; // Short index, no more layers
+  }
+  rec.sdpos = header.file_size;
+  rec.time = header.print_time;
+  return false;
+}
+
+bool PrintIndex::start_scan() {
+  char name[MAX_PATH_NAME_LENGHT + sizeof(PRINT_INDEX_EXT)];
+
+  if (!scan_file.open(&card.root, scan_path, O_READ)) return false;
+
+  make_index_name(name, scan_path);
+  if (!scan_index.open(&card.root, name, O_RDWR | O_CREAT | O_TRUNC)) {
+    scan_file.close();
+    return false;
+  }
+  scan_index.attrib(DIR_ATT_HIDDEN);
+
+  // The header is written without the magic, until the end
+  memset(&scan_header, 0, sizeof(scan_header));
+  scan_index.write(&scan_header, sizeof(scan_header));
+
+  scan_pos = line_pos = z_line_pos = 0;
+  scan_seconds = z_seconds = 0;
+  ZERO(position);
+  feedrate_mm_s = MMM_TO_MMS(1500.0f);
+  scan_fraction = layer_z = extruded = 0.0f;
+  relative_mode = relative_e = false;
+  found_genby = found_first_layer = found_layer = found_filament = false;
+  line_len = 0;
+
+  if (printer.debugFeature()) DEBUG_EMT("Print index: ", scan_path);
+  return true;
+}
+
+void PrintIndex::end_scan(bool ok) {
+
+  if (ok) {
+    scan_header.magic = PRINT_INDEX_MAGIC;
+    scan_header.file_size = scan_file.fileSize();
+    scan_header.print_time = scan_seconds + uint32_t(scan_fraction);
+    if (!found_filament) scan_header.filament_needed = extruded;
+    if (!found_genby) strcpy_P(scan_header.generated_by, PSTR("Unknown"));
+    ok = scan_index.seekSet(0) && scan_index.write(&scan_header, sizeof(scan_header)) == sizeof(scan_header);
+  }
+
+  scan_file.close();
+  if (ok)
+    scan_index.close();
+  else
+    scan_index.remove();
+
+  if (!ok) return;
+
+  if (printer.debugFeature()) {
+    DEBUG_MV("Print index layers:", scan_header.layer_count);
+    DEBUG_EMV(" time:", scan_header.print_time);
+  }
+
+  // The selected file was indexed, use it from now
+  if (card.isFileOpen()) {
+    char name[MAX_PATH_NAME_LENGHT];
+    card.getAbsFilename(name);
+    if (!strcmp(name, scan_path)) load(scan_path, card.fileSize);
+  }
+}
+
+void PrintIndex::scan_line() {
+  line[line_len] = '\0';
+
+  char *p = line;
+  while (*p == ' ' || *p == '\t') p++;
+
+  if (*p == ';') {
+    scan_comment(p);
+    return;
+  }
+
+  // Skip the line number
+  if (*p == 'N') {
+    p++;
+    while (NUMERIC(*p)) p++;
+    while (*p == ' ') p++;
+  }
+
+  char * const comment = strchr(p, ';');
+  if (comment) *comment = '\0';
+
+  const char letter = *p++;
+  if (!NUMERIC(*p)) return;
+  const uint16_t code = strtoul(p, &p, 10);
+  if (*p == '.') return; // Subcodes are not moves
+
+  if (letter == 'G') {
+    switch (code) {
+      case 0: case 1: case 2: case 3:
+        scan_move(p);
+        break;
+      case 4: {
+        const char *w;
+        if ((w = strchr(p, 'P'))) add_time(strtod(w + 1, NULL) * 0.001f);
+        if ((w = strchr(p, 'S'))) add_time(strtod(w + 1, NULL));
+      } break;
+      case 28: {
+        bool all = true;
+        LOOP_XYZ(i) if (strchr(p, axis_codes[i])) { position[i] = 0; all = false; }
+        if (all) LOOP_XYZ(i) position[i] = 0;
+      } break;
+      case 90: relative_mode = false; break;
+      case 91: relative_mode = true; break;
+      case 92:
+        LOOP_XYZE(i) {
+          const char * const w = strchr(p, axis_codes[i]);
+          if (w) position[i] = strtod(w + 1, NULL);
+        }
+        break;
+    }
+  }
+  else if (letter == 'M') {
+    if (code == 82) relative_e = false;
+    else if (code == 83) relative_e = true;
+  }
+}
+
+void PrintIndex::scan_comment(char * const p) {
+  if (!found_genby) found_genby = card.findGeneratedBy(p, scan_header.generated_by);
+  if (!found_first_layer) found_first_layer = card.findFirstLayerHeight(p, scan_header.first_layer_height);
+  if (!found_layer) found_layer = card.findLayerHeight(p, scan_header.layer_height);
+  if (!found_filament) found_filament = card.findFilamentNeed(p, scan_header.filament_needed);
+}
+
+// Moves are timed on the straight line, arcs on their chord
+void PrintIndex::scan_move(const char * const p) {
+  float dest[XYZE], dist = 0.0f;
+
+  LOOP_XYZE(i) {
+    const char * const w = strchr(p, axis_codes[i]);
+    if (w) {
+      const float v = strtod(w + 1, NULL);
+      dest[i] = (relative_mode || (i == E_AXIS && relative_e)) ? position[i] + v : v;
+    }
+    else
+      dest[i] = position[i];
+    if (i != E_AXIS) dist += sq(dest[i] - position[i]);
+  }
+
+  const char * const f = strchr(p, 'F');
+  if (f) {
+    const float v = strtod(f + 1, NULL);
+    if (v > 0) feedrate_mm_s = MMM_TO_MMS(v);
+  }
+
+  const float de = dest[E_AXIS] - position[E_AXIS];
+  dist = dist ? SQRT(dist) : ABS(de);
+
+  if (dest[Z_AXIS] != position[Z_AXIS]) {
+    z_line_pos = line_pos;
+    z_seconds = scan_seconds;
+  }
+
+  add_time(dist / feedrate_mm_s);
+
+  // A new layer starts with the first extrusion above the last one
+  if (de > 0 && (dest[X_AXIS] != position[X_AXIS] || dest[Y_AXIS] != position[Y_AXIS])) {
+    extruded += de;
+    NOLESS(scan_header.object_height, dest[Z_AXIS]);
+    if (!scan_header.layer_count || dest[Z_AXIS] >= layer_z + PRINT_INDEX_MIN_LAYER) {
+      print_index_layer_t rec;
+      rec.sdpos = z_line_pos;
+      rec.z = dest[Z_AXIS];
+      rec.time = z_seconds;
+      if (scan_index.write(&rec, sizeof(rec)) == sizeof(rec)) {
+        if (!found_first_layer && !scan_header.layer_count) scan_header.first_layer_height = rec.z;
+        if (!found_layer && scan_header.layer_count == 1) scan_header.layer_height = rec.z - layer_z;
+        scan_header.layer_count++;
+        layer_z = rec.z;
+      }
+    }
+  }
+
+  COPY_ARRAY(position, dest);
+}
+
+void PrintIndex::add_time(const float seconds) {
+  scan_fraction += seconds;
+  if (scan_fraction >= 1.0f) {
+    const uint32_t s = scan_fraction;
+    scan_seconds += s;
+    scan_fraction -= s;
+  }
+}
+
+#endif // HAS_SD_PRINT_INDEX
@@ -0,0 +1,127 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * printindex.h - Sidecar index of the G-code files on the SD
+ */
+
+#if HAS_SD_PRINT_INDEX
+
+#define PRINT_INDEX_MAGIC   0x3158444DUL  // "MDX1"
+#define PRINT_INDEX_EXT     ".idx"
+
+// Index file header, the layers follow it
+typedef struct {
+  uint32_t  magic,              // Written last, a partial index is never valid
+            file_size;          // Size of the indexed G-code
+  float     object_height,
+            first_layer_height,
+            layer_height,
+            filament_needed;
+  uint32_t  print_time,         // Estimated print time in seconds
+            layer_count;
+  char      generated_by[GENBY_SIZE];
+} print_index_header_t;
+
+// One record for each layer
+typedef struct {
+  uint32_t  sdpos;              // Start of the line that moves to the layer
+  float     z;
+  uint32_t  time;               // Estimated seconds from the start of the print
+} print_index_layer_t;
+
+class PrintIndex {
+
+  public: /** Constructor */
+
+    PrintIndex() {};
+
+  public: /** Public Parameters */
+
+    static print_index_header_t header;   // Header of the loaded index
+
+  public: /** Public Function */
+
+    static void request(const char * const path);
+    static bool load(const char * const path, const uint32_t file_size);
+    static inline void close() { index_file.close(); }
+
+    static void spin();
+
+    static uint8_t percent_done(const uint32_t sdpos);
+    static bool layer_start(const uint16_t layer, print_index_layer_t &rec);
+
+    FORCE_INLINE static bool isLoaded() { return index_file.isOpen(); }
+
+  private: /** Private Parameters */
+
+    static SdFile index_file,             // Index of the selected file
+                  scan_file,              // G-code being indexed
+                  scan_index;             // Index being written
+
+    static char   scan_path[MAX_PATH_NAME_LENGHT];
+    static bool   scan_pending;
+
+    // Layers around the print position, for the progress
+    static print_index_layer_t  layer_cur,
+                                layer_next;
+    static uint16_t             layer_nr;
+
+    // Scanner state
+    static print_index_header_t scan_header;
+    static uint32_t scan_pos,             // File position of the next chunk
+                    line_pos,             // Start of the current line
+                    z_line_pos,           // Start of the last line moving Z
+                    scan_seconds,
+                    z_seconds;
+    static float    position[XYZE],
+                    feedrate_mm_s,
+                    scan_fraction,        // Fraction of second, keeps the sum precise
+                    layer_z,
+                    extruded;
+    static bool     relative_mode,
+                    relative_e,
+                    found_genby,
+                    found_first_layer,
+                    found_layer,
+                    found_filament;
+    static char     line[MAX_CMD_SIZE];
+    static uint8_t  line_len;
+
+  private: /** Private Function */
+
+    static void make_index_name(char * const name, const char * const path);
+    static bool read_layer(const uint16_t layer, print_index_layer_t &rec);
+
+    static bool start_scan();
+    static void end_scan(bool ok);
+    static void scan_line();
+    static void scan_comment(char * const p);
+    static void scan_move(const char * const p);
+    static void add_time(const float seconds);
+
+};
+
+extern PrintIndex printindex;
+
+#endif // HAS_SD_PRINT_INDEX
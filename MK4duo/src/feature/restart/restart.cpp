@@ -24,6 +24,38 @@
 
 #if HAS_SD_RESTART
 
+/**
+ * The restart file is a journal allocated contiguous on the SD and
+ * written with raw block writes, so every save costs one block and
+ * never touches the FAT or the directory entry:
+ *  - The first blocks hold two checkpoints, written alternately, with
+ *    the job data that seldom changes (file name, offsets, leveling).
+ *  - The other blocks are a ring of records with the job state
+ *    (SD position, position, temperatures, queued commands).
+ * The load takes the newest valid checkpoint and the newest valid
+ * record of the same job, a torn write only loses its own record.
+ */
+#define JOURNAL_BLOCK_SIZE  512
+#define JOURNAL_CHECKPOINTS 2
+#define JOURNAL_RECORDS     ((SD_RESTART_FILE_JOURNAL) - (JOURNAL_CHECKPOINTS))
+
+typedef struct {
+  uint32_t  id,         // Id of the job
+            sequence;   // Higher is newer
+  uint16_t  size,       // Bytes of the record, header included
+            crc;        // CRC of the record with crc = 0
+} journal_header_t;
+
+#define JOB_DATA_START    offsetof(restart_job_t, fileName)
+#define JOB_DATA_SIZE     (offsetof(restart_job_t, sdpos) - JOB_DATA_START)
+#define JOB_STATE_START   offsetof(restart_job_t, sdpos)
+#define JOB_STATE_SIZE    (offsetof(restart_job_t, buffer_ring) - JOB_STATE_START)
+#define CHECKPOINT_SIZE   (sizeof(journal_header_t) + JOB_DATA_SIZE)
+#define STATE_SIZE        (sizeof(journal_header_t) + JOB_STATE_SIZE)
+
+static_assert(CHECKPOINT_SIZE <= JOURNAL_BLOCK_SIZE, "The restart job data does not fit in a journal block.");
+static_assert(STATE_SIZE + MAX_CMD_SIZE <= JOURNAL_BLOCK_SIZE, "The restart job state does not fit in a journal block.");
+
 Restart restart;
 
 /** Public Parameters */
@@ -33,6 +65,20 @@ restart_job_t Restart::job_info;
 
 bool Restart::enabled;
 
+/** Private Parameters */
+uint32_t  Restart::journal_block    = 0,
+          Restart::journal_id       = 0,
+          Restart::journal_sequence = 0;
+
+uint16_t  Restart::journal_next     = 0,
+          Restart::checkpoint_crc   = 0;
+
+uint8_t   Restart::checkpoint_slot  = 0;
+
+bool      Restart::checkpoint_saved = false;
+
+char      Restart::executing[MAX_CMD_SIZE] = { 0 };
+
 /** Public Function */
 void Restart::init_job() { memset(&job_info, 0, sizeof(job_info)); }
 
@@ -61,14 +107,19 @@ void Restart::check() {
 
 void Restart::purge_job() {
   init_job();
+  journal_block = 0;
   card.delete_restart_file();
 }
 
 void Restart::load_job() {
+  init_job();
   if (exists()) {
+    uint32_t first_block, last_block;
     open(true);
-    (void)job_file.read(&job_info, sizeof(job_info));
+    const bool contiguous = job_file.fileSize() == (SD_RESTART_FILE_JOURNAL) * uint32_t(JOURNAL_BLOCK_SIZE)
+                         && job_file.contiguousRange(&first_block, &last_block);
     close();
+    if (contiguous) read_journal(first_block);
   }
   debug_info(PSTR("Load"));
 }
@@ -142,9 +193,8 @@ void Restart::save_job(const bool force_save/*=false*/, const bool save_count/*=
     job_info.buffer_head = commands.buffer_ring.head();
     job_info.buffer_count = save_count ? commands.buffer_ring.count() : 0;
     for (uint8_t index = 0; index < BUFSIZE; index++) {
-      gcode_t temp_cmd;
-      temp_cmd = commands.buffer_ring.peek(index);
-      strncpy(job_info.buffer_ring[index], temp_cmd.gcode, sizeof(job_info.buffer_ring[index]) - 1);
+      const char * const gcode = (index == job_info.buffer_head && executing[0]) ? executing : commands.buffer_ring.at(index).gcode;
+      strncpy(job_info.buffer_ring[index], gcode, sizeof(job_info.buffer_ring[index]) - 1);
     }
 
     // Elapsed print job time
@@ -292,29 +342,183 @@ void Restart::resume_job() {
   for (; c--; h = (h + 1) % BUFSIZE)
     commands.process_now(job_info.buffer_ring[h]);
 
-  // Resume the SD file from the last position
+  // Resume the SD file from the last position, M23 purges job_info
+  const uint32_t  resume_sdpos    = job_info.sdpos;
+  const millis_l  resume_elapsed  = job_info.print_job_counter_elapsed;
   char *fn = job_info.fileName;
   while (*fn == '/') fn++;
   sprintf_P(cmd, PSTR("M23 %s"), fn);
   commands.process_now(cmd);
-  sprintf_P(cmd, PSTR("M24 S%lu T%lu"), job_info.sdpos, job_info.print_job_counter_elapsed);
+  sprintf_P(cmd, PSTR("M24 S%lu T%lu"), resume_sdpos, resume_elapsed);
   commands.process_now(cmd);
 
 }
 
 /** Private Function */
 void Restart::write_job() {
-  bool failed = false;
 
   debug_info(PSTR("Write"));
 
-  open(false);
-  if (!job_file.seekSet(0)) failed = true;
-  if (!failed && !job_file.write(&job_info, sizeof(job_info)) == sizeof(job_info))
-    failed = true;
-  close();
-  if (failed) DEBUG_LM(DEB, " Restart file write failed.");
+  if (!open_journal()) {
+    DEBUG_LM(DEB, " Restart file write failed.");
+    return;
+  }
+
+  // Buffer of the volume, flushed and free for the raw blocks
+  cache_t * const cache = card.fat.cacheClear();
+  if (!cache) return;
+  uint8_t * const data = cache->data;
+
+  // Checkpoint only when the job data changed
+  uint16_t crc = 0;
+  crc16(&crc, (uint8_t*)&job_info + JOB_DATA_START, JOB_DATA_SIZE);
+  if (!checkpoint_saved || crc != checkpoint_crc) {
+    // The first checkpoint of a journal fills both slots, so none is left from an old job
+    for (uint8_t c = checkpoint_saved ? 1 : JOURNAL_CHECKPOINTS; c--;) {
+      memset(data, 0, JOURNAL_BLOCK_SIZE);
+      memcpy(data + sizeof(journal_header_t), (uint8_t*)&job_info + JOB_DATA_START, JOB_DATA_SIZE);
+      if (!write_record(data, journal_block + checkpoint_slot, CHECKPOINT_SIZE)) {
+        checkpoint_saved = false;
+        DEBUG_LM(DEB, " Restart checkpoint write failed.");
+        return;
+      }
+      checkpoint_slot ^= 1;
+    }
+    checkpoint_saved = true;
+    checkpoint_crc = crc;
+  }
+
+  // Job state with the queued commands packed
+  memset(data, 0, JOURNAL_BLOCK_SIZE);
+  memcpy(data + sizeof(journal_header_t), (uint8_t*)&job_info + JOB_STATE_START, JOB_STATE_SIZE);
+  uint16_t size = STATE_SIZE;
+  for (uint8_t i = 0; i < job_info.buffer_count; i++) {
+    const char * const cmd = job_info.buffer_ring[(job_info.buffer_head + i) % BUFSIZE];
+    const uint16_t len = strlen(cmd) + 1;
+    if (size + len > JOURNAL_BLOCK_SIZE) {
+      // Keep the previous record, the next save will have a shorter queue
+      DEBUG_LM(DEB, " Restart commands do not fit in a block.");
+      return;
+    }
+    memcpy(data + size, cmd, len);
+    size += len;
+  }
+
+  if (write_record(data, journal_block + JOURNAL_CHECKPOINTS + journal_next, size))
+    journal_next = (journal_next + 1) % (JOURNAL_RECORDS);
+  else
+    DEBUG_LM(DEB, " Restart file write failed.");
+
+}
+
+/**
+ * Create the journal for a new job, the file is allocated contiguous
+ * and its blocks are written directly from now on
+ */
+bool Restart::open_journal() {
+
+  if (journal_block) return true;
+
+  for (uint8_t retry = 0; retry < 2; retry++) {
+    uint32_t first_block, last_block;
+    open(false);
+    const bool contiguous = job_file.isOpen()
+                         && job_file.fileSize() == (SD_RESTART_FILE_JOURNAL) * uint32_t(JOURNAL_BLOCK_SIZE)
+                         && job_file.contiguousRange(&first_block, &last_block);
+    close();
+    if (contiguous) {
+      journal_block     = first_block;
+      journal_id        = micros() ^ (uint32_t(millis()) << 12);
+      journal_sequence  = 0;
+      journal_next      = 0;
+      checkpoint_slot   = 0;
+      checkpoint_saved  = false;
+      return true;
+    }
+    // File from a previous firmware, create it again
+    card.delete_restart_file();
+  }
+
+  return false;
+}
+
+/**
+ * Load the newest checkpoint and the newest state record of its job
+ */
+void Restart::read_journal(const uint32_t first_block) {
+
+  cache_t * const cache = card.fat.cacheClear();
+  if (!cache) return;
+  uint8_t * const data = cache->data;
+  const journal_header_t * const header = (journal_header_t*)data;
+
+  bool      found = false;
+  uint32_t  id = 0, sequence = 0;
+
+  for (uint8_t b = 0; b < JOURNAL_CHECKPOINTS; b++) {
+    if (read_record(data, first_block + b) && header->size == CHECKPOINT_SIZE
+        && (!found || header->sequence > sequence)
+    ) {
+      memcpy((uint8_t*)&job_info + JOB_DATA_START, data + sizeof(journal_header_t), JOB_DATA_SIZE);
+      id = header->id;
+      sequence = header->sequence;
+      found = true;
+    }
+  }
+  if (!found) return;
+
+  found = false;
+  sequence = 0;
+  for (uint16_t b = 0; b < JOURNAL_RECORDS; b++) {
+    if (!read_record(data, first_block + JOURNAL_CHECKPOINTS + b) || header->size < STATE_SIZE
+        || header->id != id || (found && header->sequence <= sequence)
+    ) continue;
+
+    // The queued commands must all be in the record
+    const uint8_t count = data[sizeof(journal_header_t) + offsetof(restart_job_t, buffer_count) - JOB_STATE_START];
+    const char * const end = (const char*)data + header->size;
+    const char *cmd = (const char*)data + STATE_SIZE;
+    uint8_t i = 0;
+    for (; i < count && cmd < end; i++) cmd += strnlen(cmd, end - cmd) + 1;
+    if (count > BUFSIZE || i < count || cmd > end) continue;
+
+    // Unpack the queued commands from the head of the ring
+    memcpy((uint8_t*)&job_info + JOB_STATE_START, data + sizeof(journal_header_t), JOB_STATE_SIZE);
+    job_info.buffer_head = 0;
+    cmd = (const char*)data + STATE_SIZE;
+    for (i = 0; i < count; i++) {
+      strncpy(job_info.buffer_ring[i], cmd, MAX_CMD_SIZE - 1);
+      cmd += strlen(cmd) + 1;
+    }
+    sequence = header->sequence;
+    found = true;
+  }
+
+  if (found) job_info.valid_head = job_info.valid_foot = 1;
+
+}
+
+bool Restart::write_record(uint8_t * const data, const uint32_t block, const uint16_t size) {
+  journal_header_t * const header = (journal_header_t*)data;
+  header->id        = journal_id;
+  header->sequence  = ++journal_sequence;
+  header->size      = size;
+  header->crc       = 0;
+  uint16_t crc = 0;
+  crc16(&crc, data, size);
+  header->crc = crc;
+  return card.fat.card()->writeBlock(block, data);
+}
 
+bool Restart::read_record(uint8_t * const data, const uint32_t block) {
+  journal_header_t * const header = (journal_header_t*)data;
+  if (!card.fat.card()->readBlock(block, data)) return false;
+  if (header->size < sizeof(journal_header_t) || header->size > JOURNAL_BLOCK_SIZE) return false;
+  const uint16_t record_crc = header->crc;
+  header->crc = 0;
+  uint16_t crc = 0;
+  crc16(&crc, data, header->size);
+  return crc == record_crc;
 }
 
 #if ENABLED(DEBUG_RESTART)
@@ -340,7 +544,7 @@ void Restart::write_job() {
         #endif
         SERIAL_EMV("buffer_head: ", job_info.buffer_head);
         SERIAL_EMV("buffer_count: ", job_info.buffer_count);
-        for (uint8_t i = 0; i < job_info.buffer_count; i++) SERIAL_EMT("> ", job_info.buffer_ring[i]);
+        for (uint8_t i = 0; i < job_info.buffer_count; i++) SERIAL_EMT("> ", job_info.buffer_ring[(job_info.buffer_head + i) % BUFSIZE]);
         SERIAL_EMT("Filename: ", job_info.fileName);
         SERIAL_EMV("sdpos: ", job_info.sdpos);
         SERIAL_EMV("print_job_counter_elapsed: ", job_info.print_job_counter_elapsed);
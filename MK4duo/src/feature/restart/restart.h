@@ -36,18 +36,38 @@
 typedef struct {
   uint8_t valid_head;
 
-  // SD file e position
-  char fileName[MAX_PATH_NAME_LENGHT];
-  uint32_t sdpos;
+  // Job data, saved by the checkpoints of the journal
 
-  // Mechanics state
-  float   current_position[XYZE];
+  // SD file
+  char fileName[MAX_PATH_NAME_LENGHT];
 
   #if ENABLED(WORKSPACE_OFFSETS)
     float home_offset[XYZ];
     float position_shift[XYZ];
   #endif
 
+  // Leveling
+  #if HAS_LEVELING
+    bool  leveling;
+    float z_fade_height;
+  #endif
+
+  // Color Mixing gradient
+  #if ENABLED(COLOR_MIXING_EXTRUDER) && HAS_GRADIENT_MIX
+    gradient_t gradient;
+  #endif
+
+  // Utility
+  bool just_restart;
+
+  // Job state, saved by every record of the journal
+
+  // SD position
+  uint32_t sdpos;
+
+  // Mechanics state
+  float   current_position[XYZE];
+
   uint16_t feedrate;
 
   #if HAS_HOTENDS
@@ -69,29 +89,15 @@ typedef struct {
     uint8_t active_extruder;
   #endif
 
-  // Leveling
-  #if HAS_LEVELING
-    bool  leveling;
-    float z_fade_height;
-  #endif
-
-  // Color Mixing gradient
-  #if ENABLED(COLOR_MIXING_EXTRUDER) && HAS_GRADIENT_MIX
-    gradient_t gradient;
-  #endif
-
   // Relative mode
   bool relative_mode, relative_modes_e;
 
-  // Command buffer
-  uint8_t buffer_head, buffer_count;
-  char    buffer_ring[BUFSIZE][MAX_CMD_SIZE];
-
   // Job elapsed time
   millis_l print_job_counter_elapsed;
 
-  // Utility
-  bool just_restart;
+  // Command buffer, the commands are packed in the record
+  uint8_t buffer_head, buffer_count;
+  char    buffer_ring[BUFSIZE][MAX_CMD_SIZE];
 
   uint8_t valid_foot;
 
@@ -133,10 +139,34 @@ class Restart {
 
     static inline bool valid() { return job_info.valid_head && job_info.valid_head == job_info.valid_foot; }
 
+    // The parser cuts the executed line in its ring slot, the journal saves it as received
+    static inline void set_executing(const char * const gcode) { strncpy(executing, gcode, MAX_CMD_SIZE - 1); }
+    static inline void clear_executing() { executing[0] = '\0'; }
+
+  private: /** Private Parameters */
+
+    static uint32_t journal_block,    // First block of the journal, 0 if not open
+                    journal_id,       // Id of the job, records of other jobs are ignored
+                    journal_sequence;
+
+    static uint16_t journal_next,     // Next state record
+                    checkpoint_crc;   // CRC of the job data of the last checkpoint
+
+    static uint8_t  checkpoint_slot;  // Next checkpoint, they are written alternately
+
+    static bool     checkpoint_saved;
+
+    static char     executing[MAX_CMD_SIZE];  // Front command of the ring, before parsing
+
   private: /** Private Function */
 
     static void write_job();
 
+    static bool open_journal();
+    static void read_journal(const uint32_t first_block);
+    static bool write_record(uint8_t * const data, const uint32_t block, const uint16_t size);
+    static bool read_record(uint8_t * const data, const uint32_t block);
+
     #if ENABLED(DEBUG_RESTART)
       static void debug_info(PGM_P const prefix);
     #else
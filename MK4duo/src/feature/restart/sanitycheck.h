@@ -29,4 +29,12 @@
 #ifndef _RESTART_SANITYCHECK_H_
 #define _RESTART_SANITYCHECK_H_
 
+#if HAS_SD_RESTART
+  #if DISABLED(SD_RESTART_FILE_JOURNAL)
+    #error "DEPENDENCY ERROR: Missing setting SD_RESTART_FILE_JOURNAL."
+  #elif SD_RESTART_FILE_JOURNAL < 4
+    #error "DEPENDENCY ERROR: SD_RESTART_FILE_JOURNAL must be at least 4 blocks."
+  #endif
+#endif
+
 #endif /* _RESTART_SANITYCHECK_H_ */
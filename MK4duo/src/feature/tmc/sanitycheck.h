@@ -122,6 +122,26 @@
   #error "DEPENDENCY ERROR: TMC_Z_CALIBRATION requires at least one TMC driver on Z axis"
 #endif
 
+#if ENABLED(STALLGUARD_TELEMETRY)
+  #if DISABLED(MONITOR_DRIVER_STATUS)
+    #error "DEPENDENCY ERROR: STALLGUARD_TELEMETRY requires MONITOR_DRIVER_STATUS."
+  #elif !TMC_HAS_STALLGUARD
+    #error "DEPENDENCY ERROR: STALLGUARD_TELEMETRY requires TMC2130, TMC2160, TMC2660, TMC5130 or TMC5160 drivers."
+  #elif DISABLED(STALLGUARD_SAMPLE_MS)
+    #error "DEPENDENCY ERROR: Missing setting STALLGUARD_SAMPLE_MS."
+  #elif DISABLED(STALLGUARD_LOAD_THRS)
+    #error "DEPENDENCY ERROR: Missing setting STALLGUARD_LOAD_THRS."
+  #elif DISABLED(STALLGUARD_CURRENT_STEP)
+    #error "DEPENDENCY ERROR: Missing setting STALLGUARD_CURRENT_STEP."
+  #elif DISABLED(STALLGUARD_CURRENT_MAX)
+    #error "DEPENDENCY ERROR: Missing setting STALLGUARD_CURRENT_MAX."
+  #elif DISABLED(STALLGUARD_SLOWDOWN)
+    #error "DEPENDENCY ERROR: Missing setting STALLGUARD_SLOWDOWN."
+  #elif STALLGUARD_CURRENT_MAX < 100
+    #error "DEPENDENCY ERROR: STALLGUARD_CURRENT_MAX must be 100 or more."
+  #endif
+#endif
+
 #if !HAS_TRINAMIC
   #if ENABLED(MONITOR_DRIVER_STATUS)
     #error "DEPENDENCY ERROR: MONITOR_DRIVER_STATUS requires at least one TMC driver"
@@ -81,9 +81,18 @@ TMC_Stepper tmc;
   millis_l TMC_Stepper::sg_guard_period = 0;
 #endif
 
+#if ENABLED(STALLGUARD_TELEMETRY)
+  uint16_t TMC_Stepper::load_report_interval = 0;
+#endif
+
 /** Private Parameters */
 uint16_t TMC_Stepper::report_status_interval = 0;
 
+#if ENABLED(STALLGUARD_TELEMETRY)
+  uint8_t TMC_Stepper::load_feedrate_percentage = 100;
+  uint16_t TMC_Stepper::load_warning = 0;
+#endif
+
 /** Public Function */
 void TMC_Stepper::init() {
 
@@ -497,33 +506,154 @@ void TMC_Stepper::test_connection(const bool test_x, const bool test_y, const bo
 
 #if ENABLED(MONITOR_DRIVER_STATUS)
 
+  /**
+   * Round-robin poller of the drivers, called from idle().
+   * Every call in a new slot reads DRV_STATUS of a single driver into its
+   * mirror, so all the drivers are refreshed once per interval and the
+   * bus time is spread over the loop instead of paid all at once.
+   * While SPI_ENDSTOPS homes the bus is left to the stall checks of idle().
+   */
   void TMC_Stepper::monitor_driver() {
     static millis_s next_poll_ms = millis();
-    bool need_update_error_counters = expired(&next_poll_ms, MONITOR_DRIVER_STATUS_INTERVAL_MS);
-    bool need_debug_reporting = false;
-    if (need_update_error_counters) {
-      next_poll_ms = millis();
-      #if ENABLED(TMC_DEBUG)
-        static millis_s next_debug_reporting_ms = millis();
-        if (expired(&next_debug_reporting_ms, report_status_interval)) {
-          need_debug_reporting = true;
-          next_debug_reporting_ms = millis();
+    static uint8_t poll_index = 0, drivers = 0;
+
+    if (!drivers) {
+      LOOP_TMC() if (tmc.driver_by_index(t)) drivers++;
+      if (!drivers) return;
+    }
+
+    if (expired(&next_poll_ms, millis_s((MONITOR_DRIVER_STATUS_INTERVAL_MS) / drivers))
+      #if ENABLED(SPI_ENDSTOPS)
+        && !endstops.tmc_spi_homing.any
+      #endif
+    ) {
+      for (uint8_t i = TMC_AXIS; i--;) {
+        MKTMC* st = tmc.driver_by_index(poll_index);
+        poll_index = (poll_index + 1) % TMC_AXIS;
+        if (st) {
+          poll_driver(st);
+          monitor_driver(st);
+          break;
         }
+      }
+    }
+
+    #if ENABLED(STALLGUARD_TELEMETRY)
+      #if ENABLED(SPI_ENDSTOPS)
+        if (!endstops.tmc_spi_homing.any)
       #endif
-      if (need_update_error_counters || need_debug_reporting) {
+          sample_load();
+      static millis_s next_load_report_ms = millis();
+      if (expired(&next_load_report_ms, load_report_interval)) report_load();
+    #endif
+
+    #if ENABLED(TMC_DEBUG)
+      // Periodic report from the mirrors
+      static millis_s next_debug_reporting_ms = millis();
+      if (expired(&next_debug_reporting_ms, report_status_interval)) {
         LOOP_TMC() {
           MKTMC* st = tmc.driver_by_index(t);
-          if (st) monitor_driver(st, need_update_error_counters, need_debug_reporting);
+          if (st) report_driver(st);
         }
+        SERIAL_EOL();
+      }
+    #endif
+  }
 
-        #if ENABLED(TMC_DEBUG)
-          if (need_debug_reporting) SERIAL_EOL();
+#endif // ENABLED(MONITOR_DRIVER_STATUS)
+
+#if ENABLED(STALLGUARD_TELEMETRY)
+
+  /**
+   * M923 report: lowest load value of every X, Y and Z driver since the last
+   * report, the nominal speed of the block where it was seen and the raised
+   * current, then the feedrate left by the slowdown.
+   *  SG X:<load>@<mm/s>+<mA> Y:... F:<slowdown feedrate %>
+   */
+  void TMC_Stepper::report_load() {
+    SERIAL_MSG("SG");
+    LOOP_TMC() {
+      MKTMC* st = tmc.driver_by_index(t);
+      if (!st || st->id >= E_AXIS) continue;
+      SERIAL_CHR(' ');
+      st->printLabel();
+      SERIAL_CHR(':');
+      if (st->sg_min == 0xFFFF)
+        SERIAL_CHR('-');
+      else {
+        SERIAL_VAL(st->sg_min);
+        SERIAL_MV("@", st->sg_min_speed, 1);
+      }
+      if (st->sg_boost_mA) SERIAL_MV("+", st->sg_boost_mA);
+      st->sg_min = 0xFFFF;
+    }
+    SERIAL_EMV(" F:", int(load_feedrate_percentage));
+  }
+
+  /**
+   * Sample the load of one X, Y or Z driver in every period, round-robin
+   */
+  void TMC_Stepper::sample_load() {
+    static millis_s next_sample_ms = millis();
+    static uint8_t sample_index = 0;
+
+    if (!expired(&next_sample_ms, millis_s(STALLGUARD_SAMPLE_MS))) return;
+
+    for (uint8_t i = TMC_AXIS; i--;) {
+      MKTMC* st = tmc.driver_by_index(sample_index);
+      const uint8_t index = sample_index;
+      sample_index = (sample_index + 1) % TMC_AXIS;
+      if (st && st->id < E_AXIS) {
+        poll_driver(st);
+        adapt_load(st, index);
+        break;
+      }
+    }
+  }
+
+  /**
+   * Raise the current of a driver near to a stall, then slow down the
+   * next moves with load_feedrate_percentage, on top of the M220 feedrate.
+   * Both come back when the load is low again.
+   */
+  void TMC_Stepper::adapt_load(MKTMC* st, const uint8_t index) {
+
+    const TMC_driver_data data = get_driver_data(st);
+    const bool moving = planner.has_blocks_queued() && data.sg_result_reasonable;
+
+    if (moving && data.sg_result < st->sg_min) {
+      st->sg_min = data.sg_result;
+      st->sg_min_speed = SQRT(planner.block_buffer[planner.block_buffer_tail].nominal_speed_sqr);
+    }
+
+    const uint16_t max_boost = st->sg_boost_max();
+
+    if (moving && data.sg_result < (STALLGUARD_LOAD_THRS)) {
+      SBI(load_warning, index);
+      if (st->sg_boost_mA < max_boost) {
+        st->boost_current(MIN(st->sg_boost_mA + (STALLGUARD_CURRENT_STEP), max_boost));
+        #if ENABLED(REPORT_CURRENT_CHANGE)
+          st->printLabel();
+          SERIAL_EMV(" current raised to ", st->getMilliamps() + st->sg_boost_mA);
         #endif
       }
+      #if STALLGUARD_SLOWDOWN > 0
+        else
+          load_feedrate_percentage = MAX(load_feedrate_percentage - (STALLGUARD_SLOWDOWN), 50);
+      #endif
+    }
+    else if (!moving || data.sg_result > 2 * (STALLGUARD_LOAD_THRS)) {
+      CBI(load_warning, index);
+      if (st->sg_boost_mA)
+        st->boost_current(st->sg_boost_mA > (STALLGUARD_CURRENT_STEP) ? st->sg_boost_mA - (STALLGUARD_CURRENT_STEP) : 0);
+      #if STALLGUARD_SLOWDOWN > 0
+        if (!load_warning) load_feedrate_percentage = 100;
+      #endif
     }
+
   }
 
-#endif // ENABLED(MONITOR_DRIVER_STATUS)
+#endif // STALLGUARD_TELEMETRY
 
 #if HAS_SENSORLESS
 
@@ -1145,77 +1275,91 @@ bool TMC_Stepper::test_connection(MKTMC* st) {
       }
     #endif
 
+    void TMC_Stepper::poll_driver(MKTMC* st) {
+      st->drv_status = st->DRV_STATUS();
+      st->drv_status_ms = millis();
+    }
+
     TMC_driver_data TMC_Stepper::get_driver_data(MKTMC* st) {
-      cconstexpr uint8_t OTPW_bp = 0, OT_bp = 1;
+      constexpr uint8_t OTPW_bp = 0, OT_bp = 1, STST_bp = 31;
       constexpr uint8_t S2G_bm = 0b11110; // 2..5
       TMC_driver_data data;
-      const auto ds = data.drv_status = st->DRV_STATUS();
+      const auto ds = data.drv_status = st->drv_status;
       data.is_otpw = TEST(ds, OTPW_bp);
       data.is_ot = TEST(ds, OT_bp);
       data.is_s2g = !!(ds & S2G_bm);
+      data.is_standstill = TEST(ds, STST_bp);
+      data.is_stall = false;
+      data.sg_result = 0;
+      data.sg_result_reasonable = false;
       #if ENABLED(TMC_DEBUG)
         constexpr uint32_t CS_ACTUAL_bm = 0x1F0000; // 16:20
-        constexpr uint8_t STEALTH_bp = 30, STST_bp = 31;
+        constexpr uint8_t STEALTH_bp = 30;
         #ifdef __AVR__
           // 8-bit optimization saves up to 12 bytes of PROGMEM per axis
           uint8_t spart = ds >> 16;
           data.cs_actual = spart & (CS_ACTUAL_bm >> 16);
           spart = ds >> 24;
           data.is_stealth = TEST(spart, STEALTH_bp - 24);
-          data.is_standstill = TEST(spart, STST_bp - 24);
         #else
           constexpr uint8_t CS_ACTUAL_sb = 16;
           data.cs_actual = (ds & CS_ACTUAL_bm) >> CS_ACTUAL_sb;
           data.is_stealth = TEST(ds, STEALTH_bp);
-          data.is_standstill = TEST(ds, STST_bp);
         #endif
-        data.sg_result_reasonable = false;
       #endif
       return data;
     }
 
   #elif HAVE_DRV(TMC2660)
 
+    void TMC_Stepper::poll_driver(MKTMC* st) {
+      st->drv_status = st->DRVSTATUS();
+      st->drv_status_ms = millis();
+    }
+
     TMC_driver_data TMC_Stepper::get_driver_data(MKTMC* st) {
       constexpr uint8_t OT_bp = 1, OTPW_bp = 2;
       constexpr uint8_t S2G_bm = 0b11000;
+      constexpr uint8_t STALL_GUARD_bp = 0;
+      constexpr uint8_t STST_bp = 7, SG_RESULT_sp = 10;
+      constexpr uint32_t SG_RESULT_bm = 0xFFC00; // 10:19
       TMC_driver_data data;
-      const auto ds = data.drv_status = st->DRVSTATUS();
+      const auto ds = data.drv_status = st->drv_status;
       uint8_t spart = ds & 0xFF;
       data.is_otpw = TEST(spart, OTPW_bp);
       data.is_ot = TEST(spart, OT_bp);
       data.is_s2g = !!(ds & S2G_bm);
-      #if ENABLED(TMC_DEBUG)
-        constexpr uint8_t STALL_GUARD_bp = 0;
-        constexpr uint8_t STST_bp = 7, SG_RESULT_sp = 10;
-        constexpr uint32_t SG_RESULT_bm = 0xFFC00; // 10:19
-        data.is_stall = TEST(spart, STALL_GUARD_bp);
-        data.is_standstill = TEST(spart, STST_bp);
-        data.sg_result = (ds & SG_RESULT_bm) >> SG_RESULT_sp;
-        data.sg_result_reasonable = true;
-      #endif
+      data.is_stall = TEST(spart, STALL_GUARD_bp);
+      data.is_standstill = TEST(spart, STST_bp);
+      data.sg_result = (ds & SG_RESULT_bm) >> SG_RESULT_sp;
+      data.sg_result_reasonable = true;
       return data;
     }
 
   #elif HAS_TMCX1X0
 
+    void TMC_Stepper::poll_driver(MKTMC* st) {
+      st->drv_status = st->DRV_STATUS();
+      st->drv_status_ms = millis();
+    }
+
     TMC_driver_data TMC_Stepper::get_driver_data(MKTMC* st) {
       constexpr uint8_t OT_bp = 25, OTPW_bp = 26;
       constexpr uint32_t S2G_bm = 0x18000000;
+      constexpr uint16_t SG_RESULT_bm = 0x3FF; // 0:9
+      constexpr uint8_t STALL_GUARD_bp = 24;
+      constexpr uint8_t STST_bp = 31;
       #if ENABLED(TMC_DEBUG)
-        constexpr uint16_t SG_RESULT_bm = 0x3FF; // 0:9
         constexpr uint8_t STEALTH_bp = 14;
         constexpr uint32_t CS_ACTUAL_bm = 0x1F0000; // 16:20
-        constexpr uint8_t STALL_GUARD_bp = 24;
-        constexpr uint8_t STST_bp = 31;
       #endif
       TMC_driver_data data;
-      const auto ds = data.drv_status = st->DRV_STATUS();
+      const auto ds = data.drv_status = st->drv_status;
+      data.sg_result = ds & SG_RESULT_bm;
       #ifdef __AVR__
         // 8-bit optimization saves up to 70 bytes of PROGMEM per axis
         uint8_t spart;
         #if ENABLED(TMC_DEBUG)
-          data.sg_result = ds & SG_RESULT_bm;
           spart = ds >> 8;
           data.is_stealth = TEST(spart, STEALTH_bp - 8);
           spart = ds >> 16;
@@ -1225,25 +1369,22 @@ bool TMC_Stepper::test_connection(MKTMC* st) {
         data.is_ot = TEST(spart, OT_bp - 24);
         data.is_otpw = TEST(spart, OTPW_bp - 24);
         data.is_s2g = !!(spart & (S2G_bm >> 24));
-        #if ENABLED(TMC_DEBUG)
-          data.is_stall = TEST(spart, STALL_GUARD_bp - 24);
-          data.is_standstill = TEST(spart, STST_bp - 24);
-          data.sg_result_reasonable = !data.is_standstill; // sg_result has no reasonable meaning while standstill
-        #endif
+        data.is_stall = TEST(spart, STALL_GUARD_bp - 24);
+        data.is_standstill = TEST(spart, STST_bp - 24);
+        data.sg_result_reasonable = !data.is_standstill; // sg_result has no reasonable meaning while standstill
 
       #else // !__AVR__
 
         data.is_ot = TEST(ds, OT_bp);
         data.is_otpw = TEST(ds, OTPW_bp);
         data.is_s2g = !!(ds & S2G_bm);
+        data.is_stall = TEST(ds, STALL_GUARD_bp);
+        data.is_standstill = TEST(ds, STST_bp);
+        data.sg_result_reasonable = !data.is_standstill; // sg_result has no reasonable meaning while standstill
         #if ENABLED(TMC_DEBUG)
           constexpr uint8_t CS_ACTUAL_sb = 16;
-          data.sg_result = ds & SG_RESULT_bm;
           data.is_stealth = TEST(ds, STEALTH_bp);
           data.cs_actual = (ds & CS_ACTUAL_bm) >> CS_ACTUAL_sb;
-          data.is_stall = TEST(ds, STALL_GUARD_bp);
-          data.is_standstill = TEST(ds, STST_bp);
-          data.sg_result_reasonable = !data.is_standstill; // sg_result has no reasonable meaning while standstill
         #endif
 
       #endif // !__AVR__
@@ -1253,99 +1394,103 @@ bool TMC_Stepper::test_connection(MKTMC* st) {
 
   #endif
 
-  void TMC_Stepper::monitor_driver(MKTMC* st, const bool need_update_error_counters, const bool need_debug_reporting) {
+  void TMC_Stepper::monitor_driver(MKTMC* st) {
 
     TMC_driver_data data = get_driver_data(st);
     if ((data.drv_status == 0xFFFFFFFF) || (data.drv_status == 0x0)) return;
 
-    if (need_update_error_counters) {
-      if (data.is_ot /* | data.s2ga | data.s2gb*/) st->error_count++;
-      else if (st->error_count > 0) st->error_count--;
+    if (data.is_ot /* | data.s2ga | data.s2gb*/) st->error_count++;
+    else if (st->error_count > 0) st->error_count--;
 
-      #if ENABLED(STOP_ON_ERROR)
-        if (st->error_count >= 10) {
-          SERIAL_EOL();
-          st->printLabel();
-          SERIAL_MSG(" driver error detected: 0x");
-          SERIAL_EV(data.drv_status, HEX);
-          if (data.is_ot) SERIAL_EM("overtemperature");
-          if (data.is_s2g) SERIAL_EM("coil short circuit");
-          #if ENABLED(TMC_DEBUG)
-            report_all(true, true, true, true);
-          #endif
-          printer.kill(PSTR("Driver error"));
-        }
-      #endif
-
-      // Report if a warning was triggered
-      if (data.is_otpw && st->otpw_count == 0) {
-        char timestamp[14];
-        duration_t elapsed = print_job_counter.duration();
-        (void)elapsed.toDigital(timestamp, true);
+    #if ENABLED(STOP_ON_ERROR)
+      if (st->error_count >= 10) {
         SERIAL_EOL();
-        SERIAL_TXT(timestamp);
-        SERIAL_MSG(": ");
         st->printLabel();
-        SERIAL_MSG(" driver overtemperature warning! (");
-        SERIAL_VAL(st->getMilliamps());
-        SERIAL_EM("mA)");
+        SERIAL_MSG(" driver error detected: 0x");
+        SERIAL_EV(data.drv_status, HEX);
+        if (data.is_ot) SERIAL_EM("overtemperature");
+        if (data.is_s2g) SERIAL_EM("coil short circuit");
+        #if ENABLED(TMC_DEBUG)
+          report_all(true, true, true, true);
+        #endif
+        printer.kill(PSTR("Driver error"));
       }
+    #endif
 
-      #if CURRENT_STEP_DOWN > 0
-        // Decrease current if is_otpw is true and driver is enabled and there's been more than 4 warnings
-        if (data.is_otpw && st->otpw_count > 4) {
-          uint16_t I_rms = st->getMilliamps();
-          if (st->isEnabled() && I_rms > 100) {
-            st->rms_current(I_rms - (CURRENT_STEP_DOWN));
-            #if ENABLED(REPORT_CURRENT_CHANGE)
-              st->printLabel();
-              SERIAL_EMV(" current decreased to ", st->getMilliamps());
-            #endif
-          }
-        }
-      #endif
-
-      if (data.is_otpw) {
-        st->otpw_count++;
-        st->flag_otpw = true;
-      }
-      else if (st->otpw_count > 0) st->otpw_count = 0;
+    // Report if a warning was triggered
+    if (data.is_otpw && st->otpw_count == 0) {
+      char timestamp[14];
+      duration_t elapsed = print_job_counter.duration();
+      (void)elapsed.toDigital(timestamp, true);
+      SERIAL_EOL();
+      SERIAL_TXT(timestamp);
+      SERIAL_MSG(": ");
+      st->printLabel();
+      SERIAL_MSG(" driver overtemperature warning! (");
+      SERIAL_VAL(st->getMilliamps());
+      SERIAL_EM("mA)");
     }
 
-    #if ENABLED(TMC_DEBUG)
-      if (need_debug_reporting) {
-        const uint32_t pwm_scale = get_pwm_scale(st);
-        st->printLabel();
-        SERIAL_MV(":", pwm_scale);
-        #if ENABLED(TMC_DEBUG)
-          #if HAS_TMCX1X0 || HAVE_DRV(TMC2208)
-            SERIAL_MV("/", data.cs_actual);
-          #endif
-          #if TMC_HAS_STALLGUARD
-            SERIAL_CHR('/');
-            if (data.sg_result_reasonable)
-              SERIAL_VAL(data.sg_result);
-            else
-              SERIAL_CHR('-');
+    #if CURRENT_STEP_DOWN > 0
+      // Decrease current if is_otpw is true and driver is enabled and there's been more than 4 warnings
+      if (data.is_otpw && st->otpw_count > 4) {
+        uint16_t I_rms = st->getMilliamps();
+        if (st->isEnabled() && I_rms > 100) {
+          st->rms_current(I_rms - (CURRENT_STEP_DOWN));
+          #if ENABLED(REPORT_CURRENT_CHANGE)
+            st->printLabel();
+            SERIAL_EMV(" current decreased to ", st->getMilliamps());
           #endif
-        #endif
-        SERIAL_CHR('|');
-        if (st->error_count)      SERIAL_CHR('E');  // Error
-        if (data.is_ot)           SERIAL_CHR('O');  // Over-temperature
-        if (data.is_otpw)         SERIAL_CHR('W');  // over-temperature pre-Warning
-        #if ENABLED(TMC_DEBUG)
-          if (data.is_stall)      SERIAL_CHR('G');  // stallGuard
-          if (data.is_stealth)    SERIAL_CHR('T');  // stealthChop
-          if (data.is_standstill) SERIAL_CHR('I');  // standstIll
-        #endif
-        if (st->flag_otpw)        SERIAL_CHR('F');  // otpw Flag
-        SERIAL_CHR('|');
-        if (st->otpw_count > 0)   SERIAL_VAL(st->otpw_count);
-        SERIAL_CHR('\t');
+        }
       }
     #endif
+
+    if (data.is_otpw) {
+      st->otpw_count++;
+      st->flag_otpw = true;
+    }
+    else if (st->otpw_count > 0) st->otpw_count = 0;
+
   }
 
+  #if ENABLED(TMC_DEBUG)
+
+    void TMC_Stepper::report_driver(MKTMC* st) {
+
+      // The mirror is not refreshed while homing, skip the old data
+      if (st->status_age() > millis_s(2 * (MONITOR_DRIVER_STATUS_INTERVAL_MS))) return;
+
+      TMC_driver_data data = get_driver_data(st);
+      if ((data.drv_status == 0xFFFFFFFF) || (data.drv_status == 0x0)) return;
+
+      const uint32_t pwm_scale = get_pwm_scale(st);
+      st->printLabel();
+      SERIAL_MV(":", pwm_scale);
+      #if HAS_TMCX1X0 || HAVE_DRV(TMC2208)
+        SERIAL_MV("/", data.cs_actual);
+      #endif
+      #if TMC_HAS_STALLGUARD
+        SERIAL_CHR('/');
+        if (data.sg_result_reasonable)
+          SERIAL_VAL(data.sg_result);
+        else
+          SERIAL_CHR('-');
+      #endif
+      SERIAL_CHR('|');
+      if (st->error_count)      SERIAL_CHR('E');  // Error
+      if (data.is_ot)           SERIAL_CHR('O');  // Over-temperature
+      if (data.is_otpw)         SERIAL_CHR('W');  // over-temperature pre-Warning
+      if (data.is_stall)        SERIAL_CHR('G');  // stallGuard
+      if (data.is_stealth)      SERIAL_CHR('T');  // stealthChop
+      if (data.is_standstill)   SERIAL_CHR('I');  // standstIll
+      if (st->flag_otpw)        SERIAL_CHR('F');  // otpw Flag
+      SERIAL_CHR('|');
+      if (st->otpw_count > 0)   SERIAL_VAL(st->otpw_count);
+      SERIAL_CHR('\t');
+    }
+
+  #endif
+
 #endif // MONITOR_DRIVER_STATUS
 
 #if ENABLED(TMC_DEBUG)
@@ -69,22 +69,22 @@
 
 struct TMC_driver_data {
   uint32_t  drv_status;
-  bool      is_otpw:  1,
-            is_ot:    1,
-            is_s2g:   1,
-            is_error: 1
+  bool      is_otpw:              1,
+            is_ot:                1,
+            is_s2g:               1,
+            is_error:             1,
+            is_stall:             1,
+            is_standstill:        1,
+            sg_result_reasonable: 1
             #if ENABLED(TMC_DEBUG)
-              , is_stall:             1
-              , is_stealth:           1
-              , is_standstill:        1
-              , sg_result_reasonable: 1
+              , is_stealth:       1
             #endif
       ;
+  uint16_t sg_result;
   #if ENABLED(TMC_DEBUG)
     #if HAS_TMCX1X0 || HAVE_DRV(TMC2208)
       uint8_t cs_actual;
     #endif
-    uint16_t sg_result;
   #endif
 };
 
@@ -132,6 +132,12 @@ class TMCStorage {
       bool flag_otpw = false;
     #endif
 
+    #if ENABLED(MONITOR_DRIVER_STATUS) || ENABLED(SPI_ENDSTOPS)
+      // Mirror of DRV_STATUS and the time of its last read
+      uint32_t drv_status     = 0;
+      millis_s drv_status_ms  = 0;
+    #endif
+
   public: /** Public Function */
 
     inline uint16_t getMilliamps()  { return val_mA; }
@@ -142,6 +148,19 @@ class TMCStorage {
       inline void clear_otpw() { flag_otpw = 0; }
     #endif
 
+    #if ENABLED(MONITOR_DRIVER_STATUS) || ENABLED(SPI_ENDSTOPS)
+      inline millis_s status_age() { return millis_s(millis()) - drv_status_ms; }
+    #endif
+
+    #if ENABLED(STALLGUARD_TELEMETRY)
+      uint16_t  sg_min        = 0xFFFF,   // Lowest load value since the last report
+                sg_boost_mA   = 0;        // Current added by the adaptive current
+      float     sg_min_speed  = 0.0f;     // Nominal speed of the block with the lowest load
+
+      // Highest current the adaptive current adds to the set one
+      inline uint16_t sg_boost_max() { return uint32_t(val_mA) * ((STALLGUARD_CURRENT_MAX) - 100) / 100; }
+    #endif
+
 };
 
 #if HAVE_DRV(TMC2208)
@@ -251,8 +270,13 @@ class TMCStorage {
 
       inline uint16_t rms_current() { return TMC2660Stepper::rms_current(); }
 
+      // The adaptive current stays on top of the set current
       inline void rms_current(uint16_t mA) {
         this->val_mA = mA;
+        #if ENABLED(STALLGUARD_TELEMETRY)
+          NOMORE(this->sg_boost_mA, this->sg_boost_max());
+          mA += this->sg_boost_mA;
+        #endif
         TMC2660Stepper::rms_current(mA);
       }
 
@@ -261,6 +285,13 @@ class TMCStorage {
         TMC2660Stepper::microsteps(ms);
       }
 
+      #if ENABLED(STALLGUARD_TELEMETRY)
+        inline void boost_current(const uint16_t mA) {
+          this->sg_boost_mA = mA;
+          TMC2660Stepper::rms_current(this->val_mA + mA);
+        }
+      #endif
+
       #if USE_SENSORLESS
         inline int16_t homing_threshold() { return TMC2660Stepper::sgt(); }
         void homing_threshold(int16_t sgt_val) {
@@ -315,13 +346,22 @@ class TMCStorage {
 
       inline uint16_t rms_current() { return TMC_MODEL_LIB::rms_current(); }
 
-      inline void rms_current(const uint16_t mA) {
+      // The adaptive current stays on top of the set current
+      inline void rms_current(uint16_t mA) {
         this->val_mA = mA;
+        #if ENABLED(STALLGUARD_TELEMETRY)
+          NOMORE(this->sg_boost_mA, this->sg_boost_max());
+          mA += this->sg_boost_mA;
+        #endif
         TMC_MODEL_LIB::rms_current(mA);
       }
 
-      inline void rms_current(const uint16_t mA, const float mult) {
+      inline void rms_current(uint16_t mA, const float mult) {
         this->val_mA = mA;
+        #if ENABLED(STALLGUARD_TELEMETRY)
+          NOMORE(this->sg_boost_mA, this->sg_boost_max());
+          mA += this->sg_boost_mA;
+        #endif
         TMC_MODEL_LIB::rms_current(mA, mult);
       }
 
@@ -346,6 +386,13 @@ class TMCStorage {
           #endif
         }
       #endif
+      #if ENABLED(STALLGUARD_TELEMETRY)
+        inline void boost_current(const uint16_t mA) {
+          this->sg_boost_mA = mA;
+          TMC_MODEL_LIB::rms_current(this->val_mA + mA);
+        }
+      #endif
+
       #if HAS_SENSORLESS
         inline int16_t homing_threshold() { return TMC_MODEL_LIB::sgt(); }
         void homing_threshold(int16_t sgt_val) {
@@ -360,32 +407,32 @@ class TMCStorage {
       #if ENABLED(SPI_ENDSTOPS)
 
         bool test_stall_status() {
-          uint16_t sg_result = 0;
+          uint32_t ds = 0;
 
           this->switchCSpin(LOW);
 
           if (this->TMC_SW_SPI != nullptr) {
             this->TMC_SW_SPI->transfer(TMC2130_n::DRV_STATUS_t::address);
-            this->TMC_SW_SPI->transfer16(0);
-            // We only care about the last 10 bits
-            sg_result = this->TMC_SW_SPI->transfer(0);
-            sg_result <<= 8;
-            sg_result |= this->TMC_SW_SPI->transfer(0);
+            ds = this->TMC_SW_SPI->transfer16(0);
+            ds <<= 16;
+            ds |= this->TMC_SW_SPI->transfer16(0);
           }
           else {
             SPI.beginTransaction(SPISettings(16000000/8, MSBFIRST, SPI_MODE3));
             // Read DRV_STATUS
             SPI.transfer(TMC2130_n::DRV_STATUS_t::address);
-            SPI.transfer16(0);
-            // We only care about the last 10 bits
-            sg_result = SPI.transfer(0);
-            sg_result <<= 8;
-            sg_result |= SPI.transfer(0);
+            ds = SPI.transfer16(0);
+            ds <<= 16;
+            ds |= SPI.transfer16(0);
             SPI.endTransaction();
           }
           this->switchCSpin(HIGH);
 
-          return (sg_result & 0x3FF) == 0;
+          // The whole register goes to the mirror, the stall needs only the last 10 bits
+          this->drv_status = ds;
+          this->drv_status_ms = millis();
+
+          return (ds & 0x3FF) == 0;
         }
 
       #endif // SPI_ENDSTOPS
@@ -459,10 +506,19 @@ class TMC_Stepper {
       static constexpr uint16_t default_sg_guard_duration = 400;
     #endif
 
+    #if ENABLED(STALLGUARD_TELEMETRY)
+      static uint16_t load_report_interval;
+      static uint8_t  load_feedrate_percentage; // Slowdown near to a stall, applied with M220
+    #endif
+
   private: /** Private Parameters */
 
     static uint16_t report_status_interval;
 
+    #if ENABLED(STALLGUARD_TELEMETRY)
+      static uint16_t load_warning;       // Drivers near to a stall, bit per driver index
+    #endif
+
   public: /** Public Function */
 
     static void init();
@@ -474,6 +530,11 @@ class TMC_Stepper {
 
     #if ENABLED(MONITOR_DRIVER_STATUS)
       static void monitor_driver();
+      static TMC_driver_data get_driver_data(MKTMC* st);
+    #endif
+
+    #if ENABLED(STALLGUARD_TELEMETRY)
+      static void report_load();
     #endif
 
     #if HAS_SENSORLESS
@@ -628,8 +689,15 @@ class TMC_Stepper {
         #endif
       #endif
 
-      static TMC_driver_data get_driver_data(MKTMC* st);
-      static void monitor_driver(MKTMC* st, const bool need_update_error_counters, const bool need_debug_reporting);
+      static void poll_driver(MKTMC* st);
+      static void monitor_driver(MKTMC* st);
+      #if ENABLED(STALLGUARD_TELEMETRY)
+        static void sample_load();
+        static void adapt_load(MKTMC* st, const uint8_t index);
+      #endif
+      #if ENABLED(TMC_DEBUG)
+        static void report_driver(MKTMC* st);
+      #endif
 
     #endif
 
@@ -74,6 +74,14 @@
   // Effective horizontal distance bridged by diagonal push rods.
   #define DELTA_RADIUS (DELTA_SMOOTH_ROD_OFFSET - DELTA_EFFECTOR_OFFSET - DELTA_CARRIAGE_OFFSET)
 
+  // Segment batching defaults for older configurations
+  #if DISABLED(DELTA_SEGMENT_BATCH)
+    #define DELTA_SEGMENT_BATCH 8
+  #endif
+  #if DISABLED(DELTA_SEGMENT_TOLERANCE)
+    #define DELTA_SEGMENT_TOLERANCE 0.01
+  #endif
+
   #if DISABLED(Z_PROBE_SPEED_FAST)
     #define Z_PROBE_SPEED_FAST  HOMING_FEEDRATE_XYZ
   #endif
@@ -511,6 +519,13 @@
   #define Z_STALL_SENSITIVITY 0
 #endif
 
+// Feedrate of the moves, scaled by M220 and by the StallGuard load slowdown
+#if ENABLED(STALLGUARD_TELEMETRY)
+  #define MMS_SCALED(MM_S)  ((MM_S)*mechanics.feedrate_percentage*tmc.load_feedrate_percentage*0.0001)
+#else
+  #define MMS_SCALED(MM_S)  ((MM_S)*mechanics.feedrate_percentage*0.01)
+#endif
+
 #define HAS_E_STEPPER_ENABLE  ( HAVE_E_DRV(TMC2660)                     \
   || ( E0_ENABLE_PIN != X_ENABLE_PIN && E1_ENABLE_PIN != X_ENABLE_PIN   \
     && E0_ENABLE_PIN != Y_ENABLE_PIN && E1_ENABLE_PIN != Y_ENABLE_PIN ) )
@@ -720,6 +735,12 @@
   #define MAX_PATH_NAME_LENGHT  (LONG_FILENAME_LENGTH * SD_MAX_FOLDER_DEPTH + SD_MAX_FOLDER_DEPTH + 1)
   #define SHORT_FILENAME_LENGTH 14
   #define GENBY_SIZE 16
+  // Read-ahead buffer of the printed file, a whole SD block on 32 bit
+  #if ENABLED(__AVR__)
+    #define SD_READ_BUFFER_SIZE 128
+  #else
+    #define SD_READ_BUFFER_SIZE 512
+  #endif
 #else
   #undef SCROLL_LONG_FILENAMES
   #undef SDCARD_SORT_ALPHA
@@ -740,10 +761,70 @@
   #define SDSORT_CACHE_NAMES false
   #define SDSORT_DYNAMIC_RAM false
 #endif
+#if ENABLED(SD_DIR_INDEX) && DISABLED(SD_DIR_INDEX_LIMIT)
+  #define SD_DIR_INDEX_LIMIT 128
+#endif
+#if ENABLED(SD_FAST_UPLOAD)
+  #if DISABLED(SD_FAST_UPLOAD_BLOCKS)
+    #define SD_FAST_UPLOAD_BLOCKS 2
+  #endif
+  #if DISABLED(SD_FAST_UPLOAD_PREALLOCATE)
+    #define SD_FAST_UPLOAD_PREALLOCATE 0
+  #endif
+  #define SD_WRITE_BUFFER_SIZE (SD_FAST_UPLOAD_BLOCKS * 512)
+#endif
 #if ENABLED(SDCARD_SORT_ALPHA)
   #define HAS_FOLDER_SORTING  (FOLDER_SORTING || ENABLED(SDSORT_GCODE))
 #endif
 #define HAS_SD_RESTART        (HAS_SD_SUPPORT && ENABLED(SD_RESTART_FILE))
+#define HAS_SD_PRINT_INDEX    (HAS_SD_SUPPORT && ENABLED(SD_PRINT_INDEX))
+
+// Binary G-code frames: sync, seq, code, mask, up to 8 int32 words, crc16
+#if ENABLED(BINARY_GCODE_PROTOCOL)
+  #define BINARY_FRAME_SYNC       0xA5
+  #define BINARY_FRAME_HEADER     4
+  #define BINARY_FRAME_MAX_SIZE   (BINARY_FRAME_HEADER + 8 * 4 + 2)
+  #define BINARY_FRAME_TIMEOUT    200   // ms of silence on the port that drop a partial frame
+#endif
+
+// Arc segmentation defaults for older configurations
+#if ENABLED(ARC_SUPPORT)
+  #if DISABLED(MIN_ARC_SEGMENT_MM)
+    #define MIN_ARC_SEGMENT_MM 0.1
+  #endif
+  #if DISABLED(ARC_CHORD_TOLERANCE)
+    #define ARC_CHORD_TOLERANCE 0.005
+  #endif
+  #if DISABLED(ARC_SEGMENT_BATCH)
+    #define ARC_SEGMENT_BATCH 4
+  #endif
+#endif
+
+// Mesh segmentation default for older configurations
+#if ENABLED(AUTO_BED_LEVELING_UBL) && DISABLED(UBL_SEGMENT_BATCH)
+  #define UBL_SEGMENT_BATCH 4
+#endif
+
+// Compact bilinear grid defaults for older configurations
+#if ENABLED(ABL_COMPACT_MESH)
+  #if DISABLED(ABL_MESH_UNIT)
+    #define ABL_MESH_UNIT 0.001
+  #endif
+  #if DISABLED(ABL_REFINE_POINTS)
+    #define ABL_REFINE_POINTS 8
+  #endif
+  #if DISABLED(ABL_REFINE_THRESHOLD)
+    #define ABL_REFINE_THRESHOLD 0.02
+  #endif
+#endif
+
+// Side pools of the planner blocks
+#if ENABLED(COLOR_MIXING_EXTRUDER) && DISABLED(MIXING_COLOR_SLOTS)
+  #define MIXING_COLOR_SLOTS 4
+#endif
+#if ENABLED(LASER_RASTER) && DISABLED(LASER_RASTER_LINES)
+  #define LASER_RASTER_LINES 4
+#endif
 
 // Other
 #define HAS_Z_PROBE_SLED      (ENABLED(Z_PROBE_SLED) && PIN_EXISTS(SLED))
@@ -1539,6 +1620,11 @@
   #define MAXIMUM_STEPPER_RATE (500000UL)
 #endif
 
+// Step events made ahead by the main loop
+#if ENABLED(STEP_TIMELINE) && DISABLED(STEP_TIMELINE_SIZE)
+  #define STEP_TIMELINE_SIZE 128
+#endif
+
 /**
  * Z STEPPER COUNT
  */
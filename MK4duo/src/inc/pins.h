@@ -21,6 +21,12 @@
  */
 #pragma once
 
+// The Linux host process has a single board, whatever the configuration
+#if ENABLED(__PLAT_LINUX__)
+  #undef MOTHERBOARD
+  #define MOTHERBOARD BOARD_LINUX_RAMPS
+#endif
+
 #define AS_QUOTED_STRING(S) #S
 #define INCLUDE_BY_MB(M)    AS_QUOTED_STRING(../boards/M.h)
 #include INCLUDE_BY_MB(MOTHERBOARD)
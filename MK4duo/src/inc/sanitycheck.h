@@ -87,6 +87,11 @@
   #endif
 #endif
 
+// GCode parser
+#if ENABLED(FASTER_GCODE_VALUES) && DISABLED(FASTER_GCODE_PARSER)
+  #error "DEPENDENCY ERROR: FASTER_GCODE_VALUES requires FASTER_GCODE_PARSER."
+#endif
+
 // Other sanitycheck files
 #include "../core/eeprom/sanitycheck.h"
 #include "../core/endstop/sanitycheck.h"
@@ -94,6 +99,7 @@
 #include "../core/heater/sanitycheck.h"
 #include "../core/heater/sensor/sanitycheck.h"
 #include "../core/mechanics/sanitycheck.h"
+#include "../core/planner/sanitycheck.h"
 #include "../core/stepper/sanitycheck.h"
 #include "../core/temperature/sanitycheck.h"
 #include "../core/tools/sanitycheck.h"
@@ -138,6 +138,10 @@
 #define MSG_ERR_LINE_NO                     "Line Number is not Last Line Number+1, Last Line: "
 #define MSG_ERR_CHECKSUM_MISMATCH           "checksum mismatch, Last Line: "
 #define MSG_ERR_NO_CHECKSUM                 "No Checksum with line number, Last Line: "
+#define MSG_ERR_BINARY_SEQUENCE             "Binary frame out of sequence, Last Frame: "
+#define MSG_ERR_BINARY_CRC                  "Binary frame CRC mismatch, Last Frame: "
+#define MSG_ERR_BINARY_LENGTH               "Binary frame longer than MAX_CMD_SIZE, Last Frame: "
+#define MSG_ERR_BINARY_TIMEOUT              "Binary frame timed out, Last Frame: "
 #define MSG_FILE_PRINTED                    "Done printing file"
 #define MSG_BEGIN_FILE_LIST                 "Begin file list"
 #define MSG_END_FILE_LIST                   "End file list"
@@ -24,6 +24,10 @@
 /**
  * @brief   Circular Queue class
  * @details Implementation of the classic ring buffer data structure
+ *
+ *          Besides the by-value enqueue/dequeue, items can be handled in place:
+ *          the producer fills the slot returned by reserve() and publishes it
+ *          with commit(), the consumer works on front() and releases it with pop().
  */
 template<typename T, uint8_t N>
 class Circular_Queue {
@@ -75,6 +79,38 @@ class Circular_Queue {
       return true;
     }
 
+    // Free slot at the tail, nullptr if the queue is full. It is queued by commit()
+    T* reserve() {
+      return this->isFull() ? nullptr : &this->buffer.queue[this->buffer.tail];
+    }
+
+    bool commit() {
+      if (this->isFull()) return false;
+
+      ++this->buffer.count;
+      if (++this->buffer.tail == this->buffer.size)
+        this->buffer.tail = 0;
+
+      return true;
+    }
+
+    // Item at the head, valid until pop()
+    T& front() {
+      return this->buffer.queue[this->buffer.head];
+    }
+
+    T& at(const uint8_t index) {
+      return this->buffer.queue[index];
+    }
+
+    void pop() {
+      if (this->isEmpty()) return;
+
+      --this->buffer.count;
+      if (++this->buffer.head == this->buffer.size)
+        this->buffer.head = 0;
+    }
+
     bool isEmpty() {
       return this->buffer.count == 0;
     }
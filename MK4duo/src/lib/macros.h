@@ -251,7 +251,7 @@
 // Feedrate scaling and conversion
 #define MMM_TO_MMS(MM_M)          ((MM_M)/60.0f)
 #define MMS_TO_MMM(MM_S)          ((MM_S)*60.0f)
-#define MMS_SCALED(MM_S)          ((MM_S)*mechanics.feedrate_percentage*0.01)
+// MMS_SCALED depends on the configuration, see conditionals_post.h
 
 // Macros for maths shortcuts
 #undef M_PI
@@ -311,6 +311,13 @@ typedef uint16_t  ptr_int_t;
   #define ISR_LA_LOOP_CYCLES  0UL
 #endif
 
+// The step timeline ISR only outputs a step event made ahead, see Stepper::timeline_step().
+// Estimate its base time without the Bresenham tracer and the trapezoid generator
+#define ISR_TIMELINE_BASE_CYCLES      320UL
+
+// So the step events can't be closer than
+#define ISR_TIMELINE_CYCLES           (ISR_TIMELINE_BASE_CYCLES + ISR_LOOP_CYCLES)
+
 /* 18 cycles maximum latency */
 #define HAL_STEPPER_TIMER_ISR() \
 extern "C" void TIMER1_COMPA_vect (void) __attribute__ ((signal, naked, used, externally_visible)); \
@@ -32,35 +32,43 @@ bool MemoryStore::access_write() { return false; }
 
 bool MemoryStore::write_data(int &pos, const uint8_t *value, size_t size, uint16_t *crc) {
 
-  while(size--) {
+  crc16(crc, value, size);
 
-    uint8_t * const p = (uint8_t * const)pos;
-    uint8_t v = *value;
-    // EEPROM has only ~100,000 write cycles,
-    // so only write bytes that have changed!
-    if (v != eeprom_read_byte(p)) {
-      eeprom_write_byte(p, v);
-      if (eeprom_read_byte(p) != v) {
+  // EEPROM has only ~100,000 write cycles,
+  // so only write the bursts that have changed!
+  uint8_t stored[MEMORY_STORE_BURST];
+  while (size) {
+    const uint8_t len = MIN(size, size_t(MEMORY_STORE_BURST - (pos & (MEMORY_STORE_BURST - 1))));
+    eeprom_read_block(stored, (const void*)pos, len);
+    if (memcmp(stored, value, len)) {
+      eeprom_update_block(value, (void*)pos, len);
+      eeprom_read_block(stored, (const void*)pos, len);
+      if (memcmp(stored, value, len)) {
         SERIAL_LM(ECHO, MSG_ERR_EEPROM_WRITE);
         return true;
       }
     }
+    pos += len;
+    value += len;
+    size -= len;
+  }
 
-    crc16(crc, &v, 1);
-    pos++;
-    value++;
-  };
   return false;
 }
 
 bool MemoryStore::read_data(int &pos, uint8_t *value, size_t size, uint16_t *crc, const bool writing/*=true*/) {
-  do {
-    uint8_t c = eeprom_read_byte((uint8_t*)pos);
-    if (writing) *value = c;
-    crc16(crc, &c, 1);
-    pos++;
-    value++;
-  } while (--size);
+
+  uint8_t stored[MEMORY_STORE_BURST];
+  while (size) {
+    const uint8_t len = MIN(size, size_t(MEMORY_STORE_BURST));
+    uint8_t * const dest = writing ? value : stored;
+    eeprom_read_block(dest, (const void*)pos, len);
+    crc16(crc, dest, len);
+    pos += len;
+    value += len;
+    size -= len;
+  }
+
   return false;
 }
 
@@ -603,8 +603,8 @@ void HAL::Tick() {
   // Software PWM modulation
   softpwm.spin();
 
-  // Event 100 ms
-  if (expired(&cycle_100_ms, 100U)) thermalManager.spin();
+  // Event 100 ms, the heaters control runs from idle()
+  if (expired(&cycle_100_ms, 100U)) thermalManager.request_spin();
 
   // Event 1.0 Second
   if (expired(&cycle_1s_ms, 1000U)) printer.check_periodical_actions();
@@ -686,9 +686,6 @@ void HAL::Tick() {
 
   AnalogInStartConversion();
 
-  // Update the raw values if they've been read. Else we could be updating them during reading.
-  if (HAL::Analog_is_ready) thermalManager.set_current_temp_raw();
-
   // Tick endstops state, if required
   endstops.Tick();
 
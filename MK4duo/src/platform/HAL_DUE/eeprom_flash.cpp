@@ -48,6 +48,10 @@
  * bytes, but we can emulate endurance for a given percent of
  * bytes.
  *
+ * A RAM image of the whole emulated EEPROM is built once from the
+ * FLASH pages at init and kept updated by every write, so a read
+ * never has to scan the RAM buffer or the FLASH pages.
+ *
  */
 
 #ifdef ARDUINO_ARCH_SAM
@@ -129,7 +133,8 @@ static const FLASH_SECTOR_T* getFlashStorage(int page) {
 
 static uint8_t  buffer[256] = { 0 },  // The RAM buffer to accumulate writes
                 curPage = 0,          // Current FLASH page inside the group
-                curGroup = 0xFF;      // Current FLASH group
+                curGroup = 0xFF,      // Current FLASH group
+                image[EEPROMSize];    // The RAM image of the emulated EEPROM
 
 //#define EE_EMU_DEBUG
 #if ENABLED(EE_EMU_DEBUG)
@@ -416,172 +421,41 @@ static bool ee_PageErase(uint16_t page) {
 
   return true;
 }
-static uint8_t ee_Read(uint32_t address, bool excludeRAMBuffer=false) {
-
-  uint32_t baddr;
-  uint32_t blen;
+static uint8_t ee_Read(uint32_t address) {
 
   // If we were requested an address outside of the emulated range, fail now
   if (address >= EEPROMSize)
     return false;
 
-  // Check that the value is not contained in the RAM buffer
-  if (!excludeRAMBuffer) {
-    int i = 0;
-    while (i <= (PageSize - 4)) { /* (PageSize - 4) because otherwise, there is not enough room for data and headers */
-
-      // Get the address of the block
-      baddr = buffer[i] | (buffer[i + 1] << 8);
-
-      // Get the length of the block
-      blen = buffer[i + 2];
-
-      // If we reach the end of the list, break loop
-      if (blen == 0xFF)
-        break;
-
-      // Check if data is contained in this block
-      if (address >= baddr &&
-        address < (baddr + blen)) {
-
-        // Yes, it is contained. Return it!
-        return buffer[i + 3 + address - baddr];
-      }
-
-      // As blocks are always sorted, if the starting address of this block is higher
-      // than the address we are looking for, break loop now - We wont find the value
-      // associated to the address
-      if (baddr > address)
-        break;
-
-      // Jump to the next block
-      i += 3 + blen;
-    }
-  }
-
-  // It is NOT on the RAM buffer. It could be stored in FLASH. We are
-  //  ensured on a given FLASH page, address contents are never repeated
-  //  but on different pages, there is no such warranty, so we must go
-  //  backwards from the last written FLASH page to the first one.
-  for (int page = curPage - 1; page >= 0; --page) {
-
-    // Get a pointer to the flash page
-    uint8_t* pflash = (uint8_t*)getFlashStorage(page + curGroup * PagesPerGroup);
-
-    uint16_t i = 0;
-    while (i <= (PageSize - 4)) { /* (PageSize - 4) because otherwise, there is not enough room for data and headers */
-
-      // Get the address of the block
-      baddr = pflash[i] | (pflash[i + 1] << 8);
-
-      // Get the length of the block
-      blen = pflash[i + 2];
-
-      // If we reach the end of the list, break loop
-      if (blen == 0xFF)
-        break;
-
-      // Check if data is contained in this block
-      if (address >= baddr && address < (baddr + blen))
-        return pflash[i + 3 + address - baddr]; // Yes, it is contained. Return it!
-
-      // As blocks are always sorted, if the starting address of this block is higher
-      // than the address we are looking for, break loop now - We wont find the value
-      // associated to the address
-      if (baddr > address) break;
-
-      // Jump to the next block
-      i += 3 + blen;
-    }
-  }
-
-  // If reached here, value is not stored, so return its default value
-  return 0xFF;
+  // The image holds the FLASH pages with the RAM buffer applied
+  return image[address];
 }
 
-static uint32_t ee_GetAddrRange(uint32_t address, bool excludeRAMBuffer=false) {
-  uint32_t  baddr,
-            blen,
-            nextAddr = 0xFFFF,
-            nextRange = 0;
-
-  // Check that the value is not contained in the RAM buffer
-  if (!excludeRAMBuffer) {
-    uint16_t i = 0;
-    while (i <= (PageSize - 4)) { /* (PageSize - 4) because otherwise, there is not enough room for data and headers */
-
-      // Get the address of the block
-      baddr = buffer[i] | (buffer[i + 1] << 8);
-
-      // Get the length of the block
-      blen = buffer[i + 2];
-
-      // If we reach the end of the list, break loop
-      if (blen == 0xFF) break;
-
-      // Check if address and address + 1 is contained in this block
-      if (address >= baddr && address < (baddr + blen))
-        return address | ((blen - address + baddr) << 16); // Yes, it is contained. Return it!
-
-      // Otherwise, check if we can use it as a limit
-      if (baddr > address && baddr < nextAddr) {
-        nextAddr = baddr;
-        nextRange = blen;
-      }
-
-      // As blocks are always sorted, if the starting address of this block is higher
-      // than the address we are looking for, break loop now - We wont find the value
-      // associated to the address
-      if (baddr > address) break;
-
-      // Jump to the next block
-      i += 3 + blen;
-    }
-  }
-
-  // It is NOT on the RAM buffer. It could be stored in FLASH. We are
-  //  ensured on a given FLASH page, address contents are never repeated
-  //  but on different pages, there is no such warranty, so we must go
-  //  backwards from the last written FLASH page to the first one.
-  for (int page = curPage - 1; page >= 0; --page) {
-
-    // Get a pointer to the flash page
-    uint8_t* pflash = (uint8_t*)getFlashStorage(page + curGroup * PagesPerGroup);
-
-    uint16_t i = 0;
-    while (i <= (PageSize - 4)) { /* (PageSize - 4) because otherwise, there is not enough room for data and headers */
+/**
+ * Apply the blocks of a FLASH page to the RAM image
+ */
+static void ee_ApplyPage(const uint8_t* pflash) {
 
-      // Get the address of the block
-      baddr = pflash[i] | (pflash[i + 1] << 8);
+  uint16_t i = 0;
+  while (i <= (PageSize - 4)) { /* (PageSize - 4) because otherwise, there is not enough room for data and headers */
 
-      // Get the length of the block
-      blen = pflash[i + 2];
+    // Get the address of the block
+    const uint32_t baddr = pflash[i] | (pflash[i + 1] << 8);
 
-      // If we reach the end of the list, break loop
-      if (blen == 0xFF) break;
+    // Get the length of the block
+    const uint32_t blen = pflash[i + 2];
 
-      // Check if data is contained in this block
-      if (address >= baddr && address < (baddr + blen))
-        return address | ((blen - address + baddr) << 16); // Yes, it is contained. Return it!
+    // If we reach the end of the list, break loop
+    if (blen == 0xFF) break;
 
-      // Otherwise, check if we can use it as a limit
-      if (baddr > address && baddr < nextAddr) {
-        nextAddr = baddr;
-        nextRange = blen;
-      }
+    // Skip a damaged block
+    if (i + 3 + blen > PageSize || baddr + blen > EEPROMSize) break;
 
-      // As blocks are always sorted, if the starting address of this block is higher
-      // than the address we are looking for, break loop now - We wont find the value
-      // associated to the address
-      if (baddr > address) break;
+    memcpy(&image[baddr], &pflash[i + 3], blen);
 
-      // Jump to the next block
-      i += 3 + blen;
-    }
+    // Jump to the next block
+    i += 3 + blen;
   }
-
-  // If reached here, we will return the next valid address
-  return nextAddr | (nextRange << 16);
 }
 
 static bool ee_IsPageClean(int page) {
@@ -640,107 +514,76 @@ static bool ee_Flush(uint32_t overrideAddress=0xFFFFFFFF, uint8_t overrideData=0
   int curwPage = 0, curwGroup = curGroup + 1;
   if (curwGroup >= GroupCount) curwGroup = 0;
 
-  uint32_t rdAddr = 0;
-  do {
+  // The RAM image already holds the override value
+  for (uint32_t rdAddr = 0; rdAddr < EEPROMSize; ++rdAddr) {
 
-    // Get the next valid range
-    uint32_t addrRange = ee_GetAddrRange(rdAddr, true);
+    // Get the value
+    const uint8_t rdValue = image[rdAddr];
 
-    // Make sure not to skip the override address, if specified
-    int rdRange;
-    if (overrideAddress < EEPROMSize &&
-      rdAddr <= overrideAddress &&
-      (addrRange & 0xFFFF) > overrideAddress) {
+    // Do not bother storing default values
+    if (rdValue != 0xFF) {
 
-      rdAddr = overrideAddress;
-      rdRange = 1;
-    }
-    else {
-      rdAddr = addrRange & 0xFFFF;
-      rdRange = addrRange >> 16;
-    }
+      // If we have room, add it to the buffer
+      if (buffer[i + 2] == 0xFF) {
 
-    // If no range, break loop
-    if (rdRange == 0)
-      break;
+        // Uninitialized buffer, just add it!
+        buffer[i] = rdAddr & 0xFF;
+        buffer[i + 1] = (rdAddr >> 8) & 0xFF;
+        buffer[i + 2] = 1;
+        buffer[i + 3] = rdValue;
 
-    do {
+      }
+      else {
+        // Buffer already has contents. Check if we can extend it
 
-      // Get the value
-      uint8_t rdValue = overrideAddress == rdAddr ? overrideData : ee_Read(rdAddr, true);
+        // Get the address of the block
+        uint32_t baddr = buffer[i] | (buffer[i + 1] << 8);
 
-      // Do not bother storing default values
-      if (rdValue != 0xFF) {
+        // Get the length of the block
+        uint32_t blen = buffer[i + 2];
 
-        // If we have room, add it to the buffer
-        if (buffer[i + 2] == 0xFF) {
+        // Can we expand it ?
+        if (rdAddr == (baddr + blen) &&
+          i < (PageSize - 4) && /* This block has a chance to contain data AND */
+          buffer[i + 2] < (PageSize - i - 3)) {/* There is room for this block to be expanded */
 
-          // Uninitialized buffer, just add it!
-          buffer[i] = rdAddr & 0xFF;
-          buffer[i + 1] = (rdAddr >> 8) & 0xFF;
-          buffer[i + 2] = 1;
-          buffer[i + 3] = rdValue;
+          // Yes, do it
+          ++buffer[i + 2];
+
+          // And store the value
+          buffer[i + 3 + rdAddr - baddr] = rdValue;
 
         }
         else {
-          // Buffer already has contents. Check if we can extend it
 
-          // Get the address of the block
-          uint32_t baddr = buffer[i] | (buffer[i + 1] << 8);
+          // No, we can't expand it - Skip the existing block
+          i += 3 + blen;
 
-          // Get the length of the block
-          uint32_t blen = buffer[i + 2];
+          // Can we create a new slot ?
+          if (i > (PageSize - 4)) {
 
-          // Can we expand it ?
-          if (rdAddr == (baddr + blen) &&
-            i < (PageSize - 4) && /* This block has a chance to contain data AND */
-            buffer[i + 2] < (PageSize - i - 3)) {/* There is room for this block to be expanded */
+            // Not enough space - Write the current buffer to FLASH
+            ee_PageWrite(curwPage + curwGroup * PagesPerGroup, buffer);
 
-            // Yes, do it
-            ++buffer[i + 2];
+            // Advance write page (as we are compacting, should never overflow!)
+            ++curwPage;
 
-            // And store the value
-            buffer[i + 3 + rdAddr - baddr] = rdValue;
+            // Clear RAM buffer
+            memset(buffer, 0xFF, sizeof(buffer));
 
+            // Start fresh */
+            i = 0;
           }
-          else {
-
-            // No, we can't expand it - Skip the existing block
-            i += 3 + blen;
-
-            // Can we create a new slot ?
-            if (i > (PageSize - 4)) {
-
-              // Not enough space - Write the current buffer to FLASH
-              ee_PageWrite(curwPage + curwGroup * PagesPerGroup, buffer);
 
-              // Advance write page (as we are compacting, should never overflow!)
-              ++curwPage;
-
-              // Clear RAM buffer
-              memset(buffer, 0xFF, sizeof(buffer));
-
-              // Start fresh */
-              i = 0;
-            }
-
-            // Enough space, add the new block
-            buffer[i] = rdAddr & 0xFF;
-            buffer[i + 1] = (rdAddr >> 8) & 0xFF;
-            buffer[i + 2] = 1;
-            buffer[i + 3] = rdValue;
-          }
+          // Enough space, add the new block
+          buffer[i] = rdAddr & 0xFF;
+          buffer[i + 1] = (rdAddr >> 8) & 0xFF;
+          buffer[i + 2] = 1;
+          buffer[i + 3] = rdValue;
         }
       }
-
-      // Go to the next address
-      ++rdAddr;
-
-      // Repeat for bytes of this range
-    } while (--rdRange);
-
-    // Repeat until we run out of ranges
-  } while (rdAddr < EEPROMSize);
+    }
+  }
 
   // We must erase the previous group, in preparation for the next swap
   for (int page = 0; page < curPage; page++) {
@@ -760,6 +603,10 @@ static bool ee_Write(uint32_t address, uint8_t data) {
   // If we were requested an address outside of the emulated range, fail now
   if (address >= EEPROMSize) return false;
 
+  // Nothing to store if the value is already there
+  if (image[address] == data) return true;
+  image[address] = data;
+
   // Lets check if we have a block with that data previously defined. Block
   //  start addresses are always sorted in ascending order
   uint16_t i = 0;
@@ -963,6 +810,11 @@ static void ee_Init() {
       ee_PageErase(curGroup * PagesPerGroup + page);
     }
   }
+
+  // Build the RAM image, the later pages override the earlier ones
+  memset(image, 0xFF, sizeof(image));
+  for (int page = 0; page < curPage; page++)
+    ee_ApplyPage((const uint8_t*)getFlashStorage(curGroup * PagesPerGroup + page));
 }
 
 uint8_t eeprom_read_byte(uint8_t* addr) {
@@ -976,23 +828,19 @@ void eeprom_write_byte(uint8_t* addr, uint8_t value) {
 }
 
 void eeprom_update_block(const void* pos, void* eeprom_address, size_t n) {
-  uint8_t* dst = (uint8_t*)pos;
-  uint8_t* src = (uint8_t*)eeprom_address;
-  while (n--) {
-    eeprom_write_byte(dst, *src);
-    ++dst;
-    ++src;
-  }
+  ee_Init();
+  const uint8_t* src = (const uint8_t*)pos;
+  uint32_t address = (uint32_t)eeprom_address;
+  while (n--) ee_Write(address++, *src++);
 }
 
 void eeprom_read_block(void* pos, const void* eeprom_address, size_t n) {
+  ee_Init();
   uint8_t* dst = (uint8_t*)pos;
-  uint8_t* src = (uint8_t*)eeprom_address;
-  while (n--) {
-    *dst = eeprom_read_byte(src);
-    ++dst;
-    ++src;
-  }
+  const uint32_t address = (uint32_t)eeprom_address;
+  const size_t inside = address < EEPROMSize ? MIN(n, size_t(EEPROMSize - address)) : 0;
+  if (inside) memcpy(dst, &image[address], inside);
+  memset(dst + inside, 0, n - inside);
 }
 
 void eeprom_flush(void) {
@@ -0,0 +1,560 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * This is the main Hardware Abstraction Layer (HAL).
+ * To make the firmware work with different processors and toolchains,
+ * all hardware related code should be packed into the hal files.
+ *
+ * Description: HAL for the Linux host process
+ *
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * __PLAT_LINUX__
+ */
+
+#ifdef __PLAT_LINUX__
+
+// --------------------------------------------------------------------------
+// Includes
+// --------------------------------------------------------------------------
+#include "../../../MK4duo.h"
+#include <time.h>
+#include <errno.h>
+
+// --------------------------------------------------------------------------
+// Local defines
+// --------------------------------------------------------------------------
+
+// Raw value of a 100k NTC with 4k7 pullup at about 25°C
+#define ADC_SIM_ROOM_TEMP   3900
+
+// Travel of the simulated carriages, they start at the middle
+#define SIM_AXIS_TRAVEL_MM    400
+#define SIM_POSITION_UNKNOWN  INT32_MIN
+
+// --------------------------------------------------------------------------
+// Public Variables
+// --------------------------------------------------------------------------
+
+uint8_t MCUSR;
+
+fastio_t fastio[NUM_DIGITAL_PINS];
+
+int16_t   HAL::AnalogInputValues[NUM_ANALOG_INPUTS] = { 0 };
+bool      HAL::Analog_is_ready = false;
+uint16_t  HAL::AnalogInputSim[NUM_ANALOG_INPUTS];
+
+#if HAS_HOTENDS
+  ADCAveragingFilter HAL::sensorFilters[HOTENDS];
+#endif
+#if HAS_BEDS
+  ADCAveragingFilter HAL::BEDsensorFilters[BEDS];
+#endif
+#if HAS_CHAMBERS
+  ADCAveragingFilter HAL::CHAMBERsensorFilters[CHAMBERS];
+#endif
+#if HAS_COOLERS
+  ADCAveragingFilter HAL::COOLERsensorFilters[COOLERS];
+#endif
+
+// --------------------------------------------------------------------------
+// Private Variables
+// --------------------------------------------------------------------------
+static uint64_t report_start_ns = 0;
+
+typedef struct {
+  pin_t       step_pin, dir_pin, min_pin, max_pin;
+  EndstopEnum min_endstop, max_endstop;
+  volatile int32_t position;  // Steps from the min endstop
+} sim_axis_t;
+
+static sim_axis_t sim_axis[XYZ] = {
+  { X_STEP_PIN, X_DIR_PIN, X_MIN_PIN, X_MAX_PIN, X_MIN, X_MAX, SIM_POSITION_UNKNOWN },
+  { Y_STEP_PIN, Y_DIR_PIN, Y_MIN_PIN, Y_MAX_PIN, Y_MIN, Y_MAX, SIM_POSITION_UNKNOWN },
+  { Z_STEP_PIN, Z_DIR_PIN, Z_MIN_PIN, Z_MAX_PIN, Z_MIN, Z_MAX, SIM_POSITION_UNKNOWN }
+};
+
+// --------------------------------------------------------------------------
+// Arduino core
+// --------------------------------------------------------------------------
+
+uint32_t millis(void) { return uint32_t(HAL_clock_ns() / 1000000ULL); }
+uint32_t micros(void) { return uint32_t(HAL_clock_ns() / 1000ULL); }
+
+// Sleep on the real clock, the timer signals keep running meanwhile
+void delay(const uint32_t ms) {
+  const uint64_t end = HAL_clock_ns() + uint64_t(ms) * 1000000ULL;
+  for (;;) {
+    const uint64_t now = HAL_clock_ns();
+    if (now >= end) break;
+    const uint64_t real = uint64_t(double(end - now) / HAL_time_scale);
+    struct timespec ts;
+    ts.tv_sec  = real / 1000000000ULL;
+    ts.tv_nsec = real % 1000000000ULL;
+    nanosleep(&ts, NULL);   // EINTR on every ISR, just check again
+  }
+}
+
+void delayMicroseconds(const uint32_t us) { HAL_delay_ns(us * 1000UL); }
+
+void yield(void) { }
+
+void pinMode(const uint8_t pin, const uint8_t mode)       { HAL::pinMode(pin, mode); }
+void digitalWrite(const uint8_t pin, const uint8_t value) { HAL::digitalWrite(pin, value); }
+int digitalRead(const uint8_t pin)                        { return HAL::digitalRead(pin); }
+void analogWrite(const uint8_t pin, const int value)      { HAL::analogWrite(pin, value); }
+
+int analogRead(const uint8_t pin) {
+  const uint8_t ch = pin >= A0 ? pin - A0 : pin;
+  return ch < NUM_ANALOG_INPUTS ? HAL::AnalogInputSim[ch] : 0;
+}
+
+void noInterrupts(void) { DISABLE_ISRS(); }
+void interrupts(void)   { ENABLE_ISRS(); }
+
+// Short delays spin on the virtual clock
+void HAL_delay_ns(const uint32_t ns) {
+  const uint64_t end = HAL_clock_ns() + ns;
+  while (HAL_clock_ns() < end) { /* nada */ }
+}
+
+// disable interrupts
+void cli(void) {
+  noInterrupts();
+}
+
+// enable interrupts
+void sei(void) {
+  interrupts();
+}
+
+extern "C" int freeMemory() { return 0x7FFFFFFF; }
+
+char *dtostrf(double __val, signed char __width, unsigned char __prec, char *__s) {
+  sprintf(__s, "%*.*f", __width, __prec, __val);
+  return __s;
+}
+
+// Tone
+static pin_t tone_pin;
+volatile static int32_t toggles;
+
+void tone(const pin_t _pin, const uint16_t frequency, const uint16_t duration) {
+  tone_pin = _pin;
+  toggles = 2 * frequency * duration / 1000;
+  HAL_timer_start(TONE_TIMER_NUM, 2 * frequency);
+}
+
+void noTone(const pin_t _pin) {
+  HAL_timer_disable_interrupt(TONE_TIMER_NUM);
+  HAL::digitalWrite(_pin, LOW);
+}
+
+// --------------------------------------------------------------------------
+// Host side
+// --------------------------------------------------------------------------
+
+void HAL_LINUX_set_pin(const pin_t pin, const bool value) {
+  if (VALID_PIN(pin)) fastio[pin].value = value;
+}
+
+void HAL_LINUX_set_analog(const pin_t pin, const uint16_t value) {
+  const pin_t ch = pin >= A0 ? pin - A0 : pin;
+  if (WITHIN(ch, 0, NUM_ANALOG_INPUTS - 1)) HAL::AnalogInputSim[ch] = value;
+}
+
+/**
+ * Simulated carriages: the step pins move them by one step
+ * and the endstop pins read their position with the configured logic.
+ * The steps per unit are known only after the settings are loaded,
+ * so the carriages are placed at the middle of the travel on first use.
+ */
+static int32_t sim_travel(const uint8_t axis) {
+  return int32_t(SIM_AXIS_TRAVEL_MM * mechanics.data.axis_steps_per_mm[axis]);
+}
+
+static sim_axis_t& sim_get(const uint8_t axis) {
+  sim_axis_t &sim = sim_axis[axis];
+  if (sim.position == SIM_POSITION_UNKNOWN) sim.position = sim_travel(axis) / 2;
+  return sim;
+}
+
+void HAL_LINUX_sim_step(const uint8_t axis) {
+  sim_axis_t &sim = sim_get(axis);
+  if (READ(sim.dir_pin) != stepper.isStepDir((AxisEnum)axis)) sim.position++; else sim.position--;
+}
+
+bool HAL_LINUX_sim_endstop(const pin_t pin) {
+  const uint8_t axis = fastio[pin].sim_endstop - 1;
+  const sim_axis_t &sim = sim_get(axis);
+  if (pin == sim.min_pin)
+    return (sim.position <= 0) != endstops.isLogic(sim.min_endstop);
+  else
+    return (sim.position >= sim_travel(axis)) != endstops.isLogic(sim.max_endstop);
+}
+
+#if ENABLED(SENSOR_LOOKUP_TABLE)
+
+  // Compare the table with the formula at every adc value
+  static void report_sensor_table(const char * const name, const uint8_t h, Heater &heater) {
+    if (!heater.sensor_table.valid) return;
+    float max_error = 0;
+    for (int32_t adc = 0; adc <= AD_RANGE; adc++) {
+      const float t = heater.data.sensor.adc_temperature(adc);
+      if (WITHIN(t, -20, 400)) NOLESS(max_error, ABS(heater.sensor_table.getTemperature(adc) - t));
+    }
+    fprintf(stderr, "  %s %u sensor %i, worst error %.3f C between -20 and 400 C\n",
+      name, h, heater.data.sensor.type, double(max_error)
+    );
+  }
+
+#endif
+
+#if ENABLED(PLANNER_BENCHMARK)
+
+  /**
+   * Stand-in for the stepper of the benchmark build, run by every idle().
+   * The oldest block is executed when the planner is full or when no block
+   * was queued since the last call (waiting for pool entries or synchronize),
+   * so the lookahead stays full while the trace is replayed.
+   */
+  void HAL_LINUX_bench_idle() {
+    static uint8_t last_head = 0xFF;
+    const uint8_t head = planner.block_buffer_head;
+    if (planner.has_blocks_queued() && (planner.is_full() || head == last_head)) {
+      planner.delay_before_delivering = 0;
+      if (planner.get_current_block())
+        planner.discard_current_block();
+      else
+        CBI(planner.block_buffer[planner.block_buffer_tail].flag, BLOCK_BIT_RECALCULATE);
+    }
+    last_head = head;
+  }
+
+#endif
+
+/**
+ * Print the timer statistics on stderr.
+ * Headroom is the share of real time left to the main loop,
+ * the stepper budget compares the average ISR against the
+ * shortest interval allowed at the maximum step rate.
+ * Faster than real time, or with most of the stepper matches
+ * missed, the host does not keep up with the virtual clock and
+ * only the counts are printed.
+ */
+void HAL_LINUX_report() {
+  static const char * const name[NUM_HARDWARE_TIMERS] = { "stepper", "tick", "tone" };
+  const uint64_t elapsed = HAL_clock_ns() - report_start_ns;
+  const double real_elapsed = double(elapsed) / HAL_time_scale;
+  const tTimerStats &stepper_stats = TimerStats[STEPPER_TIMER_NUM];
+  const bool timings = HAL_time_scale <= 1.0 && stepper_stats.overruns * 10UL <= stepper_stats.count;
+  double busy = 0;
+
+  fprintf(stderr, "HAL_LINUX: %.3f s virtual, time scale %.2f\n", double(elapsed) / 1e9, HAL_time_scale);
+  for (uint8_t t = 0; t < NUM_HARDWARE_TIMERS; t++) {
+    const tTimerStats &stats = TimerStats[t];
+    busy += double(stats.total_ns);
+    if (timings)
+      fprintf(stderr, "  %-8s isr %10u  overruns %8u  avg %7.0f ns  max %8u ns  max latency %8u ns\n",
+        name[t], stats.count, stats.overruns,
+        stats.count ? double(stats.total_ns) / stats.count : 0.0,
+        stats.max_ns, stats.max_latency_ns
+      );
+    else
+      fprintf(stderr, "  %-8s isr %10u\n", name[t], stats.count);
+  }
+
+  if (!timings)
+    fprintf(stderr, "  ISR timings not reported at time scale %.2f, %u of %u stepper matches missed. Run with -s 1 or lower to measure them\n",
+      HAL_time_scale, stepper_stats.overruns, stepper_stats.count
+    );
+  else if (real_elapsed > 0)
+    fprintf(stderr, "  ISR load %.2f%%, headroom %.2f%%\n", 100.0 * busy / real_elapsed, 100.0 - 100.0 * busy / real_elapsed);
+
+  if (timings && HAL_frequency_limit[0]) {
+    const double budget_ns = 1e9 / double(HAL_frequency_limit[0]);
+    fprintf(stderr, "  stepper budget %.0f ns at %u Hz, average used %.1f%%\n",
+      budget_ns, HAL_frequency_limit[0], stepper_stats.count ? 100.0 * double(stepper_stats.total_ns) / stepper_stats.count / budget_ns : 0.0
+    );
+  }
+
+  #if ENABLED(PLANNER_BENCHMARK)
+    static const char * const phase[BENCH_COUNT] = { "buffer_steps", "fill_block", "recalculate", "reverse_pass", "forward_pass", "trapezoids" };
+    fprintf(stderr, "Planner benchmark, BLOCK_BUFFER_SIZE %u\n", BLOCK_BUFFER_SIZE);
+    for (uint8_t p = 0; p < BENCH_COUNT; p++) {
+      const planner_bench_t &b = planner.bench[p];
+      fprintf(stderr, "  %-13s calls %9u  avg %9.3f us  max %9.3f us\n",
+        phase[p], b.count, b.count ? double(b.total_ns) / b.count / 1000.0 : 0.0, double(b.max_ns) / 1000.0
+      );
+    }
+    const planner_bench_t &steps = planner.bench[BENCH_BUFFER_STEPS];
+    if (steps.count)
+      fprintf(stderr, "  %.3f us per block, worst recalculate %.3f us, %.0f blocks/s sustainable\n",
+        double(steps.total_ns) / steps.count / 1000.0,
+        double(planner.bench[BENCH_RECALCULATE].max_ns) / 1000.0,
+        1e9 * steps.count / double(steps.total_ns)
+      );
+    #if ENABLED(PLANNER_FIXED_POINT)
+      const planner_fixed_check_t &check = planner.fixed_check;
+      fprintf(stderr, "  fixed point trapezoids %u, %u differ from float, max error %u steps\n",
+        check.count, check.differ, check.max_steps
+      );
+    #endif
+  #endif
+
+  #if ENABLED(SENSOR_LOOKUP_TABLE)
+    fprintf(stderr, "Sensor lookup tables, AD_RANGE %u\n", AD_RANGE);
+    LOOP_HOTEND() report_sensor_table("hotend", h, hotends[h]);
+    #if HAS_BEDS
+      LOOP_BED() report_sensor_table("bed", h, beds[h]);
+    #endif
+    #if HAS_CHAMBERS
+      LOOP_CHAMBER() report_sensor_table("chamber", h, chambers[h]);
+    #endif
+    #if HAS_COOLERS
+      LOOP_COOLER() report_sensor_table("cooler", h, coolers[h]);
+    #endif
+  #endif
+}
+
+// --------------------------------------------------------------------------
+// HAL
+// --------------------------------------------------------------------------
+
+HAL::HAL() {
+  // ctor
+}
+
+HAL::~HAL() {
+  // dtor
+}
+
+// do any hardware-specific initialization here
+void HAL::hwSetup(void) {
+  for (uint8_t ch = 0; ch < NUM_ANALOG_INPUTS; ch++)
+    if (!AnalogInputSim[ch]) AnalogInputSim[ch] = ADC_SIM_ROOM_TEMP;
+  LOOP_XYZ(axis) {
+    sim_axis_t &sim = sim_axis[axis];
+    if (VALID_PIN(sim.step_pin)) fastio[sim.step_pin].sim_axis    = axis + 1;
+    if (VALID_PIN(sim.min_pin))  fastio[sim.min_pin].sim_endstop  = axis + 1;
+    if (VALID_PIN(sim.max_pin))  fastio[sim.max_pin].sim_endstop  = axis + 1;
+  }
+  report_start_ns = HAL_clock_ns();
+  // The 1 kHz tick replaces the SysTick
+  HAL_timer_start(TICK_TIMER_NUM, 1000);
+}
+
+// Print apparent cause of start/restart
+void HAL::showStartReason() {
+  SERIAL_EM(MSG_POWERUP);
+}
+
+// Initialize ADC channels
+void HAL::analogStart(void) {
+
+  #if HAS_HOTENDS
+    LOOP_HOTEND() sensorFilters[h].Init(0);
+  #endif
+  #if HAS_BEDS
+    LOOP_BED() BEDsensorFilters[h].Init(0);
+  #endif
+  #if HAS_CHAMBERS
+    LOOP_CHAMBER() CHAMBERsensorFilters[h].Init(0);
+  #endif
+  #if HAS_COOLERS
+    LOOP_COOLER() COOLERsensorFilters[h].Init(0);
+  #endif
+
+}
+
+void HAL::AdcChangePin(const pin_t old_pin, const pin_t new_pin) {
+  UNUSED(old_pin);
+  UNUSED(new_pin);
+}
+
+void HAL::resetHardware() {
+  fprintf(stderr, "HAL_LINUX: reset requested\n");
+  exit(0);
+}
+
+bool HAL::pwm_status(const pin_t pin) {
+  return VALID_PIN(pin);
+}
+
+bool HAL::tc_status(const pin_t pin) {
+  UNUSED(pin);
+  return false;
+}
+
+void HAL::analogWrite(const pin_t pin, uint32_t ulValue, const uint16_t freq/*=1000U*/, const bool hwpwm/*=true*/) {
+  UNUSED(freq);
+  UNUSED(hwpwm);
+  if (!VALID_PIN(pin)) return;
+  fastio[pin].mode  = OUTPUT;
+  fastio[pin].pwm   = ulValue;
+  fastio[pin].value = ulValue > 0;
+}
+
+// SPI, nothing is connected
+uint8_t HAL::spiTransfer(uint8_t nbyte) { UNUSED(nbyte); return 0xFF; }
+void HAL::spiBegin() { }
+void HAL::spiInit(uint8_t spiRate) { UNUSED(spiRate); }
+uint8_t HAL::spiReceive() { return 0xFF; }
+void HAL::spiReadBlock(uint8_t* buf, uint16_t nbyte) { memset(buf, 0xFF, nbyte); }
+void HAL::spiSend(uint8_t nbyte) { UNUSED(nbyte); }
+void HAL::spiSend(const uint8_t* buf , size_t nbyte) { UNUSED(buf); UNUSED(nbyte); }
+void HAL::spiSendBlock(uint8_t token, const uint8_t* buf) { UNUSED(token); UNUSED(buf); }
+
+/**
+ * Task Tick is is called 1000 timer per second.
+ * It is used to update pwm values for heater and some other frequent jobs.
+ *
+ *  - Manage PWM to all the heaters and fan
+ *  - Read the simulated raw ADC sensor values
+ *  - For ENDSTOP_INTERRUPTS_FEATURE check endstops if flagged
+ */
+void HAL::Tick() {
+
+  static millis_s cycle_1s_ms   = millis(),
+                  cycle_100_ms  = millis();
+
+  if (printer.isStopped()) return;
+
+  // The main loop resets the watchdog, here it is only checked
+  watchdog.check();
+
+  // Heaters set output PWM
+  #if HAS_HOTENDS
+    LOOP_HOTEND() hotends[h].set_output_pwm();
+  #endif
+  #if HAS_BEDS
+    LOOP_BED() beds[h].set_output_pwm();
+  #endif
+  #if HAS_CHAMBERS
+    LOOP_CHAMBER() chambers[h].set_output_pwm();
+  #endif
+  #if HAS_COOLERS
+    LOOP_COOLER() coolers[h].set_output_pwm();
+  #endif
+
+  // Fans set output PWM
+  #if HAS_FANS
+    LOOP_FAN() {
+      if (fans[f].kickstart) fans[f].kickstart--;
+      fans[f].set_output_pwm();
+    }
+  #endif
+
+  // Software PWM modulation
+  softpwm.spin();
+
+  // Event 100 ms, the heaters control runs from idle()
+  if (expired(&cycle_100_ms, 100U)) thermalManager.request_spin();
+
+  // Event 1.0 Second
+  if (expired(&cycle_1s_ms, 1000U)) printer.check_periodical_actions();
+
+  // Read the simulated analog values
+  #if HAS_HOTENDS
+    LOOP_HOTEND() {
+      const pin_t pin = hotends[h].data.sensor.pin;
+      if (WITHIN(pin, 0, NUM_ANALOG_INPUTS - 1)) {
+        ADCAveragingFilter& currentFilter = sensorFilters[h];
+        currentFilter.ProcessReading(AnalogInputSim[pin]);
+        if (currentFilter.IsValid()) {
+          AnalogInputValues[pin] = (currentFilter.GetSum() / NUM_ADC_SAMPLES) << OVERSAMPLENR;
+          Analog_is_ready = true;
+        }
+      }
+    }
+  #endif
+  #if HAS_BEDS
+    LOOP_BED() {
+      const pin_t pin = beds[h].data.sensor.pin;
+      if (WITHIN(pin, 0, NUM_ANALOG_INPUTS - 1)) {
+        ADCAveragingFilter& currentFilter = BEDsensorFilters[h];
+        currentFilter.ProcessReading(AnalogInputSim[pin]);
+        if (currentFilter.IsValid()) {
+          AnalogInputValues[pin] = (currentFilter.GetSum() / NUM_ADC_SAMPLES) << OVERSAMPLENR;
+          Analog_is_ready = true;
+        }
+      }
+    }
+  #endif
+  #if HAS_CHAMBERS
+    LOOP_CHAMBER() {
+      const pin_t pin = chambers[h].data.sensor.pin;
+      if (WITHIN(pin, 0, NUM_ANALOG_INPUTS - 1)) {
+        ADCAveragingFilter& currentFilter = CHAMBERsensorFilters[h];
+        currentFilter.ProcessReading(AnalogInputSim[pin]);
+        if (currentFilter.IsValid()) {
+          AnalogInputValues[pin] = (currentFilter.GetSum() / NUM_ADC_SAMPLES) << OVERSAMPLENR;
+          Analog_is_ready = true;
+        }
+      }
+    }
+  #endif
+  #if HAS_COOLERS
+    LOOP_COOLER() {
+      const pin_t pin = coolers[h].data.sensor.pin;
+      if (WITHIN(pin, 0, NUM_ANALOG_INPUTS - 1)) {
+        ADCAveragingFilter& currentFilter = COOLERsensorFilters[h];
+        currentFilter.ProcessReading(AnalogInputSim[pin]);
+        if (currentFilter.IsValid()) {
+          AnalogInputValues[pin] = (currentFilter.GetSum() / NUM_ADC_SAMPLES) << OVERSAMPLENR;
+          Analog_is_ready = true;
+        }
+      }
+    }
+  #endif
+
+  // Tick endstops state, if required
+  endstops.Tick();
+
+}
+
+/**
+ * Interrupt Service Routines
+ */
+HAL_TICK_TIMER_ISR() {
+  HAL_timer_isr_prologue(TICK_TIMER_NUM);
+  HAL::Tick();
+}
+
+HAL_TONE_TIMER_ISR() {
+  static uint8_t pin_state = 0;
+  HAL_timer_isr_prologue(TONE_TIMER_NUM);
+
+  if (toggles) {
+    toggles--;
+    HAL::digitalWrite(tone_pin, (pin_state ^= 1));
+  }
+  else noTone(tone_pin);
+}
+
+HAL_STEPPER_TIMER_ISR() {
+  HAL_timer_isr_prologue(STEPPER_TIMER_NUM);
+  // Call the Step
+  stepper.Step();
+}
+
+#endif // __PLAT_LINUX__
@@ -0,0 +1,281 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * This is the main Hardware Abstraction Layer (HAL).
+ * To make the firmware work with different processors and toolchains,
+ * all hardware related code should be packed into the hal files.
+ *
+ * Description: HAL for the Linux host process
+ *
+ * The firmware runs as a normal process: pins are RAM, time is a virtual
+ * clock that can run faster than real time, the timers are POSIX signals
+ * and the serial port is stdin/stdout or a pseudo terminal.
+ * It lets planner, stepper and G-code changes be replayed and measured
+ * on a workstation before they reach a board.
+ *
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * __PLAT_LINUX__
+ */
+#pragma once
+
+// --------------------------------------------------------------------------
+// Includes
+// --------------------------------------------------------------------------
+#include <stdint.h>
+#include "arduino.h"
+
+// --------------------------------------------------------------------------
+// Types
+// --------------------------------------------------------------------------
+typedef uint32_t  hal_timer_t;
+typedef uintptr_t ptr_int_t;
+
+// --------------------------------------------------------------------------
+// Includes
+// --------------------------------------------------------------------------
+#include "fastio.h"
+#include "math.h"
+#include "delay.h"
+#include "watchdog.h"
+#include "HAL_timers.h"
+
+// --------------------------------------------------------------------------
+// Defines
+// --------------------------------------------------------------------------
+
+// SERIAL ports
+#include "HardwareSerial.h"
+
+#if !WITHIN(SERIAL_PORT_1, 0, 3)
+  #error "SERIAL_PORT_1 must be from 0 to 3"
+#endif
+#define MKSERIAL1 MKSerial1
+
+#if ENABLED(SERIAL_PORT_2) && SERIAL_PORT_2 >= -1
+  #if !WITHIN(SERIAL_PORT_2, 0, 3)
+    #error "SERIAL_PORT_2 must be from 0 to 3"
+  #elif SERIAL_PORT_2 == SERIAL_PORT_1
+    #error "SERIAL_PORT_2 must be different than SERIAL_PORT_1"
+  #else
+    #define MKSERIAL2 MKSerial2
+    #define NUM_SERIAL 2
+  #endif
+#else
+  #define NUM_SERIAL 1
+#endif
+
+// CRITICAL SECTION
+#define CRITICAL_SECTION_START  const bool isr_state = HAL_isr_enabled; HAL_isr_enabled = false;
+#define CRITICAL_SECTION_END    if (isr_state) HAL_enable_isrs();
+
+// ISR function
+#define ISRS_ENABLED()          (HAL_isr_enabled)
+#define ENABLE_ISRS()           HAL_enable_isrs()
+#define DISABLE_ISRS()          (HAL_isr_enabled = false)
+
+// Voltage
+#define HAL_VOLTAGE_PIN 3.3
+
+// reset reason
+#define RST_POWER_ON   1
+#define RST_EXTERNAL   2
+#define RST_BROWN_OUT  4
+#define RST_WATCHDOG   8
+#define RST_JTAG      16
+#define RST_SOFTWARE  32
+#define RST_BACKUP    64
+
+#define SPR0    0
+#define SPR1    1
+
+#define PACK    __attribute__ ((packed))
+
+// Macros for stepper.cpp
+#define HAL_MULTI_ACC(A,B)  MultiU32X24toH32(A,B)
+
+#define HAL_TIMER_TYPE_MAX  0xFFFFFFFF
+
+// TEMPERATURE
+#define analogInputToDigitalPin(p) ((p < 16) ? (p) + 54 : -1)
+#define NUM_ANALOG_INPUTS       16
+// Bits of the simulated ADC converter
+#define ANALOG_INPUT_BITS 12
+#define OVERSAMPLENR       2
+#define AD_RANGE       16384
+#define ABS_ZERO        -273.15f
+#define NUM_ADC_SAMPLES   32
+#define AD595_MAX        330.0f
+#define AD8495_MAX       660.0f
+
+#define HARDWARE_PWM true
+
+#define GET_PIN_MAP_PIN(index) index
+#define GET_PIN_MAP_INDEX(pin) pin
+#define PARSED_PIN_INDEX(code, dval) parser.intval(code, dval)
+
+// --------------------------------------------------------------------------
+// Public Variables
+// --------------------------------------------------------------------------
+
+// reset reason
+extern uint8_t MCUSR;
+
+// Virtual time runs HAL_time_scale times faster than the real time
+extern double HAL_time_scale;
+
+extern "C" int freeMemory(void);
+
+char *dtostrf(double __val, signed char __width, unsigned char __prec, char *__s);
+
+typedef AveragingFilter<NUM_ADC_SAMPLES> ADCAveragingFilter;
+
+class HAL {
+
+  public: /** Constructor */
+
+    HAL();
+
+    virtual ~HAL();
+
+  public: /** Public Parameters */
+
+    static int16_t AnalogInputValues[NUM_ANALOG_INPUTS];
+    static bool Analog_is_ready;
+
+    // Simulated raw ADC readings (12 bit), set by the host side
+    static uint16_t AnalogInputSim[NUM_ANALOG_INPUTS];
+
+  private: /** Private Parameters */
+
+    #if HAS_HOTENDS
+      static ADCAveragingFilter sensorFilters[HOTENDS];
+    #endif
+    #if HAS_BEDS
+      static ADCAveragingFilter BEDsensorFilters[BEDS];
+    #endif
+    #if HAS_CHAMBERS
+      static ADCAveragingFilter CHAMBERsensorFilters[CHAMBERS];
+    #endif
+    #if HAS_COOLERS
+      static ADCAveragingFilter COOLERsensorFilters[COOLERS];
+    #endif
+
+  public: /** Public Function */
+
+    static void analogStart();
+    static void AdcChangePin(const pin_t old_pin, const pin_t new_pin);
+
+    static void hwSetup(void);
+
+    static bool pwm_status(const pin_t pin);
+    static bool tc_status(const pin_t pin);
+
+    static void analogWrite(const pin_t pin, uint32_t ulValue, const uint16_t freq=1000U, const bool hwpwm=true);
+
+    static void Tick();
+
+    FORCE_INLINE static void pinMode(const pin_t pin, const uint8_t mode) {
+      switch (mode) {
+        case INPUT:         SET_INPUT(pin);         break;
+        case OUTPUT:        SET_OUTPUT(pin);        break;
+        case INPUT_PULLUP:  SET_INPUT_PULLUP(pin);  break;
+        case OUTPUT_LOW:    SET_OUTPUT(pin);        break;
+        case OUTPUT_HIGH:   SET_OUTPUT_HIGH(pin);   break;
+        default:                                    break;
+      }
+    }
+    FORCE_INLINE static void digitalWrite(const pin_t pin, const bool value) {
+      WRITE(pin, value);
+    }
+    FORCE_INLINE static bool digitalRead(const pin_t pin) {
+      return READ(pin);
+    }
+    FORCE_INLINE static void setInputPullup(const pin_t pin, const bool onoff) {
+      if (VALID_PIN(pin) && fastio[pin].mode != OUTPUT) {
+        fastio[pin].mode = onoff ? INPUT_PULLUP : INPUT;
+        if (onoff) fastio[pin].value = true;
+      }
+    }
+
+    FORCE_INLINE static void delayNanoseconds(const uint32_t delayNs) {
+      HAL_delay_ns(delayNs);
+    }
+    FORCE_INLINE static void delayMicroseconds(const uint32_t delayUs) {
+      HAL_delay_ns(delayUs * 1000UL);
+    }
+    FORCE_INLINE static void delayMilliseconds(const uint16_t delayMs) {
+      delay(delayMs);
+    }
+    FORCE_INLINE static uint32_t timeInMilliseconds() {
+      return millis();
+    }
+
+    static void showStartReason();
+
+    static void resetHardware();
+
+    // SPI related functions, there is no SPI bus on the host
+    static uint8_t spiTransfer(uint8_t nbyte);
+    static void spiBegin();
+    static void spiInit(uint8_t spiRate);
+    static uint8_t spiReceive();
+    static void spiReadBlock(uint8_t* buf, uint16_t nbyte);
+    static void spiSend(uint8_t nbyte);
+    static void spiSend(const uint8_t* buf , size_t nbyte);
+    static void spiSendBlock(uint8_t token, const uint8_t* buf);
+
+};
+
+/**
+ * Public functions
+ */
+
+// Disable interrupts
+void cli(void);
+
+// Enable interrupts
+void sei(void);
+
+// Tone
+void tone(const pin_t _pin, const uint16_t frequency, const uint16_t duration=0);
+void noTone(const pin_t _pin);
+
+// EEPROM
+uint8_t eeprom_read_byte(uint8_t* pos);
+void eeprom_read_block(void* pos, const void* eeprom_address, size_t n);
+void eeprom_write_byte(uint8_t* pos, uint8_t value);
+void eeprom_update_block(const void* pos, void* eeprom_address, size_t n);
+
+// Host side
+void HAL_LINUX_set_pin(const pin_t pin, const bool value);
+void HAL_LINUX_set_analog(const pin_t pin, const uint16_t value);
+void HAL_LINUX_report();
+#if ENABLED(PLANNER_BENCHMARK)
+  void HAL_LINUX_bench_idle();
+#endif
+
+// File of the EEPROM image, eeprom.bin in the working folder by default
+extern const char *HAL_eeprom_file;
+
+// Set by SIGINT and SIGTERM, the process exits from the main loop
+extern volatile sig_atomic_t HAL_exit_requested;
@@ -0,0 +1,233 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Description: HAL timers for the Linux host
+ *
+ * __PLAT_LINUX__
+ */
+
+#ifdef __PLAT_LINUX__
+
+// --------------------------------------------------------------------------
+// Includes
+// --------------------------------------------------------------------------
+#include "../../../MK4duo.h"
+#include <time.h>
+
+// --------------------------------------------------------------------------
+// Externals
+// --------------------------------------------------------------------------
+extern HAL_STEPPER_TIMER_ISR();
+extern HAL_TICK_TIMER_ISR();
+extern HAL_TONE_TIMER_ISR();
+
+// --------------------------------------------------------------------------
+// Public Variables
+// --------------------------------------------------------------------------
+
+const tTimerConfig TimerConfig [NUM_HARDWARE_TIMERS] = {
+  { SIGRTMIN + 0, HAL_stepper_timer_isr,  0 },  // 0 - Stepper
+  { SIGRTMIN + 1, HAL_tick_timer_isr,     1 },  // 1 - Tick 1 kHz (SysTick)
+  { SIGRTMIN + 2, HAL_tone_timer_isr,     2 },  // 2 - Tone
+};
+
+tTimerState TimerState[NUM_HARDWARE_TIMERS];
+tTimerStats TimerStats[NUM_HARDWARE_TIMERS];
+
+uint32_t  HAL_min_pulse_cycle     = 0,
+          HAL_min_pulse_tick      = 0,
+          HAL_add_pulse_ticks     = 0,
+          HAL_frequency_limit[8]  = { 0 };
+
+volatile sig_atomic_t HAL_isr_enabled = true;
+
+// Virtual time runs HAL_time_scale times faster than the real time
+double HAL_time_scale = 1.0;
+
+// --------------------------------------------------------------------------
+// Private Variables
+// --------------------------------------------------------------------------
+static uint64_t real_start_ns = 0;
+static timer_t  posix_timer[NUM_HARDWARE_TIMERS];
+static uint64_t match_real_ns[NUM_HARDWARE_TIMERS] = { 0 };
+
+// --------------------------------------------------------------------------
+// Private functions
+// --------------------------------------------------------------------------
+
+FORCE_INLINE static uint64_t virtual_to_real(const uint64_t v_ns) {
+  return real_start_ns + uint64_t(double(v_ns) / HAL_time_scale);
+}
+
+FORCE_INLINE static uint64_t ticks_to_ns(const uint32_t ticks) {
+  return (uint64_t(ticks) * 1000UL) / (HAL_TIMER_RATE / 1000000UL);
+}
+
+FORCE_INLINE static uint64_t timer_deadline(const uint8_t timer_num) {
+  return TimerState[timer_num].base_ns + ticks_to_ns(TimerState[timer_num].compare);
+}
+
+static void run_isr(const uint8_t timer_num) {
+  tTimerStats &stats = TimerStats[timer_num];
+  const uint64_t start = HAL_real_ns();
+  const uint64_t latency = start > match_real_ns[timer_num] ? start - match_real_ns[timer_num] : 0;
+
+  TimerConfig[timer_num].handler();
+
+  const uint32_t elapsed = uint32_t(HAL_real_ns() - start);
+
+  // The next match is already gone: the ISR used all the interval
+  if (TimerState[timer_num].enabled && HAL_clock_ns() >= timer_deadline(timer_num)) stats.overruns++;
+
+  stats.count++;
+  stats.total_ns += elapsed;
+  NOLESS(stats.max_ns, elapsed);
+  NOLESS(stats.max_latency_ns, uint32_t(MIN(latency, uint64_t(UINT32_MAX))));
+}
+
+/**
+ * Signal handler of all the timers.
+ * The compare is checked again because the ISR or the main loop
+ * may have moved it after the kernel timer was armed.
+ */
+static void timer_signal_handler(int sig) {
+  uint8_t t = 0;
+  while (t < NUM_HARDWARE_TIMERS && TimerConfig[t].signal != sig) t++;
+  if (t == NUM_HARDWARE_TIMERS) return;
+
+  tTimerState &state = TimerState[t];
+  if (!state.enabled) return;
+
+  if (!state.pending) {
+    const uint64_t deadline = timer_deadline(t);
+    if (HAL_clock_ns() < deadline) {
+      HAL_timer_arm(t);
+      return;
+    }
+    state.base_ns = deadline;   // The counter restarts from zero on the match
+    state.pending = true;
+    match_real_ns[t] = virtual_to_real(deadline);
+  }
+
+  if (HAL_isr_enabled) {
+    run_isr(t);
+    HAL_timer_arm(t);
+  }
+}
+
+// --------------------------------------------------------------------------
+// Public functions
+// --------------------------------------------------------------------------
+
+uint64_t HAL_real_ns() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return uint64_t(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+uint64_t HAL_clock_ns() {
+  return uint64_t(double(HAL_real_ns() - real_start_ns) * HAL_time_scale);
+}
+
+void HAL_timer_init() {
+
+  real_start_ns = HAL_real_ns();
+
+  // A timer masks itself and all the timers with lower priority
+  for (uint8_t t = 0; t < NUM_HARDWARE_TIMERS; t++) {
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = timer_signal_handler;
+    sa.sa_flags   = SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    for (uint8_t o = 0; o < NUM_HARDWARE_TIMERS; o++)
+      if (TimerConfig[o].priority >= TimerConfig[t].priority)
+        sigaddset(&sa.sa_mask, TimerConfig[o].signal);
+    sigaction(TimerConfig[t].signal, &sa, NULL);
+
+    struct sigevent sev;
+    memset(&sev, 0, sizeof(sev));
+    sev.sigev_notify = SIGEV_SIGNAL;
+    sev.sigev_signo  = TimerConfig[t].signal;
+    timer_create(CLOCK_MONOTONIC, &sev, &posix_timer[t]);
+  }
+
+}
+
+/**
+ * Program the kernel timer on the real time of the next compare match.
+ * A match already gone fires at once, like a compare written below the counter.
+ */
+void HAL_timer_arm(const uint8_t timer_num) {
+  if (!TimerState[timer_num].enabled || TimerState[timer_num].pending) return;
+  #if ENABLED(PLANNER_BENCHMARK)
+    if (timer_num == STEPPER_TIMER_NUM) return;   // idle() executes the blocks, see HAL_LINUX_bench_idle()
+  #endif
+  const uint64_t real = virtual_to_real(timer_deadline(timer_num));
+  struct itimerspec its;
+  memset(&its, 0, sizeof(its));
+  its.it_value.tv_sec  = real / 1000000000ULL;
+  its.it_value.tv_nsec = real % 1000000000ULL;
+  if (!its.it_value.tv_sec && !its.it_value.tv_nsec) its.it_value.tv_nsec = 1;
+  timer_settime(posix_timer[timer_num], TIMER_ABSTIME, &its, NULL);
+}
+
+void HAL_timer_start(const uint8_t timer_num, const uint32_t frequency) {
+  tTimerState &state = TimerState[timer_num];
+  state.enabled = false;
+  state.pending = false;
+  state.compare = HAL_TIMER_RATE / frequency;
+  state.base_ns = HAL_clock_ns();
+  state.enabled = true;
+  HAL_timer_arm(timer_num);
+}
+
+// Run the timers matched while ISRs were disabled
+void HAL_enable_isrs() {
+  HAL_isr_enabled = true;
+  for (uint8_t t = 0; t < NUM_HARDWARE_TIMERS; t++)
+    if (TimerState[t].pending && TimerState[t].enabled)
+      raise(TimerConfig[t].signal);
+}
+
+uint32_t HAL_isr_execuiton_cycle(const uint32_t rate) {
+  return (ISR_BASE_CYCLES + ISR_BEZIER_CYCLES + (ISR_LOOP_CYCLES) * rate + ISR_LA_BASE_CYCLES + ISR_LA_LOOP_CYCLES) / rate;
+}
+
+void HAL_calc_pulse_cycle() {
+  HAL_min_pulse_cycle = MAX((uint32_t)((F_CPU) / stepper.data.maximum_rate), ((F_CPU) / 500000UL) * MAX((uint32_t)stepper.data.minimum_pulse, 1UL));
+  HAL_min_pulse_tick  = uint32_t(stepper.data.minimum_pulse) * (STEPPER_TIMER_TICKS_PER_US);
+  HAL_add_pulse_ticks = (HAL_min_pulse_cycle / (PULSE_TIMER_PRESCALE)) - HAL_min_pulse_tick;
+
+  // The stepping frequency limits for each multistepping rate
+  HAL_frequency_limit[0] = ((F_CPU) / HAL_isr_execuiton_cycle(1))       ;
+  HAL_frequency_limit[1] = ((F_CPU) / HAL_isr_execuiton_cycle(2))   >> 1;
+  HAL_frequency_limit[2] = ((F_CPU) / HAL_isr_execuiton_cycle(4))   >> 2;
+  HAL_frequency_limit[3] = ((F_CPU) / HAL_isr_execuiton_cycle(8))   >> 3;
+  HAL_frequency_limit[4] = ((F_CPU) / HAL_isr_execuiton_cycle(16))  >> 4;
+  HAL_frequency_limit[5] = ((F_CPU) / HAL_isr_execuiton_cycle(32))  >> 5;
+  HAL_frequency_limit[6] = ((F_CPU) / HAL_isr_execuiton_cycle(64))  >> 6;
+  HAL_frequency_limit[7] = ((F_CPU) / HAL_isr_execuiton_cycle(128)) >> 7;
+}
+
+#endif // __PLAT_LINUX__
@@ -0,0 +1,252 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Description: HAL timers for the Linux host
+ *
+ * Timers count on the virtual clock (see HAL.cpp). Every timer is a POSIX
+ * timer armed on the real time of its next compare match, its signal
+ * preempts Printer::loop() exactly like an IRQ.
+ * ENABLE_ISRS() / DISABLE_ISRS() only flip a flag: a timer that matches
+ * while ISRs are disabled stays pending and runs on the next ENABLE_ISRS().
+ *
+ * __PLAT_LINUX__
+ */
+#pragma once
+
+// --------------------------------------------------------------------------
+// Includes
+// --------------------------------------------------------------------------
+#include <stdint.h>
+#include <signal.h>
+
+// --------------------------------------------------------------------------
+// Defines
+// --------------------------------------------------------------------------
+#define NUM_HARDWARE_TIMERS 3
+
+#define HAL_TIMER_RATE              ((F_CPU) / 4) // 25 MHz
+
+#define STEPPER_TIMER_NUM           0
+#define STEPPER_TIMER_RATE          HAL_TIMER_RATE
+#define STEPPER_TIMER_TICKS_PER_US  ((STEPPER_TIMER_RATE) / 1000000)                          // 25 - stepper timer ticks per µs
+#define STEPPER_TIMER_PRESCALE      ((F_CPU / 1000000UL) / STEPPER_TIMER_TICKS_PER_US)        // 4
+#define STEPPER_TIMER_MIN_INTERVAL  1                                                         // minimum time in µs between stepper interrupts
+#define STEPPER_TIMER_MAX_INTERVAL  (STEPPER_TIMER_TICKS_PER_US * STEPPER_TIMER_MIN_INTERVAL) // maximum time in µs between stepper interrupts
+#define PULSE_TIMER_PRESCALE        STEPPER_TIMER_PRESCALE
+#define HAL_STEPPER_TIMER_ISR()     void HAL_stepper_timer_isr()
+
+// Replaces the SysTick of the Arduino cores
+#define TICK_TIMER_NUM              1
+#define HAL_TICK_TIMER_ISR()        void HAL_tick_timer_isr()
+
+// Tone
+#define TONE_TIMER_NUM              2
+#define HAL_TONE_TIMER_ISR()        void HAL_tone_timer_isr()
+
+#define ENABLE_STEPPER_INTERRUPT()  HAL_timer_enable_interrupt(STEPPER_TIMER_NUM)
+#define DISABLE_STEPPER_INTERRUPT() HAL_timer_disable_interrupt(STEPPER_TIMER_NUM)
+#define STEPPER_ISR_ENABLED()       HAL_timer_interrupt_is_enabled(STEPPER_TIMER_NUM)
+
+// Estimate the amount of time the ISR will take to execute
+// Same budget of the Due, so the multistepping thresholds match a 32 bit board
+#define ISR_BASE_CYCLES               752UL
+
+// Linear advance base time is 64 cycles
+#if ENABLED(LIN_ADVANCE)
+  #define ISR_LA_BASE_CYCLES          64UL
+#else
+  #define ISR_LA_BASE_CYCLES          0UL
+#endif
+
+// Bezier interpolation adds 40 cycles
+#if ENABLED(BEZIER_JERK_CONTROL)
+  #define ISR_BEZIER_CYCLES           40UL
+#else
+  #define ISR_BEZIER_CYCLES           0UL
+#endif
+
+// Stepper Loop base cycles
+#define ISR_LOOP_BASE_CYCLES          4UL
+
+// To start the step pulse, in the worst case takes
+#define ISR_START_STEPPER_CYCLES      13UL
+
+// And each stepper (start + stop pulse) takes in worst case
+#define ISR_STEPPER_CYCLES            16UL
+
+// For each stepper, we add its time
+#if HAS_X_STEP
+  #define ISR_START_X_STEPPER_CYCLES  ISR_START_STEPPER_CYCLES
+  #define ISR_X_STEPPER_CYCLES        ISR_STEPPER_CYCLES
+#else
+  #define ISR_START_X_STEPPER_CYCLES  0UL
+  #define ISR_X_STEPPER_CYCLES        0UL
+#endif
+#if HAS_Y_STEP
+  #define ISR_START_Y_STEPPER_CYCLES  ISR_START_STEPPER_CYCLES
+  #define ISR_Y_STEPPER_CYCLES        ISR_STEPPER_CYCLES
+#else
+  #define ISR_START_Y_STEPPER_CYCLES  0UL
+  #define ISR_Y_STEPPER_CYCLES        0UL
+#endif
+#if HAS_Z_STEP
+  #define ISR_START_Z_STEPPER_CYCLES  ISR_START_STEPPER_CYCLES
+  #define ISR_Z_STEPPER_CYCLES        ISR_STEPPER_CYCLES
+#else
+  #define ISR_START_Z_STEPPER_CYCLES  0UL
+  #define ISR_Z_STEPPER_CYCLES        0UL
+#endif
+
+// E is always interpolated
+#define ISR_START_E_STEPPER_CYCLES    ISR_START_STEPPER_CYCLES
+#define ISR_E_STEPPER_CYCLES          ISR_STEPPER_CYCLES
+
+// If linear advance is disabled, then the loop also handles them
+#if DISABLED(LIN_ADVANCE) && ENABLED(COLOR_MIXING_EXTRUDER)
+  #define ISR_START_MIXING_STEPPER_CYCLES ((MIXING_STEPPERS) * 13UL)
+  #define ISR_MIXING_STEPPER_CYCLES       ((MIXING_STEPPERS) * 16UL)
+#else
+  #define ISR_START_MIXING_STEPPER_CYCLES 0UL
+  #define ISR_MIXING_STEPPER_CYCLES       0UL
+#endif
+
+// Calculate the minimum time to start all stepper pulses in the ISR loop
+#define MIN_ISR_START_LOOP_CYCLES     (ISR_START_X_STEPPER_CYCLES + ISR_START_Y_STEPPER_CYCLES + ISR_START_Z_STEPPER_CYCLES + ISR_START_E_STEPPER_CYCLES + ISR_START_MIXING_STEPPER_CYCLES)
+
+// And the total minimum loop time is, without including the base
+#define MIN_ISR_LOOP_CYCLES           (ISR_X_STEPPER_CYCLES + ISR_Y_STEPPER_CYCLES + ISR_Z_STEPPER_CYCLES + ISR_E_STEPPER_CYCLES + ISR_MIXING_STEPPER_CYCLES)
+
+// But the user could be enforcing a minimum time, so the loop time is
+#define ISR_LOOP_CYCLES               (ISR_LOOP_BASE_CYCLES + MAX(HAL_min_pulse_cycle, MIN_ISR_LOOP_CYCLES))
+
+// If linear advance is enabled, then it is handled separately
+#if ENABLED(LIN_ADVANCE)
+
+  // Estimate the minimum LA loop time
+  #if ENABLED(COLOR_MIXING_EXTRUDER)
+    #define MIN_ISR_LA_LOOP_CYCLES  ((MIXING_STEPPERS) * 16UL)
+  #else
+    #define MIN_ISR_LA_LOOP_CYCLES  16UL
+  #endif
+
+  // And the real loop time
+  #define ISR_LA_LOOP_CYCLES  MAX(HAL_min_pulse_cycle, MIN_ISR_LA_LOOP_CYCLES)
+
+#else
+  #define ISR_LA_LOOP_CYCLES  0UL
+#endif
+
+// The step timeline ISR only outputs a step event made ahead, see Stepper::timeline_step().
+// Estimate its base time without the Bresenham tracer and the trapezoid generator
+#define ISR_TIMELINE_BASE_CYCLES      240UL
+
+// So the step events can't be closer than
+#define ISR_TIMELINE_CYCLES           (ISR_TIMELINE_BASE_CYCLES + ISR_LOOP_CYCLES)
+
+// --------------------------------------------------------------------------
+// Types
+// --------------------------------------------------------------------------
+
+typedef void (*pfnISR_Handler)(void);
+
+typedef struct {
+  int             signal;       // Signal raised on the main thread
+  pfnISR_Handler  handler;
+  uint8_t         priority;     // Timers with lower value preempt the others
+} tTimerConfig;
+
+typedef struct {
+  volatile uint64_t base_ns;    // Virtual time of the last compare match (counter = 0)
+  volatile uint32_t compare;    // Compare register, in timer ticks
+  volatile bool     enabled,
+                    pending;
+} tTimerState;
+
+typedef struct {
+  uint32_t  count,              // Number of ISRs
+            overruns,           // ISRs ended after the next compare match
+            max_ns,             // Worst case real time spent in the ISR
+            max_latency_ns;     // Worst case real delay from the match to the ISR
+  uint64_t  total_ns;           // Total real time spent in the ISR
+} tTimerStats;
+
+// --------------------------------------------------------------------------
+// Public Variables
+// --------------------------------------------------------------------------
+
+extern const tTimerConfig TimerConfig[];
+extern tTimerState        TimerState[];
+extern tTimerStats        TimerStats[];
+
+extern uint32_t HAL_min_pulse_cycle,
+                HAL_min_pulse_tick,
+                HAL_add_pulse_ticks,
+                HAL_frequency_limit[8];
+
+extern volatile sig_atomic_t HAL_isr_enabled;
+
+// --------------------------------------------------------------------------
+// Public functions
+// --------------------------------------------------------------------------
+
+uint64_t HAL_clock_ns();   // Virtual time
+uint64_t HAL_real_ns();    // Real monotonic time
+
+void HAL_timer_init();
+void HAL_timer_start(const uint8_t timer_num, const uint32_t frequency);
+void HAL_timer_arm(const uint8_t timer_num);
+
+void HAL_calc_pulse_cycle();
+
+void HAL_enable_isrs();
+
+FORCE_INLINE static void HAL_timer_enable_interrupt(const uint8_t timer_num) {
+  TimerState[timer_num].enabled = true;
+  HAL_timer_arm(timer_num);
+}
+
+FORCE_INLINE static void HAL_timer_disable_interrupt(const uint8_t timer_num) {
+  TimerState[timer_num].enabled = false;
+  TimerState[timer_num].pending = false;
+}
+
+FORCE_INLINE static bool HAL_timer_interrupt_is_enabled(const uint8_t timer_num) {
+  return TimerState[timer_num].enabled;
+}
+
+FORCE_INLINE static uint32_t HAL_timer_get_count(const uint8_t timer_num) {
+  return TimerState[timer_num].compare;
+}
+
+FORCE_INLINE static void HAL_timer_set_count(const uint8_t timer_num, const uint32_t count) {
+  TimerState[timer_num].compare = count;
+  HAL_timer_arm(timer_num);
+}
+
+FORCE_INLINE static uint32_t HAL_timer_get_current_count(const uint8_t timer_num) {
+  return uint32_t(((HAL_clock_ns() - TimerState[timer_num].base_ns) * (HAL_TIMER_RATE / 1000000UL)) / 1000UL);
+}
+
+FORCE_INLINE static void HAL_timer_isr_prologue(const uint8_t timer_num) {
+  TimerState[timer_num].pending = false;
+}
@@ -0,0 +1,335 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "../../../MK4duo.h"
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+
+typedef struct {
+  int   in, out;
+  bool  eof;
+} serial_fd_t;
+
+static serial_fd_t serial_fd[NUM_SERIAL_FD] = {
+  { -1, -1, false }, { -1, -1, false }, { -1, -1, false }, { -1, -1, false }
+};
+
+void HAL_serial_open(const uint8_t port, const int fd_in, const int fd_out) {
+  if (port >= NUM_SERIAL_FD) return;
+  serial_fd[port].in  = fd_in;
+  serial_fd[port].out = fd_out;
+  serial_fd[port].eof = false;
+  if (fd_in >= 0) fcntl(fd_in, F_SETFL, fcntl(fd_in, F_GETFL) | O_NONBLOCK);
+}
+
+bool HAL_serial_eof(const uint8_t port) {
+  return port < NUM_SERIAL_FD && serial_fd[port].eof;
+}
+
+// Static
+template<typename Cfg> typename MKHardwareSerial<Cfg>::ring_buffer_r MKHardwareSerial<Cfg>::rx_buffer = { 0, 0, { 0 } };
+template<typename Cfg> uint8_t  MKHardwareSerial<Cfg>::rx_dropped_bytes = 0;
+template<typename Cfg> uint8_t  MKHardwareSerial<Cfg>::rx_buffer_overruns = 0;
+template<typename Cfg> uint8_t  MKHardwareSerial<Cfg>::rx_framing_errors = 0;
+template<typename Cfg> typename MKHardwareSerial<Cfg>::ring_buffer_pos_t MKHardwareSerial<Cfg>::rx_max_enqueued = 0;
+
+/** Protected Function */
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::store_rxd_char(const uint8_t c) {
+
+  static EmergencyStateEnum emergency_state; // = EP_RESET
+
+  const ring_buffer_pos_t t = rx_buffer.tail;
+  ring_buffer_pos_t h = rx_buffer.head;
+  const ring_buffer_pos_t i = (ring_buffer_pos_t)(h + 1) & (ring_buffer_pos_t)(Cfg::RX_SIZE - 1);
+
+  if (Cfg::EMERGENCYPARSER) emergency_parser.update(emergency_state, c);
+
+  if (i != t) {
+    rx_buffer.buffer[h] = c;
+    h = i;
+  }
+  else if (Cfg::DROPPED_RX && !++rx_dropped_bytes)
+    --rx_dropped_bytes;
+
+  // Keep track of the maximum count of enqueued bytes
+  if (Cfg::MAX_RX_QUEUED) NOLESS(rx_max_enqueued, (ring_buffer_pos_t)(h - t) & (ring_buffer_pos_t)(Cfg::RX_SIZE - 1));
+
+  rx_buffer.head = h;
+}
+
+/**
+ * Read only what fits in the RX buffer, so a replayed file
+ * is consumed at the speed the firmware accepts the commands.
+ */
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::receive() {
+  serial_fd_t &port = serial_fd[Cfg::PORT];
+  if (port.in < 0 || port.eof) return;
+
+  const ring_buffer_pos_t h = rx_buffer.head, t = rx_buffer.tail;
+  const size_t space = (Cfg::RX_SIZE - 1) - ((ring_buffer_pos_t)(Cfg::RX_SIZE + h - t) & (Cfg::RX_SIZE - 1));
+  if (!space) return;
+
+  uint8_t buf[Cfg::RX_SIZE];
+  const ssize_t n = ::read(port.in, buf, space);
+  if (n > 0)
+    for (ssize_t c = 0; c < n; c++) store_rxd_char(buf[c]);
+  else if (n == 0)
+    port.eof = true;
+  else if (errno != EAGAIN && errno != EINTR && errno != EIO)
+    port.eof = true;
+}
+
+/** Public Function */
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::begin(const long baud) {
+  UNUSED(baud);
+  rx_buffer.head = rx_buffer.tail = 0;
+}
+
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::end() { }
+
+template<typename Cfg>
+int MKHardwareSerial<Cfg>::peek(void) {
+  receive();
+  const int v = rx_buffer.head == rx_buffer.tail ? -1 : rx_buffer.buffer[rx_buffer.tail];
+  return v;
+}
+
+template<typename Cfg>
+int MKHardwareSerial<Cfg>::read(void) {
+
+  receive();
+
+  const ring_buffer_pos_t h = rx_buffer.head;
+  ring_buffer_pos_t t = rx_buffer.tail;
+
+  if (h == t) return -1;
+
+  const int v = rx_buffer.buffer[t];
+  t = (ring_buffer_pos_t)(t + 1) & (Cfg::RX_SIZE - 1);
+
+  // Advance tail
+  rx_buffer.tail = t;
+
+  return v;
+}
+
+template<typename Cfg>
+typename MKHardwareSerial<Cfg>::ring_buffer_pos_t MKHardwareSerial<Cfg>::available(void) {
+  receive();
+  const ring_buffer_pos_t h = rx_buffer.head, t = rx_buffer.tail;
+  if (h == t && serial_fd[Cfg::PORT].eof) HAL_LINUX_serial_eof(Cfg::PORT);
+  return (ring_buffer_pos_t)(Cfg::RX_SIZE + h - t) & (Cfg::RX_SIZE - 1);
+}
+
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::flush(void) {
+  rx_buffer.tail = rx_buffer.head;
+}
+
+static void serial_write(const int fd, const uint8_t c) {
+  if (fd < 0) return;
+  while (::write(fd, &c, 1) < 0 && (errno == EINTR || errno == EAGAIN)) { /* nada */ }
+}
+
+/**
+ * Com::setBaudrate() and Printer::setup() both greet the host with "start".
+ * A host program would see two resets, so the greeting right after the
+ * first one is held back and dropped.
+ */
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::write(const uint8_t c) {
+  static const char greeting[] = "start\r\nstart\r\n";
+  static uint8_t greeting_pos = 0;
+  constexpr uint8_t full = sizeof(greeting) - 1, half = full / 2;
+  const int fd = serial_fd[Cfg::PORT].out;
+
+  if (greeting_pos < full) {
+    if (c == greeting[greeting_pos]) {
+      if (++greeting_pos <= half) serial_write(fd, c);
+      return;
+    }
+    // Not the second greeting, send what was held back
+    for (uint8_t i = half; i < greeting_pos; i++) serial_write(fd, greeting[i]);
+    greeting_pos = full;
+  }
+
+  serial_write(fd, c);
+}
+
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::flushTX(void) { }
+
+template<typename Cfg>
+size_t MKHardwareSerial<Cfg>::readBytes(char* buffer, size_t size) {
+
+  int c;
+  size_t count = 0;
+  const millis_l timeout = millis() + 1000UL;
+
+  while (count < size) {
+
+    do {
+      c = read();
+      if (c >= 0) break;
+    } while (PENDING(millis(), timeout));
+
+    if (c < 0) break;
+    *buffer++ = (char)c;
+    count++;
+  }
+
+  return count;
+
+}
+
+/**
+ * Imports from print.h
+ */
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::print(char c, int base) {
+  print((long)c, base);
+}
+
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::print(unsigned char b, int base) {
+  print((unsigned long)b, base);
+}
+
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::print(int n, int base) {
+  print((long)n, base);
+}
+
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::print(unsigned int n, int base) {
+  print((unsigned long)n, base);
+}
+
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::print(long n, int base) {
+  if (base == 0) write(n);
+  else if (base == 10) {
+    if (n < 0) { print('-'); n = -n; }
+    printNumber(n, 10);
+  }
+  else
+    printNumber(n, base);
+}
+
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::print(unsigned long n, int base) {
+  if (base == 0) write(n);
+  else printNumber(n, base);
+}
+
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::print(double n, int digits) {
+  printFloat(n, digits);
+}
+
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::println(void) {
+  print('\r');
+  print('\n');
+}
+
+/** Private Function */
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::printNumber(unsigned long n, uint8_t base) {
+
+  if (n) {
+    unsigned char buf[8 * sizeof(long)]; // Enough space for base 2
+    int8_t i = 0;
+    while (n) {
+      buf[i++] = n % base;
+      n /= base;
+    }
+    while (i--)
+      print((char)(buf[i] + (buf[i] < 10 ? '0' : 'A' - 10)));
+  }
+  else
+    print('0');
+
+}
+
+template<typename Cfg>
+void MKHardwareSerial<Cfg>::printFloat(double number, uint8_t digits) {
+
+  // Handle negative numbers
+  if (number < 0.0) {
+    print('-');
+    number = -number;
+  }
+
+  // Round correctly so that print(1.999, 2) prints as "2.00"
+  double rounding = 0.5;
+  for (uint8_t i = 0; i < digits; ++i) rounding *= 0.1;
+  number += rounding;
+
+  // Extract the integer part of the number and print it
+  unsigned long int_part = (unsigned long)number;
+  double remainder = number - (double)int_part;
+  print(int_part);
+
+  // Print the decimal point, but only if there are digits beyond
+  if (digits) {
+    print('.');
+    // Extract digits from the remainder one at a time
+    while (digits--) {
+      remainder *= 10.0;
+      int toPrint = int(remainder);
+      print(toPrint);
+      remainder -= toPrint;
+    }
+  }
+
+}
+
+// Instantiate Class
+#if SERIAL_PORT_1 >= 0
+  template class MKHardwareSerial<MK4duoSerialHostCfg<SERIAL_PORT_1>>;
+  MKHardwareSerial<MK4duoSerialHostCfg<SERIAL_PORT_1>> MKSerial1;
+#endif
+
+#if SERIAL_PORT_2 >= 0
+  template class MKHardwareSerial<MK4duoSerialHostCfg<SERIAL_PORT_2>>;
+  MKHardwareSerial<MK4duoSerialHostCfg<SERIAL_PORT_2>> MKSerial2;
+#endif
+
+#if ENABLED(NEXTION) && NEXTION_SERIAL > 0
+  template class MKHardwareSerial<MK4duoSerialCfg<NEXTION_SERIAL>>;
+  MKHardwareSerial<MK4duoSerialCfg<NEXTION_SERIAL>> nexSerial;
+#endif
+
+#if HAS_MMU2 && MMU2_SERIAL > 0
+  template class MKHardwareSerial<MK4duoSerialCfg<MMU2_SERIAL>>;
+  MKHardwareSerial<MK4duoSerialCfg<MMU2_SERIAL>> mmuSerial;
+#endif
+
+#endif // __PLAT_LINUX__
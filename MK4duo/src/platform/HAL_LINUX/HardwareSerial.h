@@ -0,0 +1,127 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * Serial ports of the Linux host
+ *
+ * Every port is a pair of file descriptors attached by HAL_serial_open():
+ * stdin/stdout, a file being replayed or a pseudo terminal for a host program.
+ * Reception is polled from available() / read() on the main thread.
+ */
+
+template<typename Cfg>
+class MKHardwareSerial {
+
+  public: /** Constructor */
+
+    MKHardwareSerial() {}
+
+  protected: /** Protected Parameters */
+
+    // Base size of type on buffer size
+    typedef typename TypeSelector<(Cfg::RX_SIZE>256), uint16_t, uint8_t>::type ring_buffer_pos_t;
+
+    struct ring_buffer_r {
+      volatile ring_buffer_pos_t head, tail;
+      unsigned char buffer[Cfg::RX_SIZE];
+    };
+
+    static ring_buffer_r rx_buffer;
+
+    static uint8_t  rx_dropped_bytes,
+                    rx_buffer_overruns,
+                    rx_framing_errors;
+
+    static ring_buffer_pos_t rx_max_enqueued;
+
+  protected: /** Protected Function */
+
+    static void store_rxd_char(const uint8_t c);
+    static void receive();
+
+  public: /** Public Function */
+
+    static void begin(const long);
+    static void end();
+    static int peek(void);
+    static int read(void);
+    static void flush(void);
+    static ring_buffer_pos_t available(void);
+    static void write(const uint8_t c);
+    static void flushTX(void);
+    static size_t readBytes(char* buffer, size_t size);
+
+    FORCE_INLINE static uint8_t dropped() { return Cfg::DROPPED_RX ? rx_dropped_bytes : 0; }
+    FORCE_INLINE static uint8_t buffer_overruns() { return Cfg::RX_OVERRUNS ? rx_buffer_overruns : 0; }
+    FORCE_INLINE static uint8_t framing_errors() { return Cfg::RX_FRAMING_ERRORS ? rx_framing_errors : 0; }
+    FORCE_INLINE static ring_buffer_pos_t rxMaxEnqueued() { return Cfg::MAX_RX_QUEUED ? rx_max_enqueued : 0; }
+
+    FORCE_INLINE static void write(const char* str) { while (*str) write(*str++); }
+    FORCE_INLINE static void write(const uint8_t* buffer, size_t size) { while (size--) write(*buffer++); }
+    FORCE_INLINE static void print(const char* str) { write(str); }
+
+    static void print(char, int=BYTE);
+    static void print(unsigned char, int=DEC);
+    static void print(int, int=DEC);
+    static void print(unsigned int, int=DEC);
+    static void print(long, int=DEC);
+    static void print(unsigned long, int=DEC);
+    static void print(double, int=2);
+
+    static void println(void);
+
+    operator bool() { return true; }
+
+  private: /** Private Function */
+
+    static void printNumber(unsigned long, const uint8_t);
+    static void printFloat(double, uint8_t);
+
+};
+
+#define NUM_SERIAL_FD 4
+
+// Attach a port to its file descriptors, -1 leaves the port closed
+void HAL_serial_open(const uint8_t port, const int fd_in, const int fd_out);
+
+// True when the input of the port reached the end of file
+bool HAL_serial_eof(const uint8_t port);
+
+// Input ended and all received bytes were read, see main.cpp
+void HAL_LINUX_serial_eof(const uint8_t port);
+
+#if SERIAL_PORT_1 >= 0
+  extern MKHardwareSerial<MK4duoSerialHostCfg<SERIAL_PORT_1>> MKSerial1;
+#endif
+
+#if SERIAL_PORT_2 >= 0
+  extern MKHardwareSerial<MK4duoSerialHostCfg<SERIAL_PORT_2>> MKSerial2;
+#endif
+
+#if ENABLED(NEXTION) && NEXTION_SERIAL > 0
+  extern MKHardwareSerial<MK4duoSerialCfg<NEXTION_SERIAL>> nexSerial;
+#endif
+
+#if HAS_MMU2 && MMU2_SERIAL > 0
+  extern MKHardwareSerial<MK4duoSerialCfg<MMU2_SERIAL>> mmuSerial;
+#endif
@@ -0,0 +1,131 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * Minimal Arduino core for the Linux host build.
+ * Only what MK4duo uses outside of the HAL is provided here,
+ * time functions are backed by the virtual clock of HAL_LINUX.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <strings.h>
+#include <cstdarg>
+
+#ifndef F_CPU
+  #define F_CPU 100000000UL   // Virtual 100 MHz core
+#endif
+
+// No program space memory on the host
+#define PROGMEM
+#ifndef PGM_P
+  #define PGM_P const char*
+#endif
+#undef PSTR
+#define PSTR(s) s
+#define pgm_read_byte_near(x)     (*(const uint8_t*)(x))
+#define pgm_read_byte(x)          (*(const uint8_t*)(x))
+#define pgm_read_float(addr)      (*(const float *)(addr))
+#define pgm_read_word(addr)       (*(addr))
+#define pgm_read_word_near(addr)  pgm_read_word(addr)
+#define pgm_read_dword(addr)      (*(addr))
+#define pgm_read_dword_near(addr) pgm_read_dword(addr)
+#define pgm_read_ptr(addr)        (*(addr))
+#define strcpy_P      strcpy
+#define strncpy_P     strncpy
+#define strlen_P      strlen
+#define strstr_P      strstr
+#define strchr_P      strchr
+#define strcmp_P      strcmp
+#define strncmp_P     strncmp
+#define strcasecmp_P  strcasecmp
+#define memcpy_P      memcpy
+#define sprintf_P     sprintf
+#define snprintf_P    snprintf
+#define vsnprintf_P   vsnprintf
+
+typedef uint8_t byte;
+typedef bool    boolean;
+
+#define INPUT           0x0
+#define OUTPUT          0x1
+#define INPUT_PULLUP    0x2
+
+#define LOW             0x0
+#define HIGH            0x1
+
+#define NUM_DIGITAL_PINS  128
+
+// Analog channels are mapped after the digital pins like on the Mega
+#define A0   54
+#define A1   55
+#define A2   56
+#define A3   57
+#define A4   58
+#define A5   59
+#define A6   60
+#define A7   61
+#define A8   62
+#define A9   63
+#define A10  64
+#define A11  65
+#define A12  66
+#define A13  67
+#define A14  68
+#define A15  69
+
+#define digitalPinToInterrupt(p) (p)
+
+#define sq(x) ((x)*(x))
+
+inline long random(const long howbig) { return howbig ? ::random() % howbig : 0; }
+inline long random(const long howsmall, const long howbig) { return howsmall < howbig ? howsmall + random(howbig - howsmall) : howsmall; }
+inline void randomSeed(const unsigned long seed) { if (seed) srandom(seed); }
+
+template <typename T, typename L, typename H>
+inline T constrain(const T value, const L low, const H high) {
+  return value < low ? T(low) : value > high ? T(high) : value;
+}
+
+// Virtual time, see HAL_LINUX/HAL.cpp
+uint32_t millis(void);
+uint32_t micros(void);
+void delay(const uint32_t ms);
+void delayMicroseconds(const uint32_t us);
+void yield(void);
+
+void pinMode(const uint8_t pin, const uint8_t mode);
+void digitalWrite(const uint8_t pin, const uint8_t value);
+int digitalRead(const uint8_t pin);
+void analogWrite(const uint8_t pin, const int value);
+int analogRead(const uint8_t pin);
+
+void noInterrupts(void);
+void interrupts(void);
+
+// Sketch entry points
+void setup(void);
+void loop(void);
@@ -0,0 +1,33 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * Busy delays on the virtual clock.
+ * Cycles are converted to nanoseconds of the virtual F_CPU and
+ * spun against the clock so that the time scale is honoured.
+ */
+void HAL_delay_ns(const uint32_t ns);
+
+FORCE_INLINE static void HAL_delay_cycles(const uint32_t cycles) {
+  HAL_delay_ns(uint32_t(cycles * (NS_PER_CYCLE)));
+}
@@ -0,0 +1,130 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * Fast I/O for the Linux host
+ *
+ * Every pin is a slot of a RAM array. Outputs latch the written value
+ * and count rising edges, so step pins double as step counters.
+ * Inputs read the latched value, that the host side can force with
+ * HAL_LINUX_set_pin() (probes, filament sensors...).
+ * X, Y and Z step pins also move a simulated carriage that drives
+ * the min and max endstop pins, so homing works without hardware.
+ */
+
+/**
+ * Types
+ */
+typedef struct {
+  uint8_t           mode,
+                    sim_axis,     // 1 + axis moved by this step pin, 0 for none
+                    sim_endstop;  // 1 + axis of this endstop pin, 0 for none
+  volatile bool     value;
+  volatile uint16_t pwm;
+  volatile uint32_t rising_edges;
+} fastio_t;
+
+/**
+ * pins
+ */
+extern fastio_t fastio[NUM_DIGITAL_PINS];
+
+// Simulated carriages (see HAL.cpp)
+void HAL_LINUX_sim_step(const uint8_t axis);
+bool HAL_LINUX_sim_endstop(const pin_t pin);
+
+/**
+ * utility functions
+ */
+#ifndef MASK
+  #define MASK(PIN) (1 << PIN)
+#endif
+
+#define OUTPUT_LOW  0x3
+#define OUTPUT_HIGH 0x4
+
+#define VALID_PIN(pin) WITHIN(pin, 0, NUM_DIGITAL_PINS - 1)
+
+/**
+ * magic I/O routines
+ * now you can simply SET_OUTPUT(STEP); WRITE(STEP, 1); WRITE(STEP, 0);
+ */
+
+// Read a pin
+FORCE_INLINE static bool READ(const pin_t pin) {
+  if (!VALID_PIN(pin)) return false;
+  if (fastio[pin].sim_endstop) return HAL_LINUX_sim_endstop(pin);
+  return fastio[pin].value;
+}
+
+// write to a pin
+FORCE_INLINE static void WRITE(const pin_t pin, const bool flag) {
+  if (!VALID_PIN(pin)) return;
+  const bool rising = flag && !fastio[pin].value;
+  fastio[pin].value = flag;
+  if (rising) {
+    fastio[pin].rising_edges++;
+    if (fastio[pin].sim_axis) HAL_LINUX_sim_step(fastio[pin].sim_axis - 1);
+  }
+}
+
+// Toogle pin
+FORCE_INLINE static void TOGGLE(const pin_t pin) {
+  WRITE(pin, !READ(pin));
+}
+
+// Set pin as input
+FORCE_INLINE static void SET_INPUT(const pin_t pin) {
+  if (VALID_PIN(pin)) fastio[pin].mode = INPUT;
+}
+
+// set pin as output
+FORCE_INLINE static void SET_OUTPUT(const pin_t pin) {
+  if (!VALID_PIN(pin)) return;
+  fastio[pin].mode = OUTPUT;
+  fastio[pin].value = false;
+}
+FORCE_INLINE static void SET_OUTPUT_HIGH(const pin_t pin) {
+  if (!VALID_PIN(pin)) return;
+  fastio[pin].mode = OUTPUT;
+  WRITE(pin, HIGH);
+}
+
+// set pin as input with pullup
+FORCE_INLINE static void SET_INPUT_PULLUP(const pin_t pin) {
+  if (!VALID_PIN(pin)) return;
+  fastio[pin].mode = INPUT_PULLUP;
+  fastio[pin].value = true;
+}
+
+// Shorthand
+FORCE_INLINE static void OUT_WRITE(const pin_t pin, const uint8_t flag) {
+  if (flag)
+    SET_OUTPUT_HIGH(pin);
+  else
+    SET_OUTPUT(pin);
+}
+
+FORCE_INLINE static bool USEABLE_HARDWARE_PWM(const pin_t pin) {
+  return VALID_PIN(pin);
+}
@@ -0,0 +1,124 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Entry point of the Linux host process, built by scripts/linux_build.py
+ *
+ *  MK4duo [-s scale] [-p] [-k] [-e eeprom.bin] [file.gcode]
+ *
+ *  -s scale  Run the virtual clock 'scale' times faster than real time
+ *  -p        Serve the serial port on a pseudo terminal (for a host program)
+ *  -k        Keep running when the input ends
+ *  -e file   Keep the EEPROM image in 'file' (default eeprom.bin in the working folder)
+ *  file      Replay a G-code file instead of stdin
+ *
+ * When the input ends and every queued command and move has been
+ * executed the process exits and prints the ISR statistics on stderr.
+ *
+ * Built with -DPLANNER_BENCHMARK the stepper timer never runs: idle()
+ * executes the oldest block only when the planner waits for a free slot
+ * or stops queuing, so a replayed trace (small-segment curves, infill,
+ * laser rasters) keeps the lookahead full and the real time of every
+ * planner phase is reported per block. Homing is not simulated, start the traces with G92.
+ * scripts/planner_bench.py generates the traces and sweeps BLOCK_BUFFER_SIZE.
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "../../../MK4duo.h"
+#include <unistd.h>
+#include <fcntl.h>
+
+static bool exit_on_eof = true;
+
+volatile sig_atomic_t HAL_exit_requested = false;
+
+// exit() is not async-signal-safe: the main loop exits on the flag,
+// a second signal while it is stuck ends the process at once
+static void signal_exit(int) {
+  if (HAL_exit_requested) _exit(1);
+  HAL_exit_requested = true;
+}
+
+// Called by the serial port when its input ended and the RX buffer is empty
+void HAL_LINUX_serial_eof(const uint8_t port) {
+  if (exit_on_eof && port == SERIAL_PORT_1 && commands.buffer_ring.isEmpty() && !planner.has_blocks_queued())
+    exit(0);
+}
+
+int main(int argc, char **argv) {
+
+  bool use_pty = false;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "s:pke:")) != -1) {
+    switch (opt) {
+      case 's': HAL_time_scale = MAX(atof(optarg), 0.001); break;
+      case 'p': use_pty = true; break;
+      case 'k': exit_on_eof = false; break;
+      case 'e': HAL_eeprom_file = optarg; break;
+      default:
+        fprintf(stderr, "Usage: %s [-s scale] [-p] [-k] [-e eeprom.bin] [file.gcode]\n", argv[0]);
+        return 1;
+    }
+  }
+
+  int fd_in = STDIN_FILENO, fd_out = STDOUT_FILENO;
+
+  if (optind < argc) {
+    fd_in = open(argv[optind], O_RDONLY);
+    if (fd_in < 0) {
+      perror(argv[optind]);
+      return 1;
+    }
+  }
+  else if (use_pty) {
+    fd_in = posix_openpt(O_RDWR | O_NOCTTY);
+    if (fd_in < 0 || grantpt(fd_in) || unlockpt(fd_in)) {
+      perror("posix_openpt");
+      return 1;
+    }
+    fd_out = fd_in;
+    exit_on_eof = false;
+    fprintf(stderr, "HAL_LINUX: serial on %s\n", ptsname(fd_in));
+  }
+
+  HAL_serial_open(SERIAL_PORT_1, fd_in, fd_out);
+
+  atexit(HAL_LINUX_report);
+  signal(SIGINT, signal_exit);
+  signal(SIGTERM, signal_exit);
+
+  HAL_timer_init();
+
+  setup();
+
+  #if ENABLED(PLANNER_BENCHMARK) && ENABLED(PREVENT_COLD_EXTRUSION)
+    printer.setAllowColdExtrude(true);
+  #endif
+
+  while (!HAL_exit_requested) loop();
+
+  return 0;
+}
+
+#endif // __PLAT_LINUX__
@@ -0,0 +1,116 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "../../../MK4duo.h"
+
+const char *HAL_eeprom_file = "eeprom.bin";
+
+#if HAS_EEPROM
+
+/**
+ * EEPROM_FLASH on the host: the EEPROM is a RAM image loaded from and saved to
+ * HAL_eeprom_file (option -e), so settings survive between runs of the host process.
+ */
+
+MemoryStore memorystore;
+
+static uint8_t  eeprom_image[EEPROM_SIZE + 1];
+static bool     eeprom_loaded = false;
+
+static void eeprom_load() {
+  if (eeprom_loaded) return;
+  eeprom_loaded = true;
+  memset(eeprom_image, 0xFF, sizeof(eeprom_image));
+  FILE * const f = fopen(HAL_eeprom_file, "rb");
+  if (f) {
+    if (fread(eeprom_image, 1, sizeof(eeprom_image), f) == 0)
+      memset(eeprom_image, 0xFF, sizeof(eeprom_image));
+    fclose(f);
+  }
+}
+
+uint8_t eeprom_read_byte(uint8_t* pos) {
+  eeprom_load();
+  const ptr_int_t p = (ptr_int_t)pos;
+  return p < sizeof(eeprom_image) ? eeprom_image[p] : 0xFF;
+}
+
+void eeprom_write_byte(uint8_t* pos, uint8_t value) {
+  eeprom_load();
+  const ptr_int_t p = (ptr_int_t)pos;
+  if (p < sizeof(eeprom_image)) eeprom_image[p] = value;
+}
+
+void eeprom_read_block(void* pos, const void* eeprom_address, size_t n) {
+  eeprom_load();
+  const ptr_int_t p = (ptr_int_t)eeprom_address;
+  const size_t inside = p < sizeof(eeprom_image) ? MIN(n, size_t(sizeof(eeprom_image) - p)) : 0;
+  if (inside) memcpy(pos, &eeprom_image[p], inside);
+  memset((uint8_t*)pos + inside, 0xFF, n - inside);
+}
+
+void eeprom_update_block(const void* pos, void* eeprom_address, size_t n) {
+  eeprom_load();
+  const ptr_int_t p = (ptr_int_t)eeprom_address;
+  if (p < sizeof(eeprom_image)) memcpy(&eeprom_image[p], pos, MIN(n, size_t(sizeof(eeprom_image) - p)));
+}
+
+/** Public Function */
+bool MemoryStore::access_write() {
+  eeprom_load();
+  FILE * const f = fopen(HAL_eeprom_file, "wb");
+  if (!f) return true;
+  const bool error = fwrite(eeprom_image, 1, sizeof(eeprom_image), f) != sizeof(eeprom_image);
+  fclose(f);
+  return error;
+}
+
+bool MemoryStore::write_data(int &pos, const uint8_t *value, size_t size, uint16_t *crc) {
+  eeprom_update_block(value, (void*)(ptr_int_t)pos, size);
+  crc16(crc, value, size);
+  pos += size;
+  return false;
+}
+
+bool MemoryStore::read_data(int &pos, uint8_t *value, size_t size, uint16_t *crc, const bool writing/*=true*/) {
+
+  uint8_t stored[MEMORY_STORE_BURST];
+  while (size) {
+    const uint8_t len = MIN(size, size_t(MEMORY_STORE_BURST));
+    uint8_t * const dest = writing ? value : stored;
+    eeprom_read_block(dest, (const void*)(ptr_int_t)pos, len);
+    crc16(crc, dest, len);
+    pos += len;
+    value += len;
+    size -= len;
+  }
+
+  return false;
+}
+
+size_t MemoryStore::capacity() { return EEPROM_SIZE + 1; }
+
+#endif // HAS_EEPROM
+
+#endif // __PLAT_LINUX__
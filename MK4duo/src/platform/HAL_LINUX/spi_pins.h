@@ -0,0 +1,42 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * Define SPI Pins: SCK, MISO, MOSI, SS
+ *
+ * There is no SPI bus on the Linux host, the pins are only placeholders
+ * for the code that references them. All transfers read back 0xFF.
+ */
+#define SOFTWARE_SPI
+
+#ifndef MISO_PIN
+  #define MISO_PIN        50
+#endif
+#ifndef MOSI_PIN
+  #define MOSI_PIN        51
+#endif
+#ifndef SCK_PIN
+  #define SCK_PIN         52
+#endif
+
+#define SS_PIN            SDSS
@@ -0,0 +1,62 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2019 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "../../../MK4duo.h"
+
+static uint32_t watchdog_timeout  = 4000,
+                watchdog_last_ms  = 0;
+static bool     watchdog_enabled  = false;
+
+void Watchdog::init(void) {
+  #if ENABLED(USE_WATCHDOG)
+    watchdog_enabled = true;
+    watchdog_last_ms = millis();
+  #endif
+}
+
+void Watchdog::reset(void) {
+  watchdog_last_ms = millis();
+  // idle() resets the watchdog, so blocking commands see the exit request too
+  if (HAL_exit_requested) exit(0);
+  #if ENABLED(PLANNER_BENCHMARK)
+    HAL_LINUX_bench_idle();
+  #endif
+}
+
+void Watchdog::enable(uint32_t timeout) {
+  watchdog_timeout = timeout;
+  watchdog_enabled = true;
+  watchdog_last_ms = millis();
+}
+
+void Watchdog::check(void) {
+  if (watchdog_enabled && ELAPSED(millis(), watchdog_last_ms + watchdog_timeout)) {
+    fprintf(stderr, "HAL_LINUX: watchdog expired after %u ms\n", (unsigned)watchdog_timeout);
+    watchdog_last_ms = millis();
+  }
+}
+
+Watchdog watchdog;
+
+#endif // __PLAT_LINUX__
@@ -344,8 +344,8 @@ void HAL::Tick() {
 
   // Calculation cycle temp a 100ms
   if (expired(&cycle_check_temp_ms, 100U)) {
-    // Temperature Spin
-    thermalManager.spin();
+    // Temperature Spin, the heaters control runs from idle()
+    thermalManager.request_spin();
     #if ENABLED(FAN_KICKSTART_TIME) && HAS_FANS
       LOOP_FAN() {
         if (fans[f].kickstart) fans[f].kickstart--;
@@ -357,8 +357,6 @@ void HAL::Tick() {
   #if ANALOG_INPUTS > 0
     LOOP_HOTEND() AnalogInputValues[hotends[h].sensor.pin] = (analogRead(hotends[h].sensor.pin) * 16);
     Analog_is_ready = true;
-    // Update the raw values if they've been read. Else we could be updating them during reading.
-    thermalManager.set_current_temp_raw();
   #endif
 
   endstops.Tick();
@@ -192,6 +192,13 @@ typedef struct {
   #define ISR_LA_LOOP_CYCLES  0UL
 #endif
 
+// The step timeline ISR only outputs a step event made ahead, see Stepper::timeline_step().
+// Estimate its base time without the Bresenham tracer and the trapezoid generator
+#define ISR_TIMELINE_BASE_CYCLES      240UL
+
+// So the step events can't be closer than
+#define ISR_TIMELINE_CYCLES           (ISR_TIMELINE_BASE_CYCLES + ISR_LOOP_CYCLES)
+
 // Highly granular delays for step pulses, etc.
 #define DELAY_0_NOP   NOOP
 #define DELAY_1_NOP   __asm__("nop\n\t")
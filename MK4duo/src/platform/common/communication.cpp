@@ -89,7 +89,7 @@ bool Com::serialDataAvailable(const uint8_t index) {
   switch (index) {
     case 0: return MKSERIAL1.available();
     #if NUM_SERIAL > 1
-      case 1: MKSERIAL2.available();
+      case 1: return MKSERIAL2.available();
     #endif
     default: return false;
   }
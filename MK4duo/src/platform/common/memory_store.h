@@ -27,6 +27,10 @@
   #define EEPROM_SIZE 4096
 #endif
 
+// Bytes read, compared and written at once, writes are aligned to it.
+// It fits in the pages of the I2C and SPI eeproms and in the Wire buffer.
+#define MEMORY_STORE_BURST 16
+
 class MemoryStore {
 
   public: /** Constructor */
@@ -28,6 +28,7 @@
  *    __AVR__           : For all Atmel AVR boards
  *    ARDUINO_ARCH_SAM  : For Arduino Due and other boards based on Atmel SAM3X8E
  *    ARDUINO_ARCH_SAMD : For Arduino Due and other boards based on Atmel SAMD21J18
+ *    __PLAT_LINUX__    : For the Linux host process (simulation and benchmarks)
  *
  */
 
@@ -50,6 +51,10 @@
   #define CPU_32_BIT
   #include "HAL_SAMD/spi_pins.h"
   #include "HAL_SAMD/HAL.h"
+#elif ENABLED(__PLAT_LINUX__)
+  #define CPU_32_BIT
+  #include "HAL_LINUX/spi_pins.h"
+  #include "HAL_LINUX/HAL.h"
 #else
   #error "Unsupported Platform!"
 #endif
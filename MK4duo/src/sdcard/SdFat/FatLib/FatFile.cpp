@@ -93,6 +93,32 @@ fail:
   return 0;
 }
 //------------------------------------------------------------------------------
+bool FatFile::attrib(uint8_t bits) {
+  const uint8_t mask = DIR_ATT_READ_ONLY | DIR_ATT_HIDDEN | DIR_ATT_SYSTEM;
+  dir_t* dir;
+
+  if (!isFile()) {
+    DBG_FAIL_MACRO;
+    goto fail;
+  }
+  // update directory entry
+  if (!sync()) {
+    DBG_FAIL_MACRO;
+    goto fail;
+  }
+  dir = cacheDirEntry(FatCache::CACHE_FOR_WRITE);
+  if (!dir) {
+    DBG_FAIL_MACRO;
+    goto fail;
+  }
+  dir->attributes = (dir->attributes & ~mask) | (bits & mask);
+  m_attr = (m_attr & ~mask) | (bits & mask);
+  return m_vol->cacheSync();
+
+fail:
+  return false;
+}
+//------------------------------------------------------------------------------
 bool FatFile::close() {
   bool rtn = sync();
   m_attr = FILE_ATTR_CLOSED;
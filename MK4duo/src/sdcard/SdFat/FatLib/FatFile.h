@@ -161,6 +161,15 @@ class FatFile {
   uint32_t available() {
     return isFile() ? fileSize() - curPosition() : 0;
   }
+  /** Set the attributes of a file.
+   *
+   * \param[in] bits Bit-wise or of DIR_ATT_READ_ONLY, DIR_ATT_HIDDEN
+   * and DIR_ATT_SYSTEM, the other attributes are not changed.
+   *
+   * \return The value true is returned for success and
+   * the value false is returned for failure.
+   */
+  bool attrib(uint8_t bits);
   /** Close a file and force cached data and directory information
    *  to be written to the storage device.
    *
@@ -38,6 +38,12 @@
   #if DISABLED(SD_FINISHED_RELEASECOMMAND)
     #error "DEPENDENCY ERROR: Missing setting SD_FINISHED_RELEASECOMMAND."
   #endif
+  #if ENABLED(SD_DIR_INDEX) && !WITHIN(SD_DIR_INDEX_LIMIT, 8, 1024)
+    #error "DEPENDENCY ERROR: SD_DIR_INDEX_LIMIT must be between 8 and 1024."
+  #endif
+  #if ENABLED(SD_FAST_UPLOAD) && !WITHIN(SD_FAST_UPLOAD_BLOCKS, 1, 16)
+    #error "DEPENDENCY ERROR: SD_FAST_UPLOAD_BLOCKS must be between 1 and 16."
+  #endif
 #elif ENABLED(EEPROM_SETTINGS) && ENABLED(EEPROM_SD)
   #error "DEPENDENCY ERROR: You have to enable SDSUPPORT || USB_FLASH_DRIVE_SUPPORT to use EEPROM_SD."
 #endif
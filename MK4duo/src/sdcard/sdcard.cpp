@@ -52,6 +52,19 @@ char  SDCard::fileName[LONG_FILENAME_LENGTH*SD_MAX_FOLDER_DEPTH+SD_MAX_FOLDER_DE
 /** Private Parameters */
 uint16_t SDCard::nrFile_index = 0;
 
+uint8_t   SDCard::read_buffer[SD_READ_BUFFER_SIZE];
+uint16_t  SDCard::read_index  = 0,
+          SDCard::read_length = 0;
+
+#if ENABLED(SD_FAST_UPLOAD)
+  uint8_t   SDCard::write_buffer[SD_WRITE_BUFFER_SIZE];
+  uint16_t  SDCard::write_count = 0,
+            SDCard::write_limit = SD_WRITE_BUFFER_SIZE;
+  #if SD_FAST_UPLOAD_PREALLOCATE > 0
+    char    SDCard::upload_name[MAX_PATH_NAME_LENGHT] = { 0 };
+  #endif
+#endif
+
 #if HAS_EEPROM_SD
   SdFile SDCard::eeprom_file;
 #endif
@@ -61,6 +74,14 @@ uint16_t  SDCard::workDirDepth  = 0,
 
 LsActionEnum SDCard::lsAction   = LS_Count;
 
+#if ENABLED(SD_DIR_INDEX)
+  uint16_t  SDCard::dir_index[SD_DIR_INDEX_LIMIT],
+            SDCard::dir_count   = 0,
+            SDCard::dir_dotdot  = 0xFFFF;
+  uint8_t   SDCard::dir_isdir[(SD_DIR_INDEX_LIMIT + 7) >> 3];
+  bool      SDCard::dir_valid   = false;
+#endif
+
 // Sort files and folders alphabetically.
 #if ENABLED(SDCARD_SORT_ALPHA)
   uint16_t SDCard::sort_count = 0;
@@ -188,6 +209,12 @@ void SDCard::mount() {
 void SDCard::unmount() {
   setDetect(false);
   setPrinting(false);
+  #if ENABLED(SD_DIR_INDEX)
+    flush_dir_index();
+  #endif
+  #if HAS_SD_PRINT_INDEX
+    printindex.close();
+  #endif
 }
 
 void SDCard::ls() {
@@ -209,6 +236,26 @@ void SDCard::getfilename(uint16_t nr, PGM_P const match/*=nullptr*/) {
       return;
     }
   #endif // SDSORT_CACHE_NAMES
+  #if ENABLED(SD_DIR_INDEX)
+    if (match == nullptr) {
+      if (!dir_valid) build_dir_index();
+      if (nr == dir_dotdot) {
+        strcpy(fileName, "..");
+        setFilenameIsDir(true);
+        return;
+      }
+      if (nr < dir_count && nr < SD_DIR_INDEX_LIMIT) {
+        SdFile file;
+        if (file.open(&workDir, dir_index[nr], O_READ)) {
+          file.getName(fileName, LONG_FILENAME_LENGTH);
+          file.close();
+          setFilenameIsDir(TEST(dir_isdir[nr >> 3], nr & 0x07));
+          return;
+        }
+        flush_dir_index(); // Stale entry, scan the folder below
+      }
+    }
+  #endif
   lsAction = LS_GetFilename;
   nrFile_index = nr;
   lsDive(workDir, match);
@@ -259,7 +306,9 @@ void SDCard::write_command(char* buf) {
   char* npos = 0;
   char* end = buf + strlen(buf) - 1;
 
-  gcode_file.clearWriteError();
+  #if DISABLED(SD_FAST_UPLOAD)
+    gcode_file.clearWriteError();
+  #endif
   if ((npos = strchr(buf, 'N')) != NULL) {
     begin = strchr(npos, ' ') + 1;
     end = strchr(npos, '*') - 1;
@@ -267,10 +316,28 @@ void SDCard::write_command(char* buf) {
   end[1] = '\r';
   end[2] = '\n';
   end[3] = '\0';
-  gcode_file.write(begin);
-  if (gcode_file.getWriteError()) {
-    SERIAL_LM(ER, MSG_SD_ERR_WRITE_TO_FILE);
-  }
+
+  #if ENABLED(SD_FAST_UPLOAD)
+
+    // Append the line to the write buffer, it goes to the card a full buffer at a time
+    const char* src = begin;
+    for (uint16_t len = end + 3 - begin; len;) {
+      const uint16_t n = MIN(len, uint16_t(write_limit - write_count));
+      memcpy(write_buffer + write_count, src, n);
+      write_count += n;
+      src += n;
+      len -= n;
+      if (write_count == write_limit) flush_write_buffer();
+    }
+
+  #else
+
+    gcode_file.write(begin);
+    if (gcode_file.getWriteError()) {
+      SERIAL_LM(ER, MSG_SD_ERR_WRITE_TO_FILE);
+    }
+
+  #endif
 }
 
 void SDCard::print_status() {
@@ -286,11 +353,40 @@ void SDCard::startWrite(char * filename, const bool silent/*=false*/) {
   if (!isDetected()) return;
 
   fat.chdir();
-  if (!gcode_file.open(filename, FILE_WRITE)) {
+
+  #if ENABLED(SD_FAST_UPLOAD) && SD_FAST_UPLOAD_PREALLOCATE > 0
+    // A new file is allocated contiguous, the upload then runs without growing the cluster chain.
+    // It goes to a hidden file renamed at the end, so a power loss leaves no stale tail in the file.
+    upload_name[0] = '\0';
+    if (!fat.exists(filename) && strlen(filename) < sizeof(upload_name)) {
+      fat.remove(UPLOAD_FILE_NAME);
+      if (gcode_file.createContiguous(fat.vwd(), UPLOAD_FILE_NAME, (SD_FAST_UPLOAD_PREALLOCATE) * 1048576UL))
+        strcpy(upload_name, filename);
+    }
+    const bool opened = upload_name[0] || gcode_file.open(filename, FILE_WRITE);
+  #else
+    const bool opened = gcode_file.open(filename, FILE_WRITE);
+  #endif
+
+  if (!opened) {
     SERIAL_LMT(ER, MSG_SD_OPEN_FILE_FAIL, filename);
   }
   else {
     setSaving(true);
+    #if ENABLED(SD_FAST_UPLOAD)
+      // Appending can start mid block, the first flush ends on the block boundary
+      write_count = 0;
+      write_limit = SD_WRITE_BUFFER_SIZE - (gcode_file.curPosition() & 0x1FF);
+    #endif
+    #if ENABLED(SD_DIR_INDEX)
+      flush_dir_index();
+    #endif
+    #if HAS_SD_PRINT_INDEX
+      // Index the file when the upload ends
+      char abs_name[MAX_PATH_NAME_LENGHT] = "/";
+      strncat(abs_name, filename, sizeof(abs_name) - 2);
+      printindex.request(abs_name);
+    #endif
     #if ENABLED(EMERGENCY_PARSER)
       emergency_parser.disable();
     #endif
@@ -305,6 +401,9 @@ void SDCard::deleteFile(char * filename) {
   if (!isDetected()) return;
   setPrinting(false);
   gcode_file.close();
+  #if ENABLED(SD_DIR_INDEX)
+    flush_dir_index();
+  #endif
   if (fat.remove(filename)) {
     SERIAL_EMT(MSG_SD_FILE_DELETED, filename);
   }
@@ -322,6 +421,9 @@ void SDCard::deleteFile(char * filename) {
 }
 
 void SDCard::finishWrite() {
+  #if ENABLED(SD_FAST_UPLOAD)
+    end_upload();
+  #endif
   gcode_file.sync();
   gcode_file.close();
   setSaving(false);
@@ -333,6 +435,9 @@ void SDCard::makeDirectory(char * filename) {
   setPrinting(false);
   gcode_file.close();
   if (fat.mkdir(filename)) {
+    #if ENABLED(SD_DIR_INDEX)
+      flush_dir_index();
+    #endif
     SERIAL_EM(MSG_SD_DIRECTORY_CREATED);
   }
   else {
@@ -341,6 +446,9 @@ void SDCard::makeDirectory(char * filename) {
 }
 
 void SDCard::closeFile() {
+  #if ENABLED(SD_FAST_UPLOAD)
+    if (isSaving()) end_upload();
+  #endif
   gcode_file.sync();
   gcode_file.close();
   setSaving(false);
@@ -390,6 +498,9 @@ void SDCard::chdir(PGM_P relpath) {
     workDir = newDir;
     if (workDirDepth < SD_MAX_FOLDER_DEPTH)
       workDirParents[workDirDepth++] = workDir;
+    #if ENABLED(SD_DIR_INDEX)
+      flush_dir_index();
+    #endif
     #if ENABLED(SDCARD_SORT_ALPHA)
       presort();
     #endif
@@ -431,6 +542,9 @@ void SDCard::checkautostart() {
 
 void SDCard::setroot() {
   workDir = root;
+  #if ENABLED(SD_DIR_INDEX)
+    flush_dir_index();
+  #endif
   #if ENABLED(SDCARD_SORT_ALPHA)
     presort();
   #endif
@@ -468,6 +582,7 @@ bool SDCard::selectFile(PGM_P filename, const bool silent/*=false*/) {
 
     fileSize = gcode_file.fileSize();
     sdpos = 0;
+    read_index = read_length = 0;
 
     if (!silent) {
       SERIAL_MT(MSG_SD_FILE_OPENED, fname);
@@ -478,6 +593,14 @@ bool SDCard::selectFile(PGM_P filename, const bool silent/*=false*/) {
       const_cast<char&>(fileName[c]) = '\0';
     strncpy(fileName, filename, strlen(filename));
 
+    #if HAS_SD_PRINT_INDEX
+      // File info from the index, or from the file while it is indexed
+      char abs_name[MAX_PATH_NAME_LENGHT];
+      getAbsFilename(abs_name);
+      if (printindex.load(abs_name, fileSize)) return true;
+      printindex.request(abs_name);
+    #endif
+
     #if ENABLED(JSON_OUTPUT)
       parsejson(gcode_file);
     #endif
@@ -493,6 +616,9 @@ bool SDCard::selectFile(PGM_P filename, const bool silent/*=false*/) {
 int8_t SDCard::updir() {
   if (workDirDepth > 0) {                                               // At least 1 dir has been saved
     workDir = --workDirDepth ? workDirParents[workDirDepth - 1] : root; // Use parent, or root if none
+    #if ENABLED(SD_DIR_INDEX)
+      flush_dir_index();
+    #endif
     #if ENABLED(SDCARD_SORT_ALPHA)
       presort();
     #endif
@@ -501,10 +627,15 @@ int8_t SDCard::updir() {
 }
 
 uint16_t SDCard::getnrfilenames() {
-  lsAction = LS_Count;
-  nrFiles = 0;
-  lsDive(workDir);
-  return nrFiles;
+  #if ENABLED(SD_DIR_INDEX)
+    if (!dir_valid) build_dir_index();
+    return nrFiles = dir_count;
+  #else
+    lsAction = LS_Count;
+    nrFiles = 0;
+    lsDive(workDir);
+    return nrFiles;
+  #endif
 }
 
 uint16_t SDCard::get_num_Files() {
@@ -525,9 +656,14 @@ uint16_t SDCard::get_num_Files() {
 
     if (!isDetected() || restart.job_file.isOpen()) return;
 
-    if (!restart.job_file.open(fat.vwd(), restart_file_name, read ? O_READ : (O_RDWR | O_CREAT | O_SYNC)))
+    // The journal is allocated contiguous, see Restart::open_journal
+    if (!restart.job_file.open(fat.vwd(), restart_file_name, read ? O_READ : O_RDWR)
+        && (read || !restart.job_file.createContiguous(fat.vwd(), restart_file_name, (SD_RESTART_FILE_JOURNAL) * 512UL)))
       SERIAL_LMT(ER, MSG_SD_OPEN_FILE_FAIL, restart_file_name);
     else if (!read) {
+      #if ENABLED(SD_DIR_INDEX)
+        flush_dir_index();
+      #endif
       if (printer.debugFeature()) DEBUG_EMT(MSG_SD_WRITE_TO_FILE, restart_file_name);
     }
   }
@@ -535,6 +671,9 @@ uint16_t SDCard::get_num_Files() {
   void SDCard::delete_restart_file() {
     if (exist_restart_file()) {
       restart.job_file.remove(fat.vwd(), restart_file_name);
+      #if ENABLED(SD_DIR_INDEX)
+        flush_dir_index();
+      #endif
       if (printer.debugFeature()) {
         DEBUG_SM(DEB, " File restart delete");
         DEBUG_STR(exist_restart_file() ? PSTR(" failed.\n") : PSTR("d.\n"));
@@ -572,6 +711,9 @@ uint16_t SDCard::get_num_Files() {
     ) SERIAL_LM(ER, "Could not write eeprom to sd card");
 
     eeprom_file.close();
+    #if ENABLED(SD_DIR_INDEX)
+      flush_dir_index();
+    #endif
   }
 
 #endif
@@ -858,16 +1000,81 @@ uint16_t SDCard::get_num_Files() {
 #endif
 
 /** Private Function */
+/**
+ * Refill the read-ahead buffer from the current file position.
+ * Reads are aligned to SD_READ_BUFFER_SIZE so every refill
+ * is served by a single block of the card.
+ */
+uint16_t SDCard::fill_buffer() {
+  read_index = read_length = 0;
+  if (!gcode_file.isOpen()) return 0;
+  const uint16_t size = SD_READ_BUFFER_SIZE - (sdpos % SD_READ_BUFFER_SIZE);
+  const int16_t n = gcode_file.read(read_buffer, size);
+  if (n > 0) read_length = n;
+  return read_length;
+}
+
+#if ENABLED(SD_DIR_INDEX)
+
+  /**
+   * Scan workDir once, keeping the directory entry of each listed item.
+   * getfilename then reopens an item from its entry with one block read.
+   */
+  void SDCard::build_dir_index() {
+    lsAction = LS_Index;
+    nrFiles = 0;
+    dir_dotdot = 0xFFFF;
+    lsDive(workDir);
+    dir_count = nrFiles;
+    dir_valid = true;
+  }
+
+#endif
+
+#if ENABLED(SD_FAST_UPLOAD)
+
+  /**
+   * Write the buffered upload data. A full buffer starts on a block
+   * boundary of the file, so SdFat writes it straight to the card,
+   * with a multi-block command when it holds more blocks.
+   */
+  void SDCard::flush_write_buffer() {
+    if (write_count && gcode_file.write(write_buffer, write_count) != write_count)
+      SERIAL_LM(ER, MSG_SD_ERR_WRITE_TO_FILE);
+    write_count = 0;
+    write_limit = SD_WRITE_BUFFER_SIZE;
+  }
+
+  // Write the last partial block, release the preallocated space after the data and give the file its name
+  void SDCard::end_upload() {
+    flush_write_buffer();
+    gcode_file.truncate(gcode_file.curPosition());
+    #if SD_FAST_UPLOAD_PREALLOCATE > 0
+      if (upload_name[0]) {
+        fat.chdir();
+        if (!gcode_file.rename(fat.vwd(), upload_name))
+          SERIAL_LMT(ER, MSG_SD_OPEN_FILE_FAIL, upload_name);
+        upload_name[0] = '\0';
+        #if ENABLED(SD_DIR_INDEX)
+          flush_dir_index();
+        #endif
+      }
+    #endif
+  }
+
+#endif
+
 /**
  * Dive into a folder and recurse depth-first to perform a pre-set operation lsAction:
  *   LS_Count       - Add +1 to nrFiles for every file within the parent
  *   LS_GetFilename - Get the filename of the file indexed by nrFile_index
+ *   LS_Index       - Store the directory entry of every file in dir_index
  */
 void SDCard::lsDive(SdFile parent, PGM_P const match/*=NULL*/) {
   //dir_t* p = NULL;
   SdFile file;
   parent.rewind();
-  uint8_t cnt = 0;
+  uint16_t cnt = 0;
 
   // Read the next entry from a directory
   while (file.openNext(&parent, O_READ)) {
@@ -908,6 +1115,21 @@ void SDCard::lsDive(SdFile parent, PGM_P const match/*=NULL*/) {
         cnt++;
         file.close();
         break;
+      case LS_Index:
+        #if ENABLED(SD_DIR_INDEX)
+          if (strcmp(tempLongFilename, "..") == 0)
+            dir_dotdot = nrFiles;
+          if (nrFiles < SD_DIR_INDEX_LIMIT) {
+            dir_index[nrFiles] = file.dirIndex();
+            if (file.isSubDir())
+              SBI(dir_isdir[nrFiles >> 3], nrFiles & 0x07);
+            else
+              CBI(dir_isdir[nrFiles >> 3], nrFiles & 0x07);
+          }
+        #endif
+        nrFiles++;
+        file.close();
+        break;
     }
 
   } // while readDir
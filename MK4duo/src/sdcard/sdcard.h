@@ -74,6 +74,23 @@ class SDCard {
 
     static uint16_t nrFile_index;
 
+    // Read-ahead buffer of gcode_file, sdpos is the file position of read_buffer[read_index]
+    static uint8_t  read_buffer[SD_READ_BUFFER_SIZE];
+    static uint16_t read_index,
+                    read_length;
+
+    // Write buffer of the M28 upload, flushed when it reaches a block boundary of the file
+    #if ENABLED(SD_FAST_UPLOAD)
+      static uint8_t  write_buffer[SD_WRITE_BUFFER_SIZE];
+      static uint16_t write_count,
+                      write_limit;
+      #if SD_FAST_UPLOAD_PREALLOCATE > 0
+        // A new file is uploaded to a hidden file, renamed to upload_name when the upload ends
+        #define UPLOAD_FILE_NAME ".upload.tmp"
+        static char upload_name[MAX_PATH_NAME_LENGHT];
+      #endif
+    #endif
+
     #if HAS_EEPROM_SD
       #define EEPROM_FILE_NAME "eeprom.bin"
       static SdFile eeprom_file;
@@ -83,6 +100,15 @@ class SDCard {
                         nrFiles;          // counter for the files in the current directory and recycled as position counter for getting the nrFiles'th name in the directory.
     static LsActionEnum lsAction;         // stored for recursion.
 
+    // Directory entries of the listed items of workDir, built once per folder
+    #if ENABLED(SD_DIR_INDEX)
+      static uint16_t dir_index[SD_DIR_INDEX_LIMIT],  // Entry index in the folder file
+                      dir_count,                      // Listed items, can be over the limit
+                      dir_dotdot;                     // Item of "..", SdFat can't reopen it by index
+      static uint8_t  dir_isdir[(SD_DIR_INDEX_LIMIT + 7) >> 3];
+      static bool     dir_valid;
+    #endif
+
     // Sort files and folders alphabetically.
     #if ENABLED(SDCARD_SORT_ALPHA)
       static uint16_t sort_count;         // Count of sorted items in the current directory
@@ -249,15 +275,36 @@ class SDCard {
     static inline void pauseSDPrint() { setPrinting(false); }
     static inline bool isFileOpen()   { return isDetected() && gcode_file.isOpen(); }
     static inline bool isPaused()     { return isFileOpen() && !isPrinting(); }
-    static inline void setIndex(uint32_t newpos) { sdpos = newpos; gcode_file.seekSet(sdpos); }
+    static inline void setIndex(uint32_t newpos) { sdpos = newpos; gcode_file.seekSet(sdpos); read_index = read_length = 0; }
     static inline uint32_t getIndex() { return sdpos; }
     static inline bool eof() { return sdpos >= fileSize; }
-    static inline int16_t get() { sdpos = gcode_file.curPosition(); return (int16_t)gcode_file.read(); }
+    static inline int16_t get() {
+      if (read_index >= read_length && !fill_buffer()) return -1;
+      sdpos++;
+      return read_buffer[read_index++];
+    }
+
+    /**
+     * Bytes of the read-ahead buffer not consumed yet, the buffer is refilled
+     * from the card when empty. Return 0 at the end of file or on read error.
+     */
+    static inline uint16_t get_buffer(const uint8_t* &data) {
+      if (read_index >= read_length && !fill_buffer()) return 0;
+      data = &read_buffer[read_index];
+      return read_length - read_index;
+    }
+    static inline void consume_buffer(const uint16_t count) { read_index += count; sdpos += count; }
     static inline uint8_t percentDone() { return (isFileOpen() && fileSize) ? sdpos / ((fileSize + 99) / 100) : 0; }
     static inline void getWorkDirName() { workDir.getName(fileName, LONG_FILENAME_LENGTH); }
     static inline size_t read(void* buf, uint16_t nbyte) { return gcode_file.isOpen() ? gcode_file.read(buf, nbyte) : -1; }
     static inline size_t write(void* buf, uint16_t nbyte) { return gcode_file.isOpen() ? gcode_file.write(buf, nbyte) : -1; }
 
+    // Slicer data in the comments of the file
+    static bool findGeneratedBy(char* buf, char* genBy);
+    static bool findFirstLayerHeight(char* buf, float &firstlayerHeight);
+    static bool findLayerHeight(char* buf, float &layerHeight);
+    static bool findFilamentNeed(char* buf, float &filament);
+
     #if ENABLED(ADVANCED_SD_COMMAND)
       // Format SD Card
       static void formatSD();
@@ -267,18 +314,26 @@ class SDCard {
 
   private: /** Private Function */
 
+    static uint16_t fill_buffer();
+
     static void lsDive(SdFile parent, PGM_P const match = NULL);
     static void parsejson(SdFile &parser_file);
-    static bool findGeneratedBy(char* buf, char* genBy);
-    static bool findFirstLayerHeight(char* buf, float &firstlayerHeight);
-    static bool findLayerHeight(char* buf, float &layerHeight);
-    static bool findFilamentNeed(char* buf, float &filament);
     static bool findTotalHeight(char* buf, float &objectHeight);
 
     #if ENABLED(SDCARD_SORT_ALPHA)
       static void flush_presort();
     #endif
 
+    #if ENABLED(SD_DIR_INDEX)
+      static void build_dir_index();
+      FORCE_INLINE static void flush_dir_index() { dir_valid = false; }
+    #endif
+
+    #if ENABLED(SD_FAST_UPLOAD)
+      static void flush_write_buffer();
+      static void end_upload();
+    #endif
+
     #if ENABLED(ADVANCED_SD_COMMAND)
 
       // write cached block to the card
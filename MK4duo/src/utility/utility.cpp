@@ -89,7 +89,7 @@ char* hex_word(const uint16_t w) {
 
 char* hex_address(const void * const w) {
   #if ENABLED(CPU_32_BIT)
-    (void)hex_long((uint32_t)w);
+    (void)hex_long((uint32_t)(ptr_int_t)w);
   #else
     (void)hex_word((uint16_t)w);
   #endif
@@ -110,13 +110,19 @@ void print_hex_long(const uint32_t w, const char delimiter) {
   print_hex_byte(w);
 }
 
+/**
+ * CRC-16 CCITT (0x1021), one byte per step instead of one bit:
+ * the 8 shifts of the polynomial fold into x ^ x<<5 ^ x<<12.
+ */
 void crc16(uint16_t *crc, const void * const data, uint16_t cnt) {
-  uint8_t *ptr = (uint8_t *)data;
+  const uint8_t *ptr = (const uint8_t *)data;
+  uint16_t c = *crc;
   while (cnt--) {
-    *crc = (uint16_t)(*crc ^ (uint16_t)(((uint16_t)*ptr++) << 8));
-    for (uint8_t i = 0; i < 8; i++)
-      *crc = (uint16_t)((*crc & 0x8000) ? ((uint16_t)(*crc << 1) ^ 0x1021) : (*crc << 1));
+    uint8_t x = (c >> 8) ^ *ptr++;
+    x ^= x >> 4;
+    c = (c << 8) ^ ((uint16_t)x << 12) ^ ((uint16_t)x << 5) ^ x;
   }
+  *crc = c;
 }
 
 char conv[8] = { 0 };
@@ -0,0 +1,79 @@
+#!/usr/bin/python3
+
+# Build of the MK4duo Linux host simulator (src/platform/HAL_LINUX).
+#
+# The firmware is compiled as it is configured: -D__PLAT_LINUX__ selects the
+# host platform and its board, BOARD_LINUX_RAMPS, so the configuration files
+# need no change. Other platforms and SdFat are not built for the host.
+#
+#   ./linux_build.py [-o MK4duo] [-b /tmp/mk4duo_linux] [-j jobs] [-D NAME[=VALUE] ...] [firmware folder]
+#
+# The -D options add defines to the build, e.g. -D PLANNER_BENCHMARK.
+# Run the result with a G-code file or on a pseudo terminal, see main.cpp
+# of HAL_LINUX for its options.
+#
+# Needs g++ with -std=gnu++14.
+
+import argparse
+import concurrent.futures
+import os
+import shutil
+import subprocess
+import sys
+
+script_dir = os.path.dirname(os.path.abspath(__file__))
+default_firmware_dir = os.path.join(script_dir, '..', 'MK4duo')
+
+excluded_sources = ('HAL_AVR', 'HAL_DUE', 'HAL_SAMD', 'SdFat')
+
+compile_flags = ['-std=gnu++14', '-O2', '-Wall', '-D__PLAT_LINUX__']
+
+
+def sources(firmware_dir):
+  # The sketch is the main translation unit of the Arduino build
+  found = ['MK4duo.ino']
+  for root, dirs, files in os.walk(os.path.join(firmware_dir, 'src')):
+    if any(x in root for x in excluded_sources):
+      continue
+    found += [os.path.relpath(os.path.join(root, n), firmware_dir) for n in files if n.endswith('.cpp')]
+  return sorted(found)
+
+
+def build(firmware_dir, obj_dir, binary, defines=(), jobs=os.cpu_count()):
+  firmware_dir = os.path.abspath(firmware_dir)
+  shutil.rmtree(obj_dir, ignore_errors=True)
+  os.makedirs(obj_dir)
+  flags = compile_flags + ['-D' + d for d in defines]
+
+  def compile_one(source):
+    obj = os.path.join(obj_dir, source.replace(os.sep, '_') + '.o')
+    result = subprocess.run(['g++'] + flags + ['-x', 'c++', '-c', source, '-o', obj],
+                            cwd=firmware_dir, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+    return source, result.returncode, result.stdout
+
+  with concurrent.futures.ThreadPoolExecutor(jobs) as pool:
+    for source, code, output in pool.map(compile_one, sources(firmware_dir)):
+      if code:
+        sys.exit('Build of %s failed:\n%s' % (source, output))
+      if output:
+        sys.stderr.write(output)
+
+  objects = sorted(os.path.join(obj_dir, n) for n in os.listdir(obj_dir))
+  subprocess.run(['g++', '-o', binary] + objects + ['-lpthread', '-lrt'], check=True)
+  return binary
+
+
+def main():
+  parser = argparse.ArgumentParser(description='Build the MK4duo Linux host simulator')
+  parser.add_argument('-o', '--output', default='MK4duo', help='binary to write')
+  parser.add_argument('-b', '--build', default='/tmp/mk4duo_linux', help='folder of the object files')
+  parser.add_argument('-j', '--jobs', type=int, default=os.cpu_count(), help='parallel compile jobs')
+  parser.add_argument('-D', dest='defines', action='append', default=[], help='extra define, NAME or NAME=VALUE')
+  parser.add_argument('firmware', nargs='?', default=default_firmware_dir, help='firmware folder to build')
+  args = parser.parse_args()
+
+  print(build(args.firmware, args.build, os.path.abspath(args.output), args.defines, args.jobs))
+
+
+if __name__ == '__main__':
+  main()
@@ -0,0 +1,189 @@
+#!/usr/bin/python3
+
+# Planner lookahead benchmark for MK4duo.
+#
+# Builds the Linux host simulator with PLANNER_BENCHMARK (see linux_build.py)
+# once for every BLOCK_BUFFER_SIZE to test, replays the motion traces through
+# it and prints the us per block, the worst recalculate() and the sustainable
+# blocks/s.
+#
+# The traces are generated in the work folder:
+#   curves.gcode  - circles and spirals of 0.2-0.5 mm segments, as sliced curves
+#   infill.gcode  - zig-zag infill lines with short connections
+#   raster.gcode  - laser raster lines of 0.1 mm segments, no extrusion
+#   speeds.gcode  - segments of 0.05-50 mm swept over feedrates and accelerations
+# Recorded G-code files can be added on the command line, start them with G92
+# because homing is not simulated.
+#
+# With -f the builds enable PLANNER_FIXED_POINT too, every trapezoid is also
+# computed with the float math and the script fails when accelerate_until or
+# decelerate_after differ by more than FIXED_POINT_TOLERANCE steps.
+#
+#   ./planner_bench.py [-s 8 16 32 64] [-w /tmp/planner_bench] [-f] [file.gcode ...]
+#
+# Needs g++ with -std=gnu++14. Run it from the scripts folder of the repository.
+
+import argparse
+import math
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+import linux_build
+
+# Steps the fixed point trapezoid may differ from the float one (see fixed_trapezoid_steps)
+FIXED_POINT_TOLERANCE = 1
+
+script_dir = os.path.dirname(os.path.abspath(__file__))
+firmware_dir = os.path.join(script_dir, '..', 'MK4duo')
+
+
+def write_curves(path):
+  with open(path, 'w') as f:
+    f.write('G92 X0 Y0 Z0 E0\nM82\nG1 F3600\n')
+    e = 0.0
+    x0, y0 = 0.0, 0.0
+    for layer in range(20):
+      f.write('G1 Z%.2f\n' % (0.2 * (layer + 1)))
+      # Circles of 0.2-0.5 mm segments
+      for r in (5.0, 10.0, 20.0, 40.0):
+        seg = 0.2 + 0.1 * (r / 10.0)
+        n = max(8, int(2 * math.pi * r / seg))
+        for i in range(n + 1):
+          a = 2 * math.pi * i / n
+          x, y = r * math.cos(a), r * math.sin(a)
+          e += math.hypot(x - x0, y - y0) * 0.05
+          f.write('G1 X%.3f Y%.3f E%.5f\n' % (x, y, e))
+          x0, y0 = x, y
+      # A spiral, the segments change direction a little every time
+      for i in range(2000):
+        a = i * 0.02
+        r = 2.0 + a * 0.5
+        x, y = r * math.cos(a), r * math.sin(a)
+        e += math.hypot(x - x0, y - y0) * 0.05
+        f.write('G1 X%.3f Y%.3f E%.5f\n' % (x, y, e))
+        x0, y0 = x, y
+
+
+def write_infill(path):
+  with open(path, 'w') as f:
+    f.write('G92 X0 Y0 Z0 E0\nM82\nG1 F6000\n')
+    e = 0.0
+    for layer in range(20):
+      f.write('G1 Z%.2f\n' % (0.2 * (layer + 1)))
+      for line in range(200):
+        y = line * 0.4
+        x = 80.0 if line % 2 == 0 else 0.0
+        e += 80.0 * 0.03
+        f.write('G1 X%.3f Y%.3f E%.5f\n' % (x, y, e))
+        e += 0.4 * 0.03
+        f.write('G1 Y%.3f E%.5f\n' % (y + 0.4, e))
+
+
+def write_raster(path):
+  with open(path, 'w') as f:
+    f.write('G92 X0 Y0 Z0 E0\nG1 F9000\n')
+    for line in range(100):
+      y = line * 0.1
+      xs = range(0, 501) if line % 2 == 0 else range(500, -1, -1)
+      f.write('G0 X%.1f Y%.3f\n' % (xs[0] * 0.1, y))
+      for i in xs:
+        f.write('G1 X%.1f\n' % (i * 0.1))
+
+
+def write_speeds(path):
+  with open(path, 'w') as f:
+    f.write('G92 X0 Y0 Z0 E0\nM82\n')
+    e = 0.0
+    x = 0.0
+    for accel in (100, 500, 1500, 3000, 10000):
+      f.write('M204 P%d T%d\n' % (accel, accel))
+      for feedrate in (60, 600, 3000, 9000, 30000):
+        f.write('G1 F%d\n' % feedrate)
+        for length in (0.05, 0.1, 0.3, 1.0, 3.0, 10.0, 50.0):
+          # Out and back, with and without extrusion, at an angle
+          for sign in (1, -1):
+            x += sign * length
+            e += length * 0.03
+            f.write('G1 X%.3f Y%.3f E%.5f\n' % (x, length * 0.5, e))
+            f.write('G1 X%.3f Y0\n' % x)
+
+
+def build(size, work_dir, jobs, fixed_point):
+  src_dir = os.path.join(work_dir, 'src_%d' % size)
+  obj_dir = os.path.join(work_dir, 'obj_%d' % size)
+  binary = os.path.join(work_dir, 'bench_%d' % size)
+  shutil.rmtree(src_dir, ignore_errors=True)
+  shutil.copytree(firmware_dir, src_dir)
+
+  # A copy of the firmware for every BLOCK_BUFFER_SIZE swept
+  basic = os.path.join(src_dir, 'Configuration_Basic.h')
+  with open(basic, encoding='latin-1') as f:
+    config = f.read()
+  config = re.sub(r'#define BLOCK_BUFFER_SIZE \d+', '#define BLOCK_BUFFER_SIZE %d' % size, config)
+  with open(basic, 'w', encoding='latin-1') as f:
+    f.write(config)
+
+  defines = ['PLANNER_BENCHMARK'] + (['PLANNER_FIXED_POINT'] if fixed_point else [])
+  return linux_build.build(src_dir, obj_dir, binary, defines, jobs)
+
+
+def run(binary, trace):
+  # A fresh folder for every run, so no EEPROM image is left behind or reused
+  with tempfile.TemporaryDirectory(prefix='planner_bench_') as run_dir:
+    result = subprocess.run([binary, '-e', os.path.join(run_dir, 'eeprom.bin'), trace], cwd=run_dir,
+                            stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, universal_newlines=True)
+  m = re.search(r'([\d.]+) us per block, worst recalculate ([\d.]+) us, (\d+) blocks/s', result.stderr)
+  if not m:
+    sys.exit('No benchmark report from %s %s:\n%s' % (binary, trace, result.stderr))
+  blocks = re.search(r'buffer_steps\s+calls\s+(\d+)', result.stderr)
+  fixed = re.search(r'fixed point trapezoids (\d+), (\d+) differ from float, max error (\d+) steps', result.stderr)
+  fixed = tuple(int(n) for n in fixed.groups()) if fixed else None
+  return int(blocks.group(1)) if blocks else 0, float(m.group(1)), float(m.group(2)), int(m.group(3)), fixed
+
+
+def main():
+  parser = argparse.ArgumentParser(description='MK4duo planner lookahead benchmark')
+  parser.add_argument('-s', '--sizes', type=int, nargs='+', default=[8, 16, 32, 64], help='BLOCK_BUFFER_SIZE values to test')
+  parser.add_argument('-w', '--work', default='/tmp/planner_bench', help='work folder for the builds and the traces')
+  parser.add_argument('-j', '--jobs', type=int, default=os.cpu_count(), help='parallel compile jobs')
+  parser.add_argument('-f', '--fixed-point', action='store_true', help='check PLANNER_FIXED_POINT against the float math')
+  parser.add_argument('traces', nargs='*', help='recorded G-code traces to replay too')
+  args = parser.parse_args()
+
+  os.makedirs(args.work, exist_ok=True)
+  traces = []
+  for name, writer in (('curves', write_curves), ('infill', write_infill), ('raster', write_raster), ('speeds', write_speeds)):
+    path = os.path.join(args.work, name + '.gcode')
+    writer(path)
+    traces.append(path)
+  traces += [os.path.abspath(t) for t in args.traces]
+
+  header = '%-6s %-16s %8s %12s %16s %12s' % ('size', 'trace', 'blocks', 'us/block', 'worst recalc us', 'blocks/s')
+  if args.fixed_point:
+    header += ' %10s %8s %10s' % ('trapezoids', 'differ', 'max steps')
+  print(header)
+  failed = []
+  for size in args.sizes:
+    binary = build(size, args.work, args.jobs, args.fixed_point)
+    for trace in traces:
+      blocks, per_block, worst, rate, fixed = run(binary, trace)
+      line = '%-6d %-16s %8d %12.3f %16.3f %12d' % (size, os.path.basename(trace), blocks, per_block, worst, rate)
+      if args.fixed_point:
+        if not fixed or not fixed[0]:
+          sys.exit('No fixed point check from %s %s' % (binary, trace))
+        line += ' %10d %8d %10d' % fixed
+        if fixed[2] > FIXED_POINT_TOLERANCE:
+          failed.append('%d/%s' % (size, os.path.basename(trace)))
+      print(line)
+    sys.stdout.flush()
+
+  if failed:
+    sys.exit('Fixed point trapezoids off by more than %d step(s): %s' % (FIXED_POINT_TOLERANCE, ' '.join(failed)))
+
+
+if __name__ == '__main__':
+  main()